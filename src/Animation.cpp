@@ -0,0 +1,217 @@
+#include "Animation.hpp"
+
+/*
+ * Date: 10/17/26
+ * Function Name: Animation (constructor)
+ * Arguments:
+ *     void
+ * Purpose: Constructor for an animation without keys, which is a single frame
+ * Return Value: void
+ */
+Animation::Animation() : _frameCount(0), _lastKey(0) {
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddCameraKey
+ * Arguments:
+ *     int         - the frame
+ *     Vec3<float> - where the camera is at that frame
+ * Purpose: Adds a key to the camera position.  A second key for the same frame replaces the first
+ * Return Value: void
+ */
+void Animation::AddCameraKey(int frame, Vec3<float> position) {
+	AddKey(_camera, frame, position);
+	if (frame > _lastKey) {
+		_lastKey = frame;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddCornerKey
+ * Arguments:
+ *     int         - the frame
+ *     Vec3<float> - where the top left corner of the image plane is at that frame
+ * Purpose: Adds a key to the image plane corner.  A second key for the same frame replaces the first
+ * Return Value: void
+ */
+void Animation::AddCornerKey(int frame, Vec3<float> corner) {
+	AddKey(_corner, frame, corner);
+	if (frame > _lastKey) {
+		_lastKey = frame;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddObjectKey
+ * Arguments:
+ *     int         - the index of the object in the object list of the scene
+ *     int         - the frame
+ *     Vec3<float> - how far the object is moved from where the scene file places it at that frame
+ * Purpose: Adds a key to the track of an object, starting the track on its first key
+ * Return Value: void
+ */
+void Animation::AddObjectKey(int object, int frame, Vec3<float> offset) {
+	size_t track = 0;
+	while (track < _objects.size() && _objects[track].object != object) {
+		track++;
+	}
+	if (track == _objects.size()) {
+		objectTrack newTrack;
+		newTrack.object = object;
+		_objects.push_back(newTrack);
+	}
+	AddKey(_objects[track].keys, frame, offset);
+	if (frame > _lastKey) {
+		_lastKey = frame;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetFrameCount
+ * Arguments:
+ *     int - the number of frames, 0 or less to end on the last key
+ * Purpose: Sets the length of the animation
+ * Return Value: void
+ */
+void Animation::SetFrameCount(int frameCount) {
+	_frameCount = frameCount > 0 ? frameCount : 0;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetCamera
+ * Arguments:
+ *     int           - the frame
+ *     Vec3<float> & - set to where the camera is at the frame.  Left alone when the camera does not move
+ * Purpose: Samples the camera track
+ * Return Value: bool - false if the camera has no keys
+ */
+bool Animation::GetCamera(int frame, Vec3<float> &position) {
+	if (_camera.empty()) {
+		return false;
+	}
+	position = Sample(_camera, frame);
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetCorner
+ * Arguments:
+ *     int           - the frame
+ *     Vec3<float> & - set to where the image plane corner is at the frame.  Left alone when the image plane does not move
+ * Purpose: Samples the image plane track
+ * Return Value: bool - false if the image plane has no keys
+ */
+bool Animation::GetCorner(int frame, Vec3<float> &corner) {
+	if (_corner.empty()) {
+		return false;
+	}
+	corner = Sample(_corner, frame);
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetTrackCount
+ * Arguments:
+ *     void
+ * Purpose: Returns the number of objects that move
+ * Return Value: int
+ */
+int Animation::GetTrackCount() {
+	return (int)_objects.size();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetTrackObject
+ * Arguments:
+ *     int - the track
+ * Purpose: Returns the index in the object list of the scene of the object a track moves
+ * Return Value: int
+ */
+int Animation::GetTrackObject(int track) {
+	return _objects[track].object;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetObjectOffset
+ * Arguments:
+ *     int - the track
+ *     int - the frame
+ * Purpose: Samples the track of an object
+ * Return Value: Vec3<float> - how far the object is moved from where the scene file places it
+ */
+Vec3<float> Animation::GetObjectOffset(int track, int frame) {
+	return Sample(_objects[track].keys, frame);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetFrameCount
+ * Arguments:
+ *     void
+ * Purpose: Returns the number of frames, the one set by the scene file or enough to reach the last key
+ * Return Value: int
+ */
+int Animation::GetFrameCount() {
+	return _frameCount > 0 ? _frameCount : _lastKey + 1;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddKey
+ * Arguments:
+ *     std::vector<animationKey> & - the keys of a track, sorted by frame
+ *     int                         - the frame
+ *     Vec3<float>                 - the value at that frame
+ * Purpose: Inserts a key in frame order, replacing a key of the same frame
+ * Return Value: void
+ */
+void Animation::AddKey(std::vector<animationKey> &keys, int frame, Vec3<float> value) {
+	size_t position = 0;
+	while (position < keys.size() && keys[position].frame < frame) {
+		position++;
+	}
+	if (position < keys.size() && keys[position].frame == frame) {
+		keys[position].value = value;
+		return;
+	}
+
+	animationKey key;
+	key.frame = frame;
+	key.value = value;
+	keys.insert(keys.begin() + position, key);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Sample
+ * Arguments:
+ *     const std::vector<animationKey> & - the keys of a track, sorted by frame.  Must not be empty
+ *     int                               - the frame
+ * Purpose: Interpolates between the keys on either side of a frame
+ * Return Value: Vec3<float>
+ */
+Vec3<float> Animation::Sample(const std::vector<animationKey> &keys, int frame) {
+	if (frame <= keys.front().frame) {
+		return keys.front().value;
+	}
+	if (frame >= keys.back().frame) {
+		return keys.back().value;
+	}
+
+	size_t next = 1;
+	while (keys[next].frame < frame) {
+		next++;
+	}
+	Vec3<float> before = keys[next - 1].value, after = keys[next].value;
+	float t = (frame - keys[next - 1].frame) / (float)(keys[next].frame - keys[next - 1].frame);
+	return before + (after - before) * t;
+}
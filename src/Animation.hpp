@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include "Vector.hpp"
+
+// The value of a track at one frame.  Between two keys the value moves in a straight line, before the first key and
+// after the last it holds still
+typedef struct {
+	int frame;
+	Vec3<float> value;
+} animationKey;
+
+// The keys of one moving object.  The object is its index in the object list of the scene and the values are offsets
+// from where the scene file places it
+typedef struct {
+	int object;
+	std::vector<animationKey> keys;
+} objectTrack;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: Animation
+ * Purpose: The keyframes of the animation section of a scene.  Moves the camera, the image plane and objects of the
+ *          scene from frame to frame
+ */
+class Animation {
+
+	public :
+		Animation();
+
+		void AddCameraKey(int frame, Vec3<float> position);
+		void AddCornerKey(int frame, Vec3<float> corner);
+		void AddObjectKey(int object, int frame, Vec3<float> offset);
+		void SetFrameCount(int frameCount);
+
+		bool GetCamera(int frame, Vec3<float> &position);
+		bool GetCorner(int frame, Vec3<float> &corner);
+		int GetTrackCount();
+		int GetTrackObject(int track);
+		Vec3<float> GetObjectOffset(int track, int frame);
+		int GetFrameCount();
+
+	private :
+		static void AddKey(std::vector<animationKey> &keys, int frame, Vec3<float> value);
+		static Vec3<float> Sample(const std::vector<animationKey> &keys, int frame);
+
+		std::vector<animationKey> _camera;
+		std::vector<animationKey> _corner;
+		std::vector<objectTrack> _objects;
+		int _frameCount; // Set by the scene file, 0 to end on the last key
+		int _lastKey;
+};
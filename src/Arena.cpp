@@ -0,0 +1,157 @@
+#include "Arena.hpp"
+
+#include <iostream>
+#include <stdint.h>
+#include <stdlib.h>
+
+using namespace std;
+
+/*
+ * Date: 10/17/26
+ * Function Name: Arena (constructor)
+ * Arguments:
+ *     void
+ * Purpose: Constructor.  No memory is reserved until the first allocation
+ * Return Value: void
+ */
+Arena::Arena() : _current(NULL), _offset(0), _capacity(0), _used(0), _reserved(0) {
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ~Arena
+ * Arguments:
+ *     void
+ * Purpose: Destructor.  Releases every block
+ * Return Value: void
+ */
+Arena::~Arena() {
+	Release();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Allocate
+ * Arguments:
+ *     size_t - the number of bytes
+ *     size_t - the alignment of the memory, a power of two
+ * Purpose: Returns memory that stays valid until the arena is released.  Large allocations get a block of their
+ *          own so they do not waste the rest of the current block
+ * Return Value: void *
+ */
+void * Arena::Allocate(size_t size, size_t alignment) {
+	if (size == 0) {
+		size = 1;
+	}
+	_used += size;
+
+	if (size + alignment > ARENA_LARGE_ALLOCATION) {
+		uintptr_t block = (uintptr_t)AllocateBlock(size + alignment);
+		return (void *)((block + alignment - 1) & ~(uintptr_t)(alignment - 1));
+	}
+
+	uintptr_t start = ((uintptr_t)_current + _offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	if (_current == NULL || start + size > (uintptr_t)_current + _capacity) {
+		_current = (char *)AllocateBlock(ARENA_BLOCK_SIZE);
+		_capacity = ARENA_BLOCK_SIZE;
+		start = ((uintptr_t)_current + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	}
+	_offset = start + size - (uintptr_t)_current;
+	return (void *)start;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Free
+ * Arguments:
+ *     void * - memory handed out by Allocate
+ *     size_t - the bytes that were asked for
+ * Purpose: Gives memory back early.  The space is only reused when it is the last allocation of the current
+ *          block, anything else stays taken until the arena is released
+ * Return Value: void
+ */
+void Arena::Free(void * memory, size_t size) {
+	if (size == 0) {
+		size = 1;
+	}
+	uintptr_t start = (uintptr_t)memory;
+	if (_current != NULL && start >= (uintptr_t)_current && start + size == (uintptr_t)_current + _offset) {
+		_offset = start - (uintptr_t)_current;
+		_used -= size;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Release
+ * Arguments:
+ *     void
+ * Purpose: Frees every block.  All memory handed out by the arena is invalid afterwards
+ * Return Value: void
+ */
+void Arena::Release() {
+	for (size_t i = 0; i < _blocks.size(); i++) {
+		free(_blocks[i]);
+	}
+	_blocks.clear();
+	_current = NULL;
+	_offset = 0;
+	_capacity = 0;
+	_used = 0;
+	_reserved = 0;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetUsed
+ * Arguments:
+ *     void
+ * Purpose: Returns the bytes handed out since the arena was last released
+ * Return Value: size_t
+ */
+size_t Arena::GetUsed() {
+	return _used;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetReserved
+ * Arguments:
+ *     void
+ * Purpose: Returns the bytes of all of the blocks
+ * Return Value: size_t
+ */
+size_t Arena::GetReserved() {
+	return _reserved;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetBlockCount
+ * Arguments:
+ *     void
+ * Purpose: Returns the number of blocks
+ * Return Value: int
+ */
+int Arena::GetBlockCount() {
+	return (int)_blocks.size();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AllocateBlock
+ * Arguments:
+ *     size_t - the bytes of the block
+ * Purpose: Reserves another block
+ * Return Value: void *
+ */
+void * Arena::AllocateBlock(size_t size) {
+	void * block = malloc(size);
+	if (block == NULL) {
+		cout << "Failed to allocate " << size << " bytes for the scene.  Exiting" << endl;
+		exit(10);
+	}
+	_blocks.push_back(block);
+	_reserved += size;
+	return block;
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <memory>
+#include <stddef.h>
+#include <type_traits>
+#include <vector>
+
+#define ARENA_BLOCK_SIZE (1 << 20) // Bytes the arena reserves at a time
+#define ARENA_LARGE_ALLOCATION (ARENA_BLOCK_SIZE / 4) // Allocations at least this big get a block of their own
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: Arena
+ * Purpose: Hands out memory from large blocks by bumping an offset.  Only the last allocation can be given back
+ *          early, everything else is released at once when the arena is released or destroyed
+ */
+class Arena {
+
+	public :
+		Arena();
+		~Arena();
+
+		void * Allocate(size_t size, size_t alignment);
+		template <typename T> T * Copy(const T * elements, size_t count);
+		void Free(void * memory, size_t size);
+		void Release();
+		size_t GetUsed();
+		size_t GetReserved();
+		int GetBlockCount();
+
+	private :
+		// Memory handed out by an arena is tied to it, so an arena cannot be copied
+		Arena(const Arena &other);
+		Arena & operator=(const Arena &other);
+
+		void * AllocateBlock(size_t size);
+
+		std::vector<void *> _blocks;
+		char * _current;
+		size_t _offset;
+		size_t _capacity;
+		size_t _used;
+		size_t _reserved;
+};
+
+/*
+ * Date: 10/17/26
+ * Function Name: Copy
+ * Arguments:
+ *     const T * - the elements
+ *     size_t    - the number of elements
+ * Purpose: Copies an array into the arena, for arrays that are filled elsewhere and then kept with the scene
+ * Return Value: T * - the copy
+ */
+template <typename T>
+T * Arena::Copy(const T * elements, size_t count) {
+	T * copy = (T *)Allocate(count * sizeof(T), alignof(T));
+	std::uninitialized_copy(elements, elements + count, copy);
+	return copy;
+}
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: ArenaAllocator
+ * Purpose: Lets standard containers take their memory from an Arena, or from the heap when it has none.  Memory
+ *          given back to an arena is only reused if it was the last allocation, so a container that grows leaves
+ *          its old buffers behind until the arena is released.  Reserve containers before filling them
+ */
+template <typename T>
+class ArenaAllocator {
+
+	public :
+		typedef T value_type;
+		typedef std::true_type propagate_on_container_copy_assignment;
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type propagate_on_container_swap;
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: ArenaAllocator (constructor)
+		 * Arguments:
+		 *     Arena * - the arena to allocate from, NULL to allocate from the heap
+		 * Purpose: Constructor
+		 * Return Value: void
+		 */
+		ArenaAllocator(Arena * arena = NULL) : _arena(arena) {
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: ArenaAllocator (constructor)
+		 * Arguments:
+		 *     const ArenaAllocator<U> & - an allocator of another type
+		 * Purpose: Constructor for the same arena with another type, used by the containers internally
+		 * Return Value: void
+		 */
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U> &other) : _arena(other.GetArena()) {
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: allocate
+		 * Arguments:
+		 *     size_t - the number of elements
+		 * Purpose: Allocates room for the elements from the arena
+		 * Return Value: T *
+		 */
+		T * allocate(size_t count) {
+			if (_arena == NULL) {
+				return (T *)::operator new(count * sizeof(T));
+			}
+			return (T *)_arena->Allocate(count * sizeof(T), alignof(T));
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: deallocate
+		 * Arguments:
+		 *     T *    - the elements
+		 *     size_t - the number of elements
+		 * Purpose: Gives the elements back.  The arena only reuses them if they were its last allocation
+		 * Return Value: void
+		 */
+		void deallocate(T * elements, size_t count) {
+			if (_arena == NULL) {
+				::operator delete(elements);
+			}
+			else {
+				_arena->Free(elements, count * sizeof(T));
+			}
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetArena
+		 * Arguments:
+		 *     void
+		 * Purpose: Returns the arena the allocator takes memory from
+		 * Return Value: Arena *
+		 */
+		Arena * GetArena() const {
+			return _arena;
+		}
+
+	private :
+		Arena * _arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+	return a.GetArena() == b.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+	return a.GetArena() != b.GetArena();
+}
@@ -0,0 +1,1843 @@
+#include "BVH.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+
+#define BVH_MAX_DEPTH 60 // Keeps the traversal stack at a fixed size
+#define BVH_MAX_LEAF_SIZE 8 // Forces a split even if the SAH prefers a leaf
+#define BVH_TRAVERSAL_COST 1.f // Cost of visiting a node relative to a primitive or triangle packet intersection
+#define BVH_MEDIUM_BINS 32 // Bins per axis of the MEDIUM quality build
+#define BVH_FAST_BINS 8 // Bins per axis of the FAST quality build
+#define BVH_MAX_BINS 32 // The most bins any quality uses
+#define BVH_TASK_SIZE 4096 // Subtrees with at least this many primitives are built as separate thread pool tasks
+
+/*
+ * Date: 10/17/26
+ * Function Name: Component
+ * Arguments:
+ *     Vec3<float> - the vector
+ *     int         - the axis (0 = x, 1 = y, 2 = z)
+ * Purpose: Returns the component of a vector along an axis
+ * Return Value: float
+ */
+static inline float Component(const Vec3<float> &vec, int axis) {
+	return axis == 0 ? vec.x : (axis == 1 ? vec.y : vec.z);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LeafCost
+ * Arguments:
+ *     int - the number of triangles
+ *     int - the number of spheres
+ *     int - the number of primitives that are neither
+ * Purpose: Returns the cost of intersecting a leaf.  Triangles and spheres are tested a whole packet at a time
+ * Return Value: float
+ */
+static inline float LeafCost(int triangles, int spheres, int others) {
+	return (float)((triangles + TRIANGLE_PACKET_WIDTH - 1) / TRIANGLE_PACKET_WIDTH + (spheres + SPHERE_PACKET_WIDTH - 1) / SPHERE_PACKET_WIDTH + others);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: RebindArray
+ * Arguments:
+ *     std::vector<T, ArenaAllocator<T> > & - the array
+ *     Arena *                              - the arena it allocates from from now on, NULL for the heap
+ * Purpose: Empties an array and moves it to another arena
+ * Return Value: void
+ */
+template <typename T>
+static void RebindArray(std::vector<T, ArenaAllocator<T> > &array, Arena * arena) {
+	std::vector<T, ArenaAllocator<T> >(ArenaAllocator<T>(arena)).swap(array);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BVH (constructor)
+ * Arguments:
+ *     Arena * - the arena of the scene the nodes and packets are stored in, NULL to store them on the heap
+ * Purpose: Constructor
+ * Return Value: void
+ */
+BVH::BVH(Arena * arena) : _nodes(ArenaAllocator<BVHNode>(arena)), _primitives(ArenaAllocator<BVHPrimitive>(arena)), _nodeCount(0), _buildPool(NULL), _buildGroup(NULL),
+                          _binCount(0), _depth(0), _quality(BVH_QUALITY_HIGH), _refitLimit(BVH_REFIT_LIMIT), _builtSahCost(0), _sahArea(0), _costSum(0),
+                          _leaves(ArenaAllocator<BVHLeaf>(arena)), _packets(ArenaAllocator<trianglePacket>(arena)), _packetGeometry(ArenaAllocator<Geometry *>(arena)),
+                          _spherePackets(ArenaAllocator<spherePacket>(arena)), _spherePacketGeometry(ArenaAllocator<Geometry *>(arena)),
+                          _leafPrimitives(ArenaAllocator<BVHPrimitive>(arena)), _width(2), _wideNodes4(ArenaAllocator<BVHWideNode<4> >(arena)),
+                          _wideNodes8(ArenaAllocator<BVHWideNode<8> >(arena)), _wideSlots(ArenaAllocator<int>(arena)) {
+	_stats.milliseconds = 0;
+	_stats.primitives = 0;
+	_stats.leaves = 0;
+	_stats.sahCost = 0;
+	_stats.threads = 1;
+	_stats.fromCache = false;
+	_stats.refits = 0;
+	_stats.refitMilliseconds = 0;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetArena
+ * Arguments:
+ *     Arena * - the arena of the scene, NULL to store the hierarchy on the heap
+ * Purpose: Moves the storage of the hierarchy to another arena.  The hierarchy is emptied and has to be built or
+ *          loaded again
+ * Return Value: void
+ */
+void BVH::SetArena(Arena * arena) {
+	RebindArray(_nodes, arena);
+	RebindArray(_primitives, arena);
+	RebindArray(_leaves, arena);
+	RebindArray(_packets, arena);
+	RebindArray(_packetGeometry, arena);
+	RebindArray(_spherePackets, arena);
+	RebindArray(_spherePacketGeometry, arena);
+	RebindArray(_leafPrimitives, arena);
+	RebindArray(_wideNodes4, arena);
+	RebindArray(_wideNodes8, arena);
+	RebindArray(_wideSlots, arena);
+	_parents.clear();
+	_depth = 0;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetWideNodes
+ * Arguments:
+ *     void
+ * Purpose: Returns the nodes of the four wide layout
+ * Return Value: std::vector<BVHWideNode<4>, ArenaAllocator<BVHWideNode<4> > > &
+ */
+template <>
+std::vector<BVHWideNode<4>, ArenaAllocator<BVHWideNode<4> > > & BVH::GetWideNodes<4>() {
+	return _wideNodes4;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetWideNodes
+ * Arguments:
+ *     void
+ * Purpose: Returns the nodes of the eight wide layout
+ * Return Value: std::vector<BVHWideNode<8>, ArenaAllocator<BVHWideNode<8> > > &
+ */
+template <>
+std::vector<BVHWideNode<8>, ArenaAllocator<BVHWideNode<8> > > & BVH::GetWideNodes<8>() {
+	return _wideNodes8;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetWidth
+ * Arguments:
+ *     int - the children per node the hierarchy is traced with: 2 for the binary layout, 4 or 8 for a wide one
+ * Purpose: Selects the layout the rays walk.  Other widths fall back to the binary layout
+ * Return Value: void
+ */
+void BVH::SetWidth(int width) {
+	_width = (width == 4 || width == 8) ? width : 2;
+	BuildWide();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Build
+ * Arguments:
+ *     std::vector<Geometry *> - the geometry to build the hierarchy over
+ *     ThreadPool *            - builds large subtrees in parallel, NULL to build on the calling thread only
+ *     bvh_quality             - how hard to look for good splits
+ * Purpose: Builds the hierarchy top down using the surface area heuristic
+ * Return Value: void
+ */
+void BVH::Build(std::vector<Geometry *> &geometry, ThreadPool * pool, bvh_quality quality) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	_nodes.clear();
+	_primitives.clear();
+	_primitiveBounds.clear();
+	_centroids.clear();
+	_order.clear();
+	_triangleCounts.clear();
+	_isSphere.clear();
+	_parents.clear();
+	_depth = 0;
+	_quality = quality;
+
+	// Only geometry with a volume can be hit by a ray.  Geometry made of several primitives (meshes) gets one
+	// entry per primitive
+	std::vector<BVHPrimitive> candidates;
+	Vec3<float> vertices[6];
+	Vec3<float> center;
+	float radius;
+	for (size_t i = 0; i < geometry.size(); i++) {
+		int primitiveCount = geometry[i]->GetPrimitiveCount();
+		for (int j = (primitiveCount > 0 ? 0 : -1); j < primitiveCount; j++) {
+			BoundingBox box = j < 0 ? geometry[i]->GetBoundingBox() : geometry[i]->GetPrimitiveBounds(j);
+			if (!box.IsEmpty()) {
+				BVHPrimitive primitive;
+				primitive.geometry = geometry[i];
+				primitive.index = j;
+				candidates.push_back(primitive);
+				_primitiveBounds.push_back(box);
+				_centroids.push_back(box.GetCenter());
+				_order.push_back((int)_order.size());
+				_triangleCounts.push_back(geometry[i]->GetTriangles(j, vertices));
+				_isSphere.push_back(geometry[i]->GetSphere(j, center, radius) ? 1 : 0);
+			}
+		}
+	}
+
+	if (!candidates.empty()) {
+		_rightArea.resize(candidates.size());
+		_rightTriangles.resize(candidates.size());
+		_rightSpheres.resize(candidates.size());
+		_binCount = quality == BVH_QUALITY_FAST ? BVH_FAST_BINS : (quality == BVH_QUALITY_MEDIUM ? BVH_MEDIUM_BINS : 0);
+
+		// A tree over n primitives has at most 2n - 1 nodes, so the nodes can be handed out to the tasks with a
+		// counter.  Large subtrees become tasks of the pool and the calling thread helps until all of them are done
+		_nodes.resize(2 * candidates.size());
+		_nodeCount = 1;
+		TaskGroup group;
+		_buildPool = pool;
+		_buildGroup = &group;
+		Subdivide(0, 0, (int)candidates.size(), 1);
+		if (pool != NULL) {
+			pool->Wait(group);
+		}
+		_buildPool = NULL;
+		_buildGroup = NULL;
+
+		// Lay the nodes out depth first no matter which task made them, so the tree is the same on every run
+		std::vector<BVHNode> built(_nodes.begin(), _nodes.begin() + _nodeCount.load());
+		_nodes.clear();
+		_nodes.reserve(built.size());
+		_nodes.push_back(BVHNode());
+		Flatten(built, 0, 0, 1);
+
+		// Store the primitives in leaf order so each leaf references a contiguous range
+		_primitives.reserve(candidates.size());
+		for (size_t i = 0; i < _order.size(); i++) {
+			_primitives.push_back(candidates[_order[i]]);
+		}
+	}
+
+	_primitiveBounds.clear();
+	_centroids.clear();
+	_order.clear();
+	_rightArea.clear();
+	_rightTriangles.clear();
+	_rightSpheres.clear();
+	_triangleCounts.clear();
+	_isSphere.clear();
+
+	BuildPackets();
+	MeasureTree();
+	BuildWide();
+	_builtSahCost = _stats.sahCost;
+	_stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	_stats.threads = pool != NULL ? pool->GetThreadCount() : 1;
+	_stats.fromCache = false;
+	_stats.refits = 0;
+	_stats.refitMilliseconds = 0;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Load
+ * Arguments:
+ *     std::vector<Geometry *> - the geometry the hierarchy was built over
+ *     const BVHNode *         - the nodes of a previously built hierarchy
+ *     int                     - the number of nodes
+ *     const BVHReference *    - the primitives in leaf order
+ *     int                     - the number of primitives
+ *     int                     - the depth of the hierarchy
+ * Purpose: Restores a hierarchy saved from GetNodes and GetReferences instead of building it
+ * Return Value: void
+ */
+void BVH::Load(std::vector<Geometry *> &geometry, const BVHNode * nodes, int nodeCount, const BVHReference * references, int referenceCount, int depth) {
+	_nodes.assign(nodes, nodes + nodeCount);
+	_primitives.resize(referenceCount);
+	for (int i = 0; i < referenceCount; i++) {
+		_primitives[i].geometry = geometry[references[i].geometry];
+		_primitives[i].index = references[i].primitive;
+	}
+	_depth = depth;
+	_parents.clear();
+
+	BuildPackets();
+	MeasureTree();
+	BuildWide();
+	_builtSahCost = _stats.sahCost;
+	_stats.milliseconds = 0;
+	_stats.threads = 1;
+	_stats.fromCache = true;
+	_stats.refits = 0;
+	_stats.refitMilliseconds = 0;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Validate
+ * Arguments:
+ *     const BVHNode * - the nodes of a stored hierarchy
+ *     int             - the number of nodes
+ *     int             - the number of primitives the leaves reference
+ *     int             - the depth the hierarchy was stored with
+ * Purpose: Checks that a stored hierarchy is a tree Load can take.  The tree is walked from the root: every node must
+ *          be reached exactly once, every leaf range must lie within the primitives and the depth must match and fit
+ *          the fixed traversal stacks
+ * Return Value: bool - false if the hierarchy is damaged
+ */
+bool BVH::Validate(const BVHNode * nodes, int nodeCount, int referenceCount, int depth) {
+	if (nodeCount <= 0) {
+		return nodeCount == 0 && depth == 0;
+	}
+
+	std::vector<bool> reached(nodeCount, false);
+	std::vector<std::pair<int, int> > stack;
+	stack.push_back(std::make_pair(0, 1));
+	reached[0] = true;
+	int reachedCount = 1;
+	int deepest = 0;
+
+	while (!stack.empty()) {
+		int nodeIndex = stack.back().first;
+		int nodeDepth = stack.back().second;
+		stack.pop_back();
+		if (nodeDepth > BVH_MAX_DEPTH) {
+			return false;
+		}
+		deepest = std::max(deepest, nodeDepth);
+
+		const BVHNode &node = nodes[nodeIndex];
+		if (node.count > 0) {
+			if (node.leftFirst < 0 || node.count > referenceCount - node.leftFirst) {
+				return false;
+			}
+			continue;
+		}
+
+		// Both children sit next to each other after the node
+		if (node.leftFirst <= nodeIndex || node.leftFirst >= nodeCount - 1) {
+			return false;
+		}
+		for (int child = node.leftFirst; child <= node.leftFirst + 1; child++) {
+			if (reached[child]) {
+				return false;
+			}
+			reached[child] = true;
+			reachedCount++;
+			stack.push_back(std::make_pair(child, nodeDepth + 1));
+		}
+	}
+
+	return reachedCount == nodeCount && deepest == depth;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Refit
+ * Arguments:
+ *     std::vector<Geometry *>         - the geometry the hierarchy was built over
+ *     const std::vector<Geometry *> & - the geometry that moved since the last build or refit
+ *     ThreadPool *                    - used if the tree has to be rebuilt, NULL to rebuild on the calling thread
+ * Purpose: Updates the hierarchy after geometry moves without changing its shape.  The leaves holding the moved
+ *          primitives get new bounds and packets and the bounds of their ancestors grow or shrink to match, so the
+ *          work is the moved primitives times the depth of the tree.  Moved geometry must keep its number of
+ *          primitives.  The tree is rebuilt with the quality of the last build once its SAH cost passes the refit
+ *          limit times the cost it was built with
+ * Return Value: bool - true if the tree was rebuilt
+ */
+bool BVH::Refit(std::vector<Geometry *> &geometry, const std::vector<Geometry *> &changed, ThreadPool * pool) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	if (_nodes.empty()) {
+		Build(geometry, pool, _quality);
+		return true;
+	}
+	PrepareRefit();
+
+	// Mark the leaves of the moved primitives and every ancestor of them once
+	for (size_t i = 0; i < changed.size(); i++) {
+		std::vector<std::pair<Geometry *, int> >::iterator it = std::lower_bound(_geometryPrimitives.begin(), _geometryPrimitives.end(), std::make_pair(changed[i], INT_MIN));
+		for (; it != _geometryPrimitives.end() && it->first == changed[i]; ++it) {
+			for (int node = _primitiveLeaves[it->second]; node >= 0 && !_refitMarks[node]; node = _parents[node]) {
+				_refitMarks[node] = 1;
+				_refitNodes.push_back(node);
+			}
+		}
+	}
+
+	// Children come after their parents in the depth first layout, so the highest index goes first
+	std::sort(_refitNodes.begin(), _refitNodes.end(), std::greater<int>());
+	for (size_t i = 0; i < _refitNodes.size(); i++) {
+		RefitNode(_refitNodes[i]);
+		_refitMarks[_refitNodes[i]] = 0;
+	}
+	_refitNodes.clear();
+
+	float rootArea = _nodes[0].bounds.SurfaceArea();
+	_stats.sahCost = rootArea > 0 ? (float)(_sahArea / rootArea) : (float)_costSum;
+	if (_stats.sahCost > _builtSahCost * _refitLimit) {
+		Build(geometry, pool, _quality);
+		return true;
+	}
+
+	_stats.refits++;
+	_stats.refitMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetRefitLimit
+ * Arguments:
+ *     float - how many times the SAH cost of the built tree a refit tree may cost before it is rebuilt
+ * Purpose: Trades refit speed for tracing speed.  Limits below one are raised to one
+ * Return Value: void
+ */
+void BVH::SetRefitLimit(float limit) {
+	_refitLimit = std::max(limit, 1.f);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: PrepareRefit
+ * Arguments:
+ *     void
+ * Purpose: Works out the parents, the leaf of every primitive and the primitives of every geometry the first time
+ *          the tree is refit
+ * Return Value: void
+ */
+void BVH::PrepareRefit() {
+	if (_parents.size() == _nodes.size()) {
+		return;
+	}
+
+	_parents.assign(_nodes.size(), -1);
+	_primitiveLeaves.assign(_primitives.size(), -1);
+	_geometryPrimitives.resize(_primitives.size());
+	_refitMarks.assign(_nodes.size(), 0);
+	_refitNodes.clear();
+	for (size_t i = 0; i < _nodes.size(); i++) {
+		const BVHNode &node = _nodes[i];
+		if (node.count > 0) {
+			for (int j = node.leftFirst; j < node.leftFirst + node.count; j++) {
+				_primitiveLeaves[j] = (int)i;
+			}
+		}
+		else {
+			_parents[node.leftFirst] = (int)i;
+			_parents[node.leftFirst + 1] = (int)i;
+		}
+	}
+	for (size_t i = 0; i < _primitives.size(); i++) {
+		_geometryPrimitives[i] = std::make_pair(_primitives[i].geometry, (int)i);
+	}
+	std::sort(_geometryPrimitives.begin(), _geometryPrimitives.end());
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: RefitNode
+ * Arguments:
+ *     int - the node.  Its children must already be refit
+ * Purpose: Recomputes the bounds of a node, the packets of a leaf and the box of the node in the wide layout, and
+ *          moves its share of the SAH cost from the old bounds to the new ones
+ * Return Value: void
+ */
+void BVH::RefitNode(int nodeIndex) {
+	BVHNode &node = _nodes[nodeIndex];
+	_sahArea -= (double)node.bounds.SurfaceArea() * NodeCost(nodeIndex);
+
+	BoundingBox bounds;
+	if (node.count > 0) {
+		for (int i = node.leftFirst; i < node.leftFirst + node.count; i++) {
+			const BVHPrimitive &primitive = _primitives[i];
+			bounds.Expand(primitive.index < 0 ? primitive.geometry->GetBoundingBox() : primitive.geometry->GetPrimitiveBounds(primitive.index));
+		}
+		PackLeaf(nodeIndex);
+	}
+	else {
+		bounds.Expand(_nodes[node.leftFirst].bounds);
+		bounds.Expand(_nodes[node.leftFirst + 1].bounds);
+	}
+	node.bounds = bounds;
+	_sahArea += (double)bounds.SurfaceArea() * NodeCost(nodeIndex);
+
+	int slot = _wideSlots.empty() ? -1 : _wideSlots[nodeIndex];
+	if (slot >= 0 && _width == 4) {
+		BoxKernel::SetBox(_wideNodes4[slot / 4].bounds, slot % 4, bounds);
+	}
+	else if (slot >= 0 && _width == 8) {
+		BoxKernel::SetBox(_wideNodes8[slot / 8].bounds, slot % 8, bounds);
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Subdivide
+ * Arguments:
+ *     int - the index of the node being built
+ *     int - the first primitive (in _order) covered by the node
+ *     int - the number of primitives covered by the node
+ *     int - the depth of the node in the tree
+ * Purpose: Computes the node bounds and recursively splits it where the SAH cost is lowest.  The left half of a
+ *          large node is handed to the build pool while this thread carries on with the right half
+ * Return Value: void
+ */
+void BVH::Subdivide(int nodeIndex, int first, int count, int depth) {
+	BoundingBox bounds;
+	int triangles = 0, spheres = 0, others = 0;
+	for (int i = first; i < first + count; i++) {
+		int primitive = _order[i];
+		bounds.Expand(_primitiveBounds[primitive]);
+		triangles += _triangleCounts[primitive];
+		spheres += _isSphere[primitive];
+		others += (_triangleCounts[primitive] == 0 && !_isSphere[primitive]) ? 1 : 0;
+	}
+
+	_nodes[nodeIndex].bounds = bounds;
+	_nodes[nodeIndex].leftFirst = first;
+	_nodes[nodeIndex].count = count;
+
+	if (count <= 1 || depth >= BVH_MAX_DEPTH) {
+		return;
+	}
+
+	int axis = 0, split = 0;
+	BVHBinSplit binSplit;
+	float splitCost = BVH_TRAVERSAL_COST + (_binCount > 0 ? FindBinnedSplit(first, count, binSplit, split) : FindBestSplit(first, count, axis, split)) / bounds.SurfaceArea();
+
+	// Keep the leaf if splitting would not be cheaper than testing every primitive
+	if ((split <= 0 && (_binCount == 0 || count <= BVH_MAX_LEAF_SIZE)) || (splitCost >= LeafCost(triangles, spheres, others) && count <= BVH_MAX_LEAF_SIZE)) {
+		return;
+	}
+
+	if (_binCount == 0) {
+		SortByCentroid(first, count, axis);
+	}
+	else if (split > 0) {
+		PartitionByBin(first, count, binSplit);
+	}
+	else {
+		// Every centroid is in the same place, any split is as good as another
+		split = count / 2;
+	}
+
+	int leftIndex = _nodeCount.fetch_add(2);
+	_nodes[nodeIndex].leftFirst = leftIndex;
+	_nodes[nodeIndex].count = 0;
+
+	if (_buildPool != NULL && split >= BVH_TASK_SIZE) {
+		_buildPool->Submit(*_buildGroup, [this, leftIndex, first, split, depth]() {
+			Subdivide(leftIndex, first, split, depth + 1);
+		});
+	}
+	else {
+		Subdivide(leftIndex, first, split, depth + 1);
+	}
+	Subdivide(leftIndex + 1, first + split, count - split, depth + 1);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: FindBestSplit
+ * Arguments:
+ *     int   - the first primitive (in _order) to split
+ *     int   - the number of primitives to split
+ *     int & - set to the axis of the best split
+ *     int & - set to the number of primitives left of the best split
+ * Purpose: Sweeps every axis and returns the lowest area weighted cost of a split.  The scratch arrays are used at
+ *          the positions of the range so subtrees can be built at the same time
+ * Return Value: float
+ */
+float BVH::FindBestSplit(int first, int count, int &axis, int &split) {
+	float bestCost = FLT_MAX;
+	split = 0;
+
+	for (int a = 0; a < 3; a++) {
+		SortByCentroid(first, count, a);
+
+		// Areas and packed primitive counts of the boxes to the right of every split position
+		BoundingBox right;
+		int triangles = 0, spheres = 0, others = 0;
+		for (int i = count - 1; i >= 0; i--) {
+			int primitive = _order[first + i];
+			others += (_triangleCounts[primitive] == 0 && !_isSphere[primitive]) ? 1 : 0;
+			if (i > 0) {
+				triangles += _triangleCounts[primitive];
+				spheres += _isSphere[primitive];
+				right.Expand(_primitiveBounds[primitive]);
+				_rightArea[first + i] = right.SurfaceArea();
+				_rightTriangles[first + i] = triangles;
+				_rightSpheres[first + i] = spheres;
+			}
+		}
+
+		BoundingBox left;
+		int leftTriangles = 0, leftSpheres = 0, leftOthers = 0;
+		for (int i = 1; i < count; i++) {
+			int primitive = _order[first + i - 1];
+			left.Expand(_primitiveBounds[primitive]);
+			leftTriangles += _triangleCounts[primitive];
+			leftSpheres += _isSphere[primitive];
+			leftOthers += (_triangleCounts[primitive] == 0 && !_isSphere[primitive]) ? 1 : 0;
+
+			float cost = left.SurfaceArea() * LeafCost(leftTriangles, leftSpheres, leftOthers)
+			           + _rightArea[first + i] * LeafCost(_rightTriangles[first + i], _rightSpheres[first + i], others - leftOthers);
+			if (cost < bestCost) {
+				bestCost = cost;
+				axis = a;
+				split = i;
+			}
+		}
+	}
+
+	return bestCost;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: FindBinnedSplit
+ * Arguments:
+ *     int           - the first primitive (in _order) to split
+ *     int           - the number of primitives to split
+ *     BVHBinSplit & - set to the axis and bin of the best split
+ *     int &         - set to the number of primitives left of the best split, 0 if there is none
+ * Purpose: Drops the centroids into _binCount bins along every axis and returns the lowest area weighted cost of
+ *          a split between two bins.  Linear in the number of primitives instead of sorting them
+ * Return Value: float
+ */
+float BVH::FindBinnedSplit(int first, int count, BVHBinSplit &binSplit, int &split) {
+	typedef struct {
+		BoundingBox bounds;
+		int triangles;
+		int spheres;
+		int others;
+		int count;
+	} bin;
+
+	BoundingBox centroidBounds;
+	for (int i = first; i < first + count; i++) {
+		centroidBounds.Expand(_centroids[_order[i]]);
+	}
+
+	float bestCost = FLT_MAX;
+	split = 0;
+	for (int a = 0; a < 3; a++) {
+		float start = Component(centroidBounds.lower, a);
+		float extent = Component(centroidBounds.upper, a) - start;
+		if (!(extent > 0)) {
+			continue;
+		}
+		float scale = (float)_binCount / extent;
+
+		bin bins[BVH_MAX_BINS];
+		for (int b = 0; b < _binCount; b++) {
+			bins[b].bounds = BoundingBox();
+			bins[b].triangles = bins[b].spheres = bins[b].others = bins[b].count = 0;
+		}
+		for (int i = first; i < first + count; i++) {
+			int primitive = _order[i];
+			int b = std::min(_binCount - 1, (int)((Component(_centroids[primitive], a) - start) * scale));
+			bins[b].bounds.Expand(_primitiveBounds[primitive]);
+			bins[b].triangles += _triangleCounts[primitive];
+			bins[b].spheres += _isSphere[primitive];
+			bins[b].others += (_triangleCounts[primitive] == 0 && !_isSphere[primitive]) ? 1 : 0;
+			bins[b].count++;
+		}
+
+		// Cost of everything right of each bin boundary, then sweep the left side across
+		float rightCost[BVH_MAX_BINS];
+		BoundingBox right;
+		int triangles = 0, spheres = 0, others = 0;
+		for (int b = _binCount - 1; b > 0; b--) {
+			// Expanding by an empty box would take in its inverted corners
+			if (bins[b].count > 0) {
+				right.Expand(bins[b].bounds);
+			}
+			triangles += bins[b].triangles;
+			spheres += bins[b].spheres;
+			others += bins[b].others;
+			rightCost[b] = right.SurfaceArea() * LeafCost(triangles, spheres, others);
+		}
+
+		BoundingBox left;
+		int leftTriangles = 0, leftSpheres = 0, leftOthers = 0, leftCount = 0;
+		for (int b = 1; b < _binCount; b++) {
+			if (bins[b - 1].count > 0) {
+				left.Expand(bins[b - 1].bounds);
+			}
+			leftTriangles += bins[b - 1].triangles;
+			leftSpheres += bins[b - 1].spheres;
+			leftOthers += bins[b - 1].others;
+			leftCount += bins[b - 1].count;
+			if (leftCount == 0 || leftCount == count) {
+				continue;
+			}
+
+			float cost = left.SurfaceArea() * LeafCost(leftTriangles, leftSpheres, leftOthers) + rightCost[b];
+			if (cost < bestCost) {
+				bestCost = cost;
+				binSplit.axis = a;
+				binSplit.bin = b;
+				binSplit.start = start;
+				binSplit.scale = scale;
+				split = leftCount;
+			}
+		}
+	}
+
+	return bestCost;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: PartitionByBin
+ * Arguments:
+ *     int                 - the first primitive (in _order) to partition
+ *     int                 - the number of primitives to partition
+ *     const BVHBinSplit & - the split from FindBinnedSplit
+ * Purpose: Moves the primitives left of a binned split to the front of the range
+ * Return Value: void
+ */
+void BVH::PartitionByBin(int first, int count, const BVHBinSplit &binSplit) {
+	std::vector<Vec3<float> > &centroids = _centroids;
+	int binCount = _binCount;
+	std::partition(_order.begin() + first, _order.begin() + first + count, [&centroids, &binSplit, binCount](int primitive) {
+		return std::min(binCount - 1, (int)((Component(centroids[primitive], binSplit.axis) - binSplit.start) * binSplit.scale)) < binSplit.bin;
+	});
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SortByCentroid
+ * Arguments:
+ *     int - the first primitive (in _order) to sort
+ *     int - the number of primitives to sort
+ *     int - the axis to sort along
+ * Purpose: Orders a range of primitives by their centroids along an axis
+ * Return Value: void
+ */
+void BVH::SortByCentroid(int first, int count, int axis) {
+	std::vector<Vec3<float> > &centroids = _centroids;
+	std::stable_sort(_order.begin() + first, _order.begin() + first + count, [&centroids, axis](int a, int b) {
+		return Component(centroids[a], axis) < Component(centroids[b], axis);
+	});
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Flatten
+ * Arguments:
+ *     const std::vector<BVHNode> & - the nodes in the order the build made them
+ *     int                          - the node to copy
+ *     int                          - where it goes in _nodes
+ *     int                          - the depth of the node
+ * Purpose: Copies a subtree into _nodes depth first with the children of every node next to each other
+ * Return Value: void
+ */
+void BVH::Flatten(const std::vector<BVHNode> &built, int builtIndex, int nodeIndex, int depth) {
+	_nodes[nodeIndex] = built[builtIndex];
+	_depth = std::max(_depth, depth);
+	if (built[builtIndex].count > 0) {
+		return;
+	}
+
+	int leftIndex = (int)_nodes.size();
+	_nodes.push_back(BVHNode());
+	_nodes.push_back(BVHNode());
+	_nodes[nodeIndex].leftFirst = leftIndex;
+	Flatten(built, built[builtIndex].leftFirst, leftIndex, depth + 1);
+	Flatten(built, built[builtIndex].leftFirst + 1, leftIndex + 1, depth + 1);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: MeasureTree
+ * Arguments:
+ *     void
+ * Purpose: Counts the leaves and works out the SAH cost of the packed tree for the build statistics
+ * Return Value: void
+ */
+void BVH::MeasureTree() {
+	_stats.primitives = (int)_primitives.size();
+	_stats.leaves = 0;
+	_stats.sahCost = 0;
+	_sahArea = 0;
+	_costSum = 0;
+	if (_nodes.empty()) {
+		return;
+	}
+
+	for (size_t i = 0; i < _nodes.size(); i++) {
+		_stats.leaves += _nodes[i].count > 0 ? 1 : 0;
+		_sahArea += (double)_nodes[i].bounds.SurfaceArea() * NodeCost((int)i);
+		_costSum += NodeCost((int)i);
+	}
+
+	// Without an area every node counts fully
+	float rootArea = _nodes[0].bounds.SurfaceArea();
+	_stats.sahCost = rootArea > 0 ? (float)(_sahArea / rootArea) : (float)_costSum;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: NodeCost
+ * Arguments:
+ *     int - the node
+ * Purpose: Returns the cost of visiting a node, its packets and other primitives for a leaf
+ * Return Value: float
+ */
+float BVH::NodeCost(int nodeIndex) {
+	if (_nodes[nodeIndex].count > 0) {
+		const BVHLeaf &leaf = _leaves[nodeIndex];
+		return (float)(leaf.packetCount + leaf.spherePacketCount + leaf.primitiveCount);
+	}
+	return BVH_TRAVERSAL_COST;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BuildWide
+ * Arguments:
+ *     void
+ * Purpose: Collapses the binary hierarchy into the wide layout of the selected width.  The leaves and their
+ *          packets are shared with the binary layout
+ * Return Value: void
+ */
+void BVH::BuildWide() {
+	// Cleared instead of freed, so a tree that is built again reuses the memory it had in the arena
+	_wideNodes4.clear();
+	_wideNodes8.clear();
+	_wideSlots.clear();
+
+	// A hierarchy that is a single leaf has no wide nodes, the traversal starts at the leaf
+	if (_width == 2 || _nodes.empty() || _nodes[0].count > 0) {
+		return;
+	}
+	_wideSlots.assign(_nodes.size(), -1);
+
+	// Every wide node takes the place of at least one binary interior node
+	if (_width == 4) {
+		_wideNodes4.reserve((_nodes.size() + 1) / 2);
+		Collapse<4>(0);
+	}
+	else {
+		_wideNodes8.reserve((_nodes.size() + 1) / 2);
+		Collapse<8>(0);
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Collapse
+ * Arguments:
+ *     int - the binary interior node to collapse
+ * Purpose: Makes a wide node out of a binary one by opening the interior child with the largest surface area
+ *          until there are W children, then does the same for every child that is not a leaf.  The children keep
+ *          their binary order so a ray that hits two at the same time visits them in the same order as before
+ * Return Value: int - the index of the wide node
+ */
+template <int W>
+int BVH::Collapse(int nodeIndex) {
+	int children[W];
+	int count = 2;
+	children[0] = _nodes[nodeIndex].leftFirst;
+	children[1] = _nodes[nodeIndex].leftFirst + 1;
+
+	while (count < W) {
+		int largest = -1;
+		float largestArea = -1.f;
+		for (int i = 0; i < count; i++) {
+			const BVHNode &child = _nodes[children[i]];
+			if (child.count == 0 && child.bounds.SurfaceArea() > largestArea) {
+				largest = i;
+				largestArea = child.bounds.SurfaceArea();
+			}
+		}
+		if (largest < 0) {
+			break;
+		}
+
+		int leftFirst = _nodes[children[largest]].leftFirst;
+		for (int i = count; i > largest + 1; i--) {
+			children[i] = children[i - 1];
+		}
+		children[largest] = leftFirst;
+		children[largest + 1] = leftFirst + 1;
+		count++;
+	}
+
+	std::vector<BVHWideNode<W>, ArenaAllocator<BVHWideNode<W> > > &nodes = GetWideNodes<W>();
+	int wideIndex = (int)nodes.size();
+	nodes.push_back(BVHWideNode<W>());
+	for (int lane = 0; lane < W; lane++) {
+		if (lane >= count) {
+			BoxKernel::ClearBox(nodes[wideIndex].bounds, lane);
+			nodes[wideIndex].children[lane] = BVH_WIDE_EMPTY;
+			continue;
+		}
+
+		BoxKernel::SetBox(nodes[wideIndex].bounds, lane, _nodes[children[lane]].bounds);
+		_wideSlots[children[lane]] = wideIndex * W + lane;
+		int child = _nodes[children[lane]].count > 0 ? ~children[lane] : Collapse<W>(children[lane]);
+		nodes[wideIndex].children[lane] = child;
+	}
+	return wideIndex;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BuildPackets
+ * Arguments:
+ *     void
+ * Purpose: Packs the triangles and spheres of every leaf into packets for the kernels.  The other primitives are
+ *          kept in a list per leaf
+ * Return Value: void
+ */
+void BVH::BuildPackets() {
+	_leaves.assign(_nodes.size(), BVHLeaf());
+	_packets.clear();
+	_packetGeometry.clear();
+	_spherePackets.clear();
+	_spherePacketGeometry.clear();
+	_leafPrimitives.clear();
+
+	// Count the packets of every leaf first, so the arrays are allocated in the arena once
+	size_t packetCount = 0;
+	size_t spherePacketCount = 0;
+	size_t otherCount = 0;
+	Vec3<float> vertices[6];
+	Vec3<float> center;
+	float radius;
+	for (size_t i = 0; i < _nodes.size(); i++) {
+		int triangles = 0;
+		int spheres = 0;
+		for (int j = _nodes[i].leftFirst; _nodes[i].count > 0 && j < _nodes[i].leftFirst + _nodes[i].count; j++) {
+			int triangleCount = _primitives[j].geometry->GetTriangles(_primitives[j].index, vertices);
+			if (triangleCount > 0) {
+				triangles += triangleCount;
+			}
+			else if (_primitives[j].geometry->GetSphere(_primitives[j].index, center, radius)) {
+				spheres++;
+			}
+			else {
+				otherCount++;
+			}
+		}
+		packetCount += (triangles + TRIANGLE_PACKET_WIDTH - 1) / TRIANGLE_PACKET_WIDTH;
+		spherePacketCount += (spheres + SPHERE_PACKET_WIDTH - 1) / SPHERE_PACKET_WIDTH;
+	}
+	_packets.reserve(packetCount);
+	_packetGeometry.reserve(packetCount * TRIANGLE_PACKET_WIDTH);
+	_spherePackets.reserve(spherePacketCount);
+	_spherePacketGeometry.reserve(spherePacketCount * SPHERE_PACKET_WIDTH);
+	_leafPrimitives.reserve(otherCount);
+
+	for (size_t i = 0; i < _nodes.size(); i++) {
+		if (_nodes[i].count <= 0) {
+			continue;
+		}
+
+		// Every leaf starts at the end of the arrays so PackLeaf appends to them
+		BVHLeaf &leaf = _leaves[i];
+		leaf.firstPacket = (int)_packets.size();
+		leaf.firstSpherePacket = (int)_spherePackets.size();
+		leaf.firstPrimitive = (int)_leafPrimitives.size();
+		PackLeaf((int)i);
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: PackLeaf
+ * Arguments:
+ *     int - the index of the leaf node
+ * Purpose: Writes the triangles, spheres and other primitives of a leaf from its first packets on.  The arrays grow
+ *          when the leaf is at their end, otherwise the packets are overwritten in place, which is how a refit
+ *          updates a leaf whose primitives moved
+ * Return Value: void
+ */
+void BVH::PackLeaf(int nodeIndex) {
+	const BVHNode &node = _nodes[nodeIndex];
+	BVHLeaf &leaf = _leaves[nodeIndex];
+	int packet = leaf.firstPacket - 1;
+	int lane = TRIANGLE_PACKET_WIDTH;
+	int spherePacketIndex = leaf.firstSpherePacket - 1;
+	int sphereLane = SPHERE_PACKET_WIDTH;
+	int other = leaf.firstPrimitive;
+
+	Vec3<float> vertices[6];
+	Vec3<float> center;
+	float radius;
+	for (int j = node.leftFirst; j < node.leftFirst + node.count; j++) {
+		const BVHPrimitive &primitive = _primitives[j];
+		int triangleCount = primitive.geometry->GetTriangles(primitive.index, vertices);
+
+		if (triangleCount == 0 && primitive.geometry->GetSphere(primitive.index, center, radius)) {
+			// Start a new packet with every lane empty
+			if (sphereLane == SPHERE_PACKET_WIDTH) {
+				spherePacketIndex++;
+				if (spherePacketIndex == (int)_spherePackets.size()) {
+					_spherePackets.push_back(spherePacket());
+					SphereKernel::ClearPacket(_spherePackets.back());
+					_spherePacketGeometry.resize(_spherePacketGeometry.size() + SPHERE_PACKET_WIDTH, NULL);
+				}
+				sphereLane = 0;
+			}
+			SphereKernel::SetSphere(_spherePackets[spherePacketIndex], sphereLane, center, radius);
+			_spherePacketGeometry[spherePacketIndex * SPHERE_PACKET_WIDTH + sphereLane] = primitive.geometry;
+			sphereLane++;
+			continue;
+		}
+		if (triangleCount == 0) {
+			if (other == (int)_leafPrimitives.size()) {
+				_leafPrimitives.push_back(primitive);
+			}
+			else {
+				_leafPrimitives[other] = primitive;
+			}
+			other++;
+			continue;
+		}
+
+		for (int k = 0; k < triangleCount; k++) {
+			if (lane == TRIANGLE_PACKET_WIDTH) {
+				packet++;
+				if (packet == (int)_packets.size()) {
+					_packets.push_back(trianglePacket());
+					_packetGeometry.resize(_packetGeometry.size() + TRIANGLE_PACKET_WIDTH, NULL);
+				}
+				lane = 0;
+			}
+			TriangleKernel::SetTriangle(_packets[packet], lane, vertices[3 * k], vertices[3 * k + 1], vertices[3 * k + 2]);
+			_packetGeometry[packet * TRIANGLE_PACKET_WIDTH + lane] = primitive.geometry;
+			lane++;
+		}
+	}
+
+	leaf.packetCount = packet + 1 - leaf.firstPacket;
+	leaf.spherePacketCount = spherePacketIndex + 1 - leaf.firstSpherePacket;
+	leaf.primitiveCount = other - leaf.firstPrimitive;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: IntersectLeaf
+ * Arguments:
+ *     int         - the index of the leaf node
+ *     Vec3<float> - the ray
+ *     Vec3<float> - the starting position of the ray
+ *     RayHit &    - the caller's hit record
+ * Purpose: Intersects every primitive of a leaf, the triangles and spheres a packet at a time
+ * Return Value: bool - true if the hit record was updated
+ */
+bool BVH::IntersectLeaf(int nodeIndex, Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+	const BVHLeaf &leaf = _leaves[nodeIndex];
+	bool hit = false;
+
+	for (int i = leaf.firstPacket; i < leaf.firstPacket + leaf.packetCount; i++) {
+		float time;
+		int lane = _kernel.ClosestHit(_packets[i], ray, startingPos, rayHit.GetTime(), time);
+		if (lane < 0) {
+			continue;
+		}
+
+		// Same hit record Triangle::Intersect writes
+		Geometry * geometry = _packetGeometry[i * TRIANGLE_PACKET_WIDTH + lane];
+		Vec3<float> normal = TriangleKernel::GetNormal(_packets[i], lane);
+		Vec3<float> hitLocation = Vec3<float>::Add(Vec3<float>::vec3(time * ray.x, time * ray.y, time * ray.z), startingPos);
+		rayHit.SetHit(time, geometry->GetMaterialId(), normal, Vec3<float>::vec3(0, 0, 0) - normal, hitLocation, ray);
+		hit = true;
+	}
+
+	for (int i = leaf.firstSpherePacket; i < leaf.firstSpherePacket + leaf.spherePacketCount; i++) {
+		float time;
+		int lane = _sphereKernel.ClosestHit(_spherePackets[i], ray, startingPos, rayHit.GetTime(), time);
+		if (lane < 0) {
+			continue;
+		}
+
+		// Same hit record Sphere::Intersect writes
+		Geometry * geometry = _spherePacketGeometry[i * SPHERE_PACKET_WIDTH + lane];
+		Vec3<float> hitLocation = (ray * time) + startingPos;
+		Vec3<float> normal = Vec3<float>::Normalize(hitLocation - SphereKernel::GetCenter(_spherePackets[i], lane));
+		rayHit.SetHit(time, geometry->GetMaterialId(), normal, Vec3<float>::vec3(0, 0, 0), hitLocation, ray);
+		hit = true;
+	}
+
+	for (int i = leaf.firstPrimitive; i < leaf.firstPrimitive + leaf.primitiveCount; i++) {
+		const BVHPrimitive &primitive = _leafPrimitives[i];
+		if (primitive.index < 0) {
+			hit |= primitive.geometry->Intersect(ray, startingPos, rayHit);
+		} else {
+			hit |= primitive.geometry->IntersectPrimitive(primitive.index, ray, startingPos, rayHit);
+		}
+	}
+
+	return hit;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: OccludedLeaf
+ * Arguments:
+ *     int         - the index of the leaf node
+ *     Vec3<float> - the ray
+ *     Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Tests if any primitive of a leaf blocks the ray
+ * Return Value: bool
+ */
+bool BVH::OccludedLeaf(int nodeIndex, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	const BVHLeaf &leaf = _leaves[nodeIndex];
+
+	for (int i = leaf.firstPacket; i < leaf.firstPacket + leaf.packetCount; i++) {
+		if (_kernel.AnyHit(_packets[i], ray, startingPos, minTime, maxTime)) {
+			return true;
+		}
+	}
+
+	for (int i = leaf.firstSpherePacket; i < leaf.firstSpherePacket + leaf.spherePacketCount; i++) {
+		if (_sphereKernel.AnyHit(_spherePackets[i], ray, startingPos, minTime, maxTime)) {
+			return true;
+		}
+	}
+
+	for (int i = leaf.firstPrimitive; i < leaf.firstPrimitive + leaf.primitiveCount; i++) {
+		const BVHPrimitive &primitive = _leafPrimitives[i];
+		bool occluded = primitive.index < 0 ? primitive.geometry->Occluded(ray, startingPos, minTime, maxTime)
+		                                    : primitive.geometry->OccludedPrimitive(primitive.index, ray, startingPos, minTime, maxTime);
+		if (occluded) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Intersect
+ * Arguments:
+ *     Vec3<float> - the ray
+ *     Vec3<float> - the starting position of the ray
+ *     RayHit &    - the caller's hit record.  Its time bounds the search
+ * Purpose: Finds the closest intersection by walking the hierarchy front to back
+ * Return Value: bool - true if the hit record was updated
+ */
+bool BVH::Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+	if (_width == 4) {
+		return IntersectWide<4>(ray, startingPos, rayHit);
+	}
+	if (_width == 8) {
+		return IntersectWide<8>(ray, startingPos, rayHit);
+	}
+	if (_nodes.empty()) {
+		return false;
+	}
+
+	Vec3<float> inverseRay = BoundingBox::InverseRay(ray);
+	bool hit = false;
+	float entryTime;
+
+	int stack[BVH_MAX_DEPTH + 4];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		int nodeIndex = stack[--stackSize];
+		const BVHNode &node = _nodes[nodeIndex];
+		if (!node.bounds.Intersect(startingPos, inverseRay, rayHit.GetTime(), entryTime)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			hit |= IntersectLeaf(nodeIndex, ray, startingPos, rayHit);
+			continue;
+		}
+
+		// Visit the nearer child first so the farther one can be culled by the closest hit
+		float leftTime, rightTime;
+		bool hitLeft = _nodes[node.leftFirst].bounds.Intersect(startingPos, inverseRay, rayHit.GetTime(), leftTime);
+		bool hitRight = _nodes[node.leftFirst + 1].bounds.Intersect(startingPos, inverseRay, rayHit.GetTime(), rightTime);
+
+		if (hitLeft && hitRight) {
+			if (leftTime <= rightTime) {
+				stack[stackSize++] = node.leftFirst + 1;
+				stack[stackSize++] = node.leftFirst;
+			} else {
+				stack[stackSize++] = node.leftFirst;
+				stack[stackSize++] = node.leftFirst + 1;
+			}
+		} else if (hitLeft) {
+			stack[stackSize++] = node.leftFirst;
+		} else if (hitRight) {
+			stack[stackSize++] = node.leftFirst + 1;
+		}
+	}
+
+	return hit;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: IntersectPacket
+ * Arguments:
+ *     rayPacket & - the rays to trace together
+ *     RayHit *    - the caller's hit record of every ray.  Their times bound the search
+ *     bool *      - set to true for every ray whose hit record was updated
+ * Purpose: Finds the closest intersection of every ray of a coherent packet with one walk of the hierarchy.  A
+ *          node is only tested against the rest of the packet when the first ray still in play misses it, and the
+ *          rays that miss it are dropped for all of its children
+ * Return Value: void
+ */
+void BVH::IntersectPacket(rayPacket &packet, RayHit * rayHits, bool * hits) {
+	if (_width == 4) {
+		IntersectPacketWide<4>(packet, rayHits, hits);
+		return;
+	}
+	if (_width == 8) {
+		IntersectPacketWide<8>(packet, rayHits, hits);
+		return;
+	}
+	for (int i = 0; i < packet.count; i++) {
+		hits[i] = false;
+	}
+	if (_nodes.empty() || packet.count <= 0) {
+		return;
+	}
+
+	Vec3<float> inverseRays[RAY_PACKET_SIZE];
+	for (int i = 0; i < packet.count; i++) {
+		inverseRays[i] = BoundingBox::InverseRay(packet.rays[i]);
+	}
+	rayFrustum frusta[RAY_PACKET_FRUSTA];
+	int frustumCount = BuildFrusta(packet, frusta);
+	float entryTime;
+
+	// Every entry keeps a bit for each ray that can still hit the node.  The others missed an ancestor
+	int stack[BVH_MAX_DEPTH + 4];
+	unsigned int activeRays[BVH_MAX_DEPTH + 4];
+	int stackSize = 0;
+	stack[stackSize] = 0;
+	activeRays[stackSize++] = packet.count == 32 ? 0xffffffffu : (1u << packet.count) - 1;
+
+	while (stackSize > 0) {
+		stackSize--;
+		int nodeIndex = stack[stackSize];
+		unsigned int active = activeRays[stackSize];
+		const BVHNode &node = _nodes[nodeIndex];
+
+		int first = 0;
+		while (!(active & (1u << first))) {
+			first++;
+		}
+
+		// When the first active ray hits the node the whole packet goes on.  Otherwise the frusta reject the node for
+		// every ray at once before the remaining rays are tested one by one
+		bool tested = false;
+		if (!node.bounds.Intersect(packet.startingPos[first], inverseRays[first], rayHits[first].GetTime(), entryTime)) {
+			int missed = 0;
+			while (missed < frustumCount && FrustumMisses(frusta[missed], node.bounds)) {
+				missed++;
+			}
+			if (frustumCount > 0 && missed == frustumCount) {
+				continue;
+			}
+
+			active &= ~(1u << first);
+			for (int i = first + 1; i < packet.count; i++) {
+				if ((active & (1u << i)) && !node.bounds.Intersect(packet.startingPos[i], inverseRays[i], rayHits[i].GetTime(), entryTime)) {
+					active &= ~(1u << i);
+				}
+			}
+			if (active == 0) {
+				continue;
+			}
+			tested = true;
+			while (!(active & (1u << first))) {
+				first++;
+			}
+		}
+
+		if (node.count > 0) {
+			hits[first] |= IntersectLeaf(nodeIndex, packet.rays[first], packet.startingPos[first], rayHits[first]);
+			for (int i = first + 1; i < packet.count; i++) {
+				if (!(active & (1u << i))) {
+					continue;
+				}
+				if (tested || node.bounds.Intersect(packet.startingPos[i], inverseRays[i], rayHits[i].GetTime(), entryTime)) {
+					hits[i] |= IntersectLeaf(nodeIndex, packet.rays[i], packet.startingPos[i], rayHits[i]);
+				}
+			}
+			continue;
+		}
+
+		// Both children stay in play for the other rays, the one the first ray enters first is visited first
+		float leftTime, rightTime;
+		bool hitLeft = _nodes[node.leftFirst].bounds.Intersect(packet.startingPos[first], inverseRays[first], rayHits[first].GetTime(), leftTime);
+		bool hitRight = _nodes[node.leftFirst + 1].bounds.Intersect(packet.startingPos[first], inverseRays[first], rayHits[first].GetTime(), rightTime);
+
+		bool rightFirst = hitRight && (!hitLeft || rightTime < leftTime);
+		stack[stackSize] = rightFirst ? node.leftFirst : node.leftFirst + 1;
+		activeRays[stackSize++] = active;
+		stack[stackSize] = rightFirst ? node.leftFirst + 1 : node.leftFirst;
+		activeRays[stackSize++] = active;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SamePosition
+ * Arguments:
+ *     const Vec3<float> & - the first position
+ *     const Vec3<float> & - the second position
+ * Purpose: Returns true if the two positions are exactly the same
+ * Return Value: bool
+ */
+static inline bool SamePosition(const Vec3<float> &a, const Vec3<float> &b) {
+	return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BuildFrusta
+ * Arguments:
+ *     rayPacket &  - the rays of the packet
+ *     rayFrustum * - filled with up to RAY_PACKET_FRUSTA frusta
+ * Purpose: Builds one frustum for the rays of every starting position in the packet
+ * Return Value: int - the number of frusta, 0 if the packet can not be culled by frustum
+ */
+int BVH::BuildFrusta(rayPacket &packet, rayFrustum * frusta) {
+	int frustumCount = 0;
+	for (int i = 0; i < packet.count; i++) {
+		int j = 0;
+		while (j < frustumCount && !SamePosition(frusta[j].apex, packet.startingPos[i])) {
+			j++;
+		}
+		if (j == frustumCount) {
+			if (frustumCount == RAY_PACKET_FRUSTA) {
+				return 0;
+			}
+			frusta[frustumCount++].apex = packet.startingPos[i];
+		}
+	}
+
+	for (int i = 0; i < frustumCount; i++) {
+		if (!BuildFrustum(packet, frusta[i])) {
+			return 0;
+		}
+	}
+	return frustumCount;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BuildFrustum
+ * Arguments:
+ *     rayPacket &  - the rays of the packet
+ *     rayFrustum & - the frustum to build.  Its apex selects the rays it bounds
+ * Purpose: Finds the four planes through the apex that bound every ray of the packet starting there.  The rays
+ *          are projected onto the plane one unit along their dominant axis and the planes pass through the
+ *          corners of the rectangle around them
+ * Return Value: bool - false if the rays do not share a dominant direction
+ */
+bool BVH::BuildFrustum(rayPacket &packet, rayFrustum &frustum) {
+	Vec3<float> sum(0, 0, 0);
+	for (int i = 0; i < packet.count; i++) {
+		if (SamePosition(packet.startingPos[i], frustum.apex)) {
+			sum = sum + packet.rays[i];
+		}
+	}
+
+	int axis = 0;
+	for (int a = 1; a < 3; a++) {
+		if (fabsf(Component(sum, a)) > fabsf(Component(sum, axis))) {
+			axis = a;
+		}
+	}
+	float dominant = Component(sum, axis);
+	if (dominant == 0) {
+		return false;
+	}
+
+	int uAxis = (axis + 1) % 3, vAxis = (axis + 2) % 3;
+	float minU = FLT_MAX, maxU = -FLT_MAX, minV = FLT_MAX, maxV = -FLT_MAX;
+	for (int i = 0; i < packet.count; i++) {
+		if (!SamePosition(packet.startingPos[i], frustum.apex)) {
+			continue;
+		}
+		float length = Component(packet.rays[i], axis);
+		if (length * dominant <= 0) {
+			return false;
+		}
+		float u = Component(packet.rays[i], uAxis) / fabsf(length);
+		float v = Component(packet.rays[i], vAxis) / fabsf(length);
+		minU = fminf(minU, u);
+		maxU = fmaxf(maxU, u);
+		minV = fminf(minV, v);
+		maxV = fmaxf(maxV, v);
+	}
+
+	// Widen the rectangle a little so rounding in the normalized rays can never put one outside of it
+	float slack = 1e-5f * (1.f + fmaxf(fmaxf(fabsf(minU), fabsf(maxU)), fmaxf(fabsf(minV), fabsf(maxV))));
+	float cornerU[4] = {minU - slack, maxU + slack, maxU + slack, minU - slack};
+	float cornerV[4] = {minV - slack, minV - slack, maxV + slack, maxV + slack};
+
+	Vec3<float> corners[4];
+	for (int i = 0; i < 4; i++) {
+		float components[3];
+		components[axis] = dominant > 0 ? 1.f : -1.f;
+		components[uAxis] = cornerU[i];
+		components[vAxis] = cornerV[i];
+		corners[i] = Vec3<float>::vec3(components[0], components[1], components[2]);
+	}
+
+	// Point every normal towards the inside of the frustum
+	for (int i = 0; i < 4; i++) {
+		frustum.normals[i] = Vec3<float>::Cross(corners[i], corners[(i + 1) % 4]);
+		if (Vec3<float>::Dot(frustum.normals[i], sum) < 0) {
+			frustum.normals[i] = frustum.normals[i] * -1.f;
+		}
+	}
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: FrustumMisses
+ * Arguments:
+ *     const rayFrustum &  - the frustum of a packet
+ *     const BoundingBox & - the bounds of a node
+ * Purpose: Returns true if the box is entirely outside one of the frustum planes, so no ray of the frustum can
+ *          hit it.  The corner of the box farthest inside each plane is the only one that has to be tested
+ * Return Value: bool
+ */
+bool BVH::FrustumMisses(const rayFrustum &frustum, const BoundingBox &bounds) {
+	for (int i = 0; i < 4; i++) {
+		const Vec3<float> &normal = frustum.normals[i];
+		float x = (normal.x > 0 ? bounds.upper.x : bounds.lower.x) - frustum.apex.x;
+		float y = (normal.y > 0 ? bounds.upper.y : bounds.lower.y) - frustum.apex.y;
+		float z = (normal.z > 0 ? bounds.upper.z : bounds.lower.z) - frustum.apex.z;
+		float distance = normal.x * x + normal.y * y + normal.z * z;
+		float tolerance = 1e-5f * (fabsf(normal.x * x) + fabsf(normal.y * y) + fabsf(normal.z * z));
+		if (distance < -tolerance) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Occluded
+ * Arguments:
+ *     Vec3<float> - the ray
+ *     Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Any hit query for shadow rays.  Returns as soon as one primitive blocks the ray
+ * Return Value: bool
+ */
+bool BVH::Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	if (_width == 4) {
+		return OccludedWide<4>(ray, startingPos, minTime, maxTime);
+	}
+	if (_width == 8) {
+		return OccludedWide<8>(ray, startingPos, minTime, maxTime);
+	}
+	if (_nodes.empty()) {
+		return false;
+	}
+
+	Vec3<float> inverseRay = BoundingBox::InverseRay(ray);
+	float entryTime;
+
+	int stack[BVH_MAX_DEPTH + 4];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		int nodeIndex = stack[--stackSize];
+		const BVHNode &node = _nodes[nodeIndex];
+		if (!node.bounds.Intersect(startingPos, inverseRay, maxTime, entryTime)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			if (OccludedLeaf(nodeIndex, ray, startingPos, minTime, maxTime)) {
+				return true;
+			}
+		} else {
+			stack[stackSize++] = node.leftFirst + 1;
+			stack[stackSize++] = node.leftFirst;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SortByEntryTime
+ * Arguments:
+ *     int           - a bit for every child the ray hits
+ *     const float * - the entry time of the ray into every child
+ *     int *         - filled with the children hit, the farthest first
+ * Purpose: Orders the children a ray hits for the traversal stack so the nearest is visited first.  Children entered
+ *          at the same time are visited in their binary order
+ * Return Value: int - the number of children hit
+ */
+template <int W>
+static inline int SortByEntryTime(int mask, const float * entryTimes, int * order) {
+	int count = 0;
+	for (int lane = 0; lane < W; lane++) {
+		if (!(mask & (1 << lane))) {
+			continue;
+		}
+		int j = count++;
+		while (j > 0 && entryTimes[order[j - 1]] <= entryTimes[lane]) {
+			order[j] = order[j - 1];
+			j--;
+		}
+		order[j] = lane;
+	}
+	return count;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: IntersectWide
+ * Arguments:
+ *     Vec3<float> - the ray
+ *     Vec3<float> - the starting position of the ray
+ *     RayHit &    - the caller's hit record.  Its time bounds the search
+ * Purpose: Intersect on the wide layout.  All of the children of a node are tested at once and the ones entered
+ *          after the closest hit so far are skipped when they come off the stack
+ * Return Value: bool - true if the hit record was updated
+ */
+template <int W>
+bool BVH::IntersectWide(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+	if (_nodes.empty()) {
+		return false;
+	}
+
+	std::vector<BVHWideNode<W>, ArenaAllocator<BVHWideNode<W> > > &nodes = GetWideNodes<W>();
+	Vec3<float> inverseRay = BoundingBox::InverseRay(ray);
+	bool hit = false;
+	float entryTimes[W];
+	int order[W];
+
+	int stack[BVH_MAX_DEPTH * (W - 1) + 1];
+	float stackTimes[BVH_MAX_DEPTH * (W - 1) + 1];
+	int stackSize = 0;
+	stack[stackSize] = nodes.empty() ? ~0 : 0;
+	stackTimes[stackSize++] = -FLT_MAX;
+
+	while (stackSize > 0) {
+		stackSize--;
+		int child = stack[stackSize];
+		if (stackTimes[stackSize] > rayHit.GetTime()) {
+			continue;
+		}
+
+		if (child < 0) {
+			hit |= IntersectLeaf(~child, ray, startingPos, rayHit);
+			continue;
+		}
+
+		const BVHWideNode<W> &node = nodes[child];
+		int mask = _boxKernel.Intersect(node.bounds, startingPos, inverseRay, rayHit.GetTime(), entryTimes);
+		int count = SortByEntryTime<W>(mask, entryTimes, order);
+		for (int i = 0; i < count; i++) {
+			stack[stackSize] = node.children[order[i]];
+			stackTimes[stackSize++] = entryTimes[order[i]];
+		}
+	}
+
+	return hit;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: IntersectPacketWide
+ * Arguments:
+ *     rayPacket & - the rays to trace together
+ *     RayHit *    - the caller's hit record of every ray.  Their times bound the search
+ *     bool *      - set to true for every ray whose hit record was updated
+ * Purpose: IntersectPacket on the wide layout.  The first ray still in play is tested against all of the children
+ *          of a node at once and the children it hits keep the whole packet.  The children it misses are culled by
+ *          the frusta and then tested against the rest of the packet one ray at a time
+ * Return Value: void
+ */
+template <int W>
+void BVH::IntersectPacketWide(rayPacket &packet, RayHit * rayHits, bool * hits) {
+	for (int i = 0; i < packet.count; i++) {
+		hits[i] = false;
+	}
+	if (_nodes.empty() || packet.count <= 0) {
+		return;
+	}
+
+	std::vector<BVHWideNode<W>, ArenaAllocator<BVHWideNode<W> > > &nodes = GetWideNodes<W>();
+	Vec3<float> inverseRays[RAY_PACKET_SIZE];
+	for (int i = 0; i < packet.count; i++) {
+		inverseRays[i] = BoundingBox::InverseRay(packet.rays[i]);
+	}
+	rayFrustum frusta[RAY_PACKET_FRUSTA];
+	int frustumCount = BuildFrusta(packet, frusta);
+	float entryTime;
+	float entryTimes[W];
+	int order[W];
+
+	// Every entry keeps a bit for each ray that can still hit the node, and whether those rays were all tested
+	// against its box
+	int stack[BVH_MAX_DEPTH * (W - 1) + 1];
+	unsigned int activeRays[BVH_MAX_DEPTH * (W - 1) + 1];
+	bool testedRays[BVH_MAX_DEPTH * (W - 1) + 1];
+	int stackSize = 0;
+	stack[stackSize] = nodes.empty() ? ~0 : 0;
+	activeRays[stackSize] = packet.count == 32 ? 0xffffffffu : (1u << packet.count) - 1;
+	testedRays[stackSize++] = false;
+
+	while (stackSize > 0) {
+		stackSize--;
+		int child = stack[stackSize];
+		unsigned int active = activeRays[stackSize];
+		bool tested = testedRays[stackSize];
+
+		int first = 0;
+		while (!(active & (1u << first))) {
+			first++;
+		}
+
+		if (child < 0) {
+			const BoundingBox &bounds = _nodes[~child].bounds;
+			for (int i = first; i < packet.count; i++) {
+				if (!(active & (1u << i))) {
+					continue;
+				}
+				if (tested || bounds.Intersect(packet.startingPos[i], inverseRays[i], rayHits[i].GetTime(), entryTime)) {
+					hits[i] |= IntersectLeaf(~child, packet.rays[i], packet.startingPos[i], rayHits[i]);
+				}
+			}
+			continue;
+		}
+
+		const BVHWideNode<W> &node = nodes[child];
+		int mask = _boxKernel.Intersect(node.bounds, packet.startingPos[first], inverseRays[first], rayHits[first].GetTime(), entryTimes);
+
+		// The children the first ray misses go on the stack first so they are visited last
+		for (int lane = W - 1; lane >= 0; lane--) {
+			if ((mask & (1 << lane)) || node.children[lane] == BVH_WIDE_EMPTY) {
+				continue;
+			}
+
+			BoundingBox bounds = BoxKernel::GetBox(node.bounds, lane);
+			int missed = 0;
+			while (missed < frustumCount && FrustumMisses(frusta[missed], bounds)) {
+				missed++;
+			}
+			if (frustumCount > 0 && missed == frustumCount) {
+				continue;
+			}
+
+			unsigned int childActive = active & ~(1u << first);
+			for (int i = first + 1; i < packet.count; i++) {
+				if ((childActive & (1u << i)) && !bounds.Intersect(packet.startingPos[i], inverseRays[i], rayHits[i].GetTime(), entryTime)) {
+					childActive &= ~(1u << i);
+				}
+			}
+			if (childActive != 0) {
+				stack[stackSize] = node.children[lane];
+				activeRays[stackSize] = childActive;
+				testedRays[stackSize++] = true;
+			}
+		}
+
+		int count = SortByEntryTime<W>(mask, entryTimes, order);
+		for (int i = 0; i < count; i++) {
+			stack[stackSize] = node.children[order[i]];
+			activeRays[stackSize] = active;
+			testedRays[stackSize++] = false;
+		}
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: OccludedWide
+ * Arguments:
+ *     Vec3<float> - the ray
+ *     Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Occluded on the wide layout
+ * Return Value: bool
+ */
+template <int W>
+bool BVH::OccludedWide(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	if (_nodes.empty()) {
+		return false;
+	}
+
+	std::vector<BVHWideNode<W>, ArenaAllocator<BVHWideNode<W> > > &nodes = GetWideNodes<W>();
+	Vec3<float> inverseRay = BoundingBox::InverseRay(ray);
+	float entryTimes[W];
+
+	int stack[BVH_MAX_DEPTH * (W - 1) + 1];
+	int stackSize = 0;
+	stack[stackSize++] = nodes.empty() ? ~0 : 0;
+
+	while (stackSize > 0) {
+		int child = stack[--stackSize];
+		if (child < 0) {
+			if (OccludedLeaf(~child, ray, startingPos, minTime, maxTime)) {
+				return true;
+			}
+			continue;
+		}
+
+		const BVHWideNode<W> &node = nodes[child];
+		int mask = _boxKernel.Intersect(node.bounds, startingPos, inverseRay, maxTime, entryTimes);
+		for (int lane = W - 1; lane >= 0; lane--) {
+			if (mask & (1 << lane)) {
+				stack[stackSize++] = node.children[lane];
+			}
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetNodeCount
+ * Arguments:
+ *     void
+ * Purpose: Returns the number of nodes in the hierarchy
+ * Return Value: int
+ */
+int BVH::GetNodeCount() {
+	return (int)_nodes.size();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetDepth
+ * Arguments:
+ *     void
+ * Purpose: Returns the depth of the deepest leaf
+ * Return Value: int
+ */
+int BVH::GetDepth() {
+	return _depth;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetWidth
+ * Arguments:
+ *     void
+ * Purpose: Returns the children per node of the layout the rays walk
+ * Return Value: int
+ */
+int BVH::GetWidth() {
+	return _width;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetWideNodeCount
+ * Arguments:
+ *     void
+ * Purpose: Returns the number of nodes in the wide layout, 0 for the binary one
+ * Return Value: int
+ */
+int BVH::GetWideNodeCount() {
+	return _width == 4 ? (int)_wideNodes4.size() : (_width == 8 ? (int)_wideNodes8.size() : 0);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetNodes
+ * Arguments:
+ *     void
+ * Purpose: Returns the flattened nodes of the hierarchy
+ * Return Value: const std::vector<BVHNode, ArenaAllocator<BVHNode> > &
+ */
+const std::vector<BVHNode, ArenaAllocator<BVHNode> > & BVH::GetNodes() {
+	return _nodes;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetReferences
+ * Arguments:
+ *     std::vector<Geometry *> - the geometry given to Build
+ * Purpose: Returns the leaf primitives by position so the hierarchy can be stored and restored with Load
+ * Return Value: std::vector<BVHReference>
+ */
+std::vector<BVHReference> BVH::GetReferences(std::vector<Geometry *> &geometry) {
+	std::map<Geometry *, int> positions;
+	for (size_t i = 0; i < geometry.size(); i++) {
+		positions[geometry[i]] = (int)i;
+	}
+
+	std::vector<BVHReference> references(_primitives.size());
+	for (size_t i = 0; i < _primitives.size(); i++) {
+		references[i].geometry = positions[_primitives[i].geometry];
+		references[i].primitive = _primitives[i].index;
+	}
+	return references;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetKernelLevel
+ * Arguments:
+ *     void
+ * Purpose: Returns the instruction set the leaves are intersected with
+ * Return Value: simd_level
+ */
+simd_level BVH::GetKernelLevel() {
+	return _kernel.GetLevel();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetBuildStats
+ * Arguments:
+ *     void
+ * Purpose: Returns how long the last build took and how good the tree it made is
+ * Return Value: const BVHBuildStats &
+ */
+const BVHBuildStats & BVH::GetBuildStats() {
+	return _stats;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetQualityName
+ * Arguments:
+ *     bvh_quality - the build quality
+ * Purpose: Returns the name of a build quality as it is written in the configuration
+ * Return Value: const char *
+ */
+const char * BVH::GetQualityName(bvh_quality quality) {
+	switch (quality) {
+		case BVH_QUALITY_HIGH :
+			return "HIGH";
+		case BVH_QUALITY_MEDIUM :
+			return "MEDIUM";
+		case BVH_QUALITY_FAST :
+			return "FAST";
+	}
+	return "UNKNOWN";
+}
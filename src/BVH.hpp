@@ -0,0 +1,212 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <utility>
+#include <stddef.h>
+#include <vector>
+
+#include "Arena.hpp"
+#include "BoundingBox.hpp"
+#include "BoxKernel.hpp"
+#include "Geometry.hpp"
+#include "RayHit.hpp"
+#include "SphereKernel.hpp"
+#include "ThreadPool.hpp"
+#include "TriangleKernel.hpp"
+#include "Vector.hpp"
+
+#define RAY_PACKET_SIZE 32 // Rays traced together by IntersectPacket (a 4x4 block of primary rays for each eye).  At most 32, one bit each
+#define RAY_PACKET_FRUSTA 2 // Starting positions a packet can have and still be culled by frustum (one per eye)
+#define BVH_WIDE_EMPTY INT_MIN // Child of a wide node that is not used
+#define BVH_WIDE_NODE_ALIGNMENT 64 // Wide nodes start on a cache line
+#define BVH_REFIT_LIMIT 1.5f // Refit rebuilds the tree once its SAH cost grows past this multiple of the cost it was built with
+
+// How much time Build spends looking for good splits.  HIGH tries every split of every axis, MEDIUM and FAST only
+// the boundaries between a fixed number of bins of centroids
+enum bvh_quality {
+	BVH_QUALITY_HIGH,
+	BVH_QUALITY_MEDIUM,
+	BVH_QUALITY_FAST
+};
+
+// Node of the flattened hierarchy.  Interior nodes store the index of their left child (the right child
+// always follows it), leaves store the first primitive index and the number of primitives they hold
+typedef struct {
+	BoundingBox bounds;
+	int leftFirst;
+	int count;
+} BVHNode;
+
+// A primitive of a leaf.  The index selects the primitive within the geometry, -1 when the geometry is
+// intersected as a whole
+typedef struct {
+	Geometry * geometry;
+	int index;
+} BVHPrimitive;
+
+// A leaf primitive by position, used to store the hierarchy.  The geometry is an index into the array given
+// to Build, the primitive is the index within that geometry (-1 for the whole geometry)
+typedef struct {
+	int geometry;
+	int primitive;
+} BVHReference;
+
+// A split the binned builder found.  Primitives with centroids in the bins below the split bin go left
+typedef struct {
+	int axis;
+	int bin;
+	float start;
+	float scale;
+} BVHBinSplit;
+
+// What building or loading the hierarchy took and how good the result is.  The cost is the expected cost of a ray
+// through the tree by the surface area heuristic, in leaf intersections.  Refits keep the tree but change its cost
+typedef struct {
+	double milliseconds;
+	int primitives;
+	int leaves;
+	float sahCost;
+	int threads;
+	bool fromCache;
+	int refits;
+	double refitMilliseconds;
+} BVHBuildStats;
+
+// Node of the wide hierarchy collapsed from the binary one.  The child boxes are tested against a ray together by the
+// BoxKernel.  A child that is not negative is another wide node, a negative child is the complement of the binary
+// leaf it stands for.  Padded to 128 bytes with four children and 256 bytes with eight
+template <int W>
+struct alignas(BVH_WIDE_NODE_ALIGNMENT) BVHWideNode {
+	boxPacket<W> bounds;
+	int children[W];
+};
+
+// The packed form of a leaf.  Its triangles and spheres are tested a packet at a time by the kernels, the rest of
+// its primitives one by one
+typedef struct {
+	int firstPacket;
+	int packetCount;
+	int firstSpherePacket;
+	int spherePacketCount;
+	int firstPrimitive;
+	int primitiveCount;
+} BVHLeaf;
+
+// Coherent rays traced together through the hierarchy.  Every ray keeps its own starting position, but the frustum
+// culling only applies to packets with at most RAY_PACKET_FRUSTA of them
+typedef struct {
+	Vec3<float> rays[RAY_PACKET_SIZE];
+	Vec3<float> startingPos[RAY_PACKET_SIZE];
+	int count;
+} rayPacket;
+
+// The four side planes through a shared starting position that contain all of the rays starting there
+typedef struct {
+	Vec3<float> apex;
+	Vec3<float> normals[4];
+} rayFrustum;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: BVH
+ * Purpose: A bounding volume hierarchy over the scene geometry built with the surface area heuristic.  The nodes,
+ *          the leaf packets and the wide nodes are kept in the arena of the scene, the work arrays of a build or a
+ *          refit on the heap
+ */
+class BVH {
+
+	public :
+		BVH(Arena * arena = NULL);
+		void SetArena(Arena * arena);
+		void SetWidth(int width);
+		void Build(std::vector<Geometry *> &geometry, ThreadPool * pool = NULL, bvh_quality quality = BVH_QUALITY_HIGH);
+		void Load(std::vector<Geometry *> &geometry, const BVHNode * nodes, int nodeCount, const BVHReference * references, int referenceCount, int depth);
+		static bool Validate(const BVHNode * nodes, int nodeCount, int referenceCount, int depth);
+		bool Refit(std::vector<Geometry *> &geometry, const std::vector<Geometry *> &changed, ThreadPool * pool = NULL);
+		void SetRefitLimit(float limit);
+		bool Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		void IntersectPacket(rayPacket &packet, RayHit * rayHits, bool * hits);
+		bool Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		int GetNodeCount();
+		int GetDepth();
+		int GetWidth();
+		int GetWideNodeCount();
+		const std::vector<BVHNode, ArenaAllocator<BVHNode> > & GetNodes();
+		std::vector<BVHReference> GetReferences(std::vector<Geometry *> &geometry);
+		simd_level GetKernelLevel();
+		const BVHBuildStats & GetBuildStats();
+		static const char * GetQualityName(bvh_quality quality);
+
+	private :
+		void Subdivide(int nodeIndex, int first, int count, int depth);
+		float FindBestSplit(int first, int count, int &axis, int &split);
+		float FindBinnedSplit(int first, int count, BVHBinSplit &binSplit, int &split);
+		void PartitionByBin(int first, int count, const BVHBinSplit &binSplit);
+		void SortByCentroid(int first, int count, int axis);
+		void Flatten(const std::vector<BVHNode> &built, int builtIndex, int nodeIndex, int depth);
+		void BuildPackets();
+		void PackLeaf(int nodeIndex);
+		void MeasureTree();
+		float NodeCost(int nodeIndex);
+		void PrepareRefit();
+		void RefitNode(int nodeIndex);
+		static int BuildFrusta(rayPacket &packet, rayFrustum * frusta);
+		static bool BuildFrustum(rayPacket &packet, rayFrustum &frustum);
+		static bool FrustumMisses(const rayFrustum &frustum, const BoundingBox &bounds);
+		bool IntersectLeaf(int nodeIndex, Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		bool OccludedLeaf(int nodeIndex, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		void BuildWide();
+		template <int W> int Collapse(int nodeIndex);
+		template <int W> bool IntersectWide(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		template <int W> void IntersectPacketWide(rayPacket &packet, RayHit * rayHits, bool * hits);
+		template <int W> bool OccludedWide(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		template <int W> std::vector<BVHWideNode<W>, ArenaAllocator<BVHWideNode<W> > > & GetWideNodes();
+
+		std::vector<BVHNode, ArenaAllocator<BVHNode> > _nodes;
+		std::vector<BVHPrimitive, ArenaAllocator<BVHPrimitive> > _primitives;
+		std::vector<BoundingBox> _primitiveBounds;
+		std::vector<Vec3<float> > _centroids;
+		std::vector<int> _order;
+		std::vector<float> _rightArea;
+		std::vector<int> _rightTriangles;
+		std::vector<int> _rightSpheres;
+		std::vector<int> _triangleCounts;
+		std::vector<char> _isSphere;
+		std::atomic<int> _nodeCount;
+		ThreadPool * _buildPool;
+		TaskGroup * _buildGroup;
+		int _binCount;
+		int _depth;
+		bvh_quality _quality;
+		BVHBuildStats _stats;
+
+		// Built on the first refit after a build or load.  The parent of every node, the leaf of every primitive and
+		// the primitives of every geometry sorted by geometry, so a refit only visits what moved and its ancestors
+		std::vector<int> _parents;
+		std::vector<int> _primitiveLeaves;
+		std::vector<std::pair<Geometry *, int> > _geometryPrimitives;
+		std::vector<char> _refitMarks;
+		std::vector<int> _refitNodes;
+		float _refitLimit;
+		float _builtSahCost;
+		double _sahArea; // Sum of surface area times cost over all nodes, kept up to date by refits
+		double _costSum;
+
+		std::vector<BVHLeaf, ArenaAllocator<BVHLeaf> > _leaves;
+		std::vector<trianglePacket, ArenaAllocator<trianglePacket> > _packets;
+		std::vector<Geometry *, ArenaAllocator<Geometry *> > _packetGeometry;
+		std::vector<spherePacket, ArenaAllocator<spherePacket> > _spherePackets;
+		std::vector<Geometry *, ArenaAllocator<Geometry *> > _spherePacketGeometry;
+		std::vector<BVHPrimitive, ArenaAllocator<BVHPrimitive> > _leafPrimitives;
+		TriangleKernel _kernel;
+		SphereKernel _sphereKernel;
+
+		// The wide layout is made from the binary one after every build or load when the width is four or eight
+		int _width;
+		std::vector<BVHWideNode<4>, ArenaAllocator<BVHWideNode<4> > > _wideNodes4;
+		std::vector<BVHWideNode<8>, ArenaAllocator<BVHWideNode<8> > > _wideNodes8;
+		std::vector<int, ArenaAllocator<int> > _wideSlots; // Wide node times width plus lane of every binary node that is a wide child, -1 otherwise
+		BoxKernel _boxKernel;
+};
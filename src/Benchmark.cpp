@@ -0,0 +1,597 @@
+/* STB Image write is only built here, as the reference for the png encoder */
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+
+/* Standard libs */
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* Project headers */
+#include "BVH.hpp"
+#include "Config.hpp"
+#include "Perspective.hpp"
+#include "PngEncoder.hpp"
+#include "PrimaryRays.hpp"
+#include "RayHit.hpp"
+#include "Sphere.hpp"
+#include "SphereKernel.hpp"
+#include "Triangle.hpp"
+#include "TriangleKernel.hpp"
+#include "Vector.hpp"
+
+/* External headers */
+#include "stb_image_write.h"
+
+using namespace std;
+
+/*
+ * Date: 10/17/26
+ * Function Name: RandomFloat
+ * Arguments:
+ *     float - the lowest value
+ *     float - the highest value
+ * Purpose: Returns a random float between the two values
+ * Return Value: float
+ */
+static float RandomFloat(float low, float high) {
+    return low + (high - low) * ((float)rand() / (float)RAND_MAX);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: RandomPoint
+ * Arguments:
+ *     float - the half size of the cube centered on the origin
+ * Purpose: Returns a random point in a cube
+ * Return Value: Vec3<float>
+ */
+static Vec3<float> RandomPoint(float size) {
+    return Vec3<float>::vec3(RandomFloat(-size, size), RandomFloat(-size, size), RandomFloat(-size, size));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Report
+ * Arguments:
+ *     const char * - the name of the kernel
+ *     const char * - what was tested (triangle or sphere)
+ *     double       - the seconds taken
+ *     double       - the number of ray primitive tests
+ *     int          - the number of rays that hit a primitive
+ *     int          - the number of rays whose closest hit differs from the scalar code
+ * Purpose: Prints one line of the results
+ * Return Value: void
+ */
+static void Report(const char * name, const char * primitive, double seconds, double tests, int hits, int mismatches) {
+    cout << name << ": " << tests / seconds / 1000000.0 << " million " << primitive << " tests per second (" << seconds * 1000.0
+         << " ms, " << hits << " hits, " << mismatches << " mismatches)" << endl;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BenchmarkTriangles
+ * Arguments:
+ *     int                         - the number of triangles
+ *     vector<Vec3<float> > &      - the rays
+ *     vector<Vec3<float> > &      - the starting position of every ray
+ * Purpose: Measures Triangle::Intersect and every supported triangle kernel on the same random triangles
+ * Return Value: void
+ */
+static void BenchmarkTriangles(int triangleCount, vector<Vec3<float> > &rays, vector<Vec3<float> > &origins) {
+    int rayCount = (int)rays.size();
+
+    // Small triangles scattered through a box in front of the rays, so most tests miss like they do in a BVH leaf
+    vector<Triangle> triangles;
+    vector<trianglePacket> packets((triangleCount + TRIANGLE_PACKET_WIDTH - 1) / TRIANGLE_PACKET_WIDTH, trianglePacket());
+    for(int i = 0; i < triangleCount; i++) {
+        Vec3<float> a = RandomPoint(10.f) + Vec3<float>::vec3(0, 0, 20.f);
+        Vec3<float> b = a + RandomPoint(1.f);
+        Vec3<float> c = a + RandomPoint(1.f);
+        triangles.push_back(Triangle(a, b, c));
+        TriangleKernel::SetTriangle(packets[i / TRIANGLE_PACKET_WIDTH], i % TRIANGLE_PACKET_WIDTH, a, b, c);
+    }
+
+    double tests = (double)triangleCount * (double)rayCount;
+    cout << triangleCount << " triangles, " << rayCount << " rays" << endl;
+
+    // Triangle::Intersect one triangle at a time is the reference
+    vector<float> closest(rayCount);
+    int hits = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int i = 0; i < rayCount; i++) {
+        RayHit rayHit;
+        for(int j = 0; j < triangleCount; j++) {
+            triangles[j].Intersect(rays[i], origins[i], rayHit);
+        }
+        closest[i] = rayHit.GetTime();
+        hits += rayHit.HasHit() ? 1 : 0;
+    }
+    Report("Triangle::Intersect", "triangle", chrono::duration<double>(chrono::steady_clock::now() - start).count(), tests, hits, 0);
+
+    simd_level best = Simd::GetBestLevel();
+    for(int level = SIMD_SCALAR; level <= best; level++) {
+        TriangleKernel kernel((simd_level)level);
+        hits = 0;
+        int mismatches = 0;
+
+        start = chrono::steady_clock::now();
+        for(int i = 0; i < rayCount; i++) {
+            float time = FLT_MAX;
+            for(size_t j = 0; j < packets.size(); j++) {
+                kernel.ClosestHit(packets[j], rays[i], origins[i], time, time);
+            }
+            hits += time < FLT_MAX ? 1 : 0;
+            mismatches += time != closest[i] ? 1 : 0;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        string name = string(Simd::GetLevelName((simd_level)level)) + " triangle kernel";
+        Report(name.c_str(), "triangle", seconds, tests, hits, mismatches);
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BenchmarkSpheres
+ * Arguments:
+ *     int                         - the number of spheres
+ *     vector<Vec3<float> > &      - the rays
+ *     vector<Vec3<float> > &      - the starting position of every ray
+ * Purpose: Measures Sphere::Intersect and every supported sphere kernel on the same random spheres
+ * Return Value: void
+ */
+static void BenchmarkSpheres(int sphereCount, vector<Vec3<float> > &rays, vector<Vec3<float> > &origins) {
+    int rayCount = (int)rays.size();
+
+    // Small spheres like the particles of a particle scene
+    vector<Sphere> spheres;
+    vector<spherePacket> packets((sphereCount + SPHERE_PACKET_WIDTH - 1) / SPHERE_PACKET_WIDTH);
+    for(size_t i = 0; i < packets.size(); i++) {
+        SphereKernel::ClearPacket(packets[i]);
+    }
+    for(int i = 0; i < sphereCount; i++) {
+        Vec3<float> center = RandomPoint(10.f) + Vec3<float>::vec3(0, 0, 20.f);
+        float radius = RandomFloat(.05f, .5f);
+        spheres.push_back(Sphere(center, radius));
+        SphereKernel::SetSphere(packets[i / SPHERE_PACKET_WIDTH], i % SPHERE_PACKET_WIDTH, center, radius);
+    }
+
+    double tests = (double)sphereCount * (double)rayCount;
+    cout << sphereCount << " spheres, " << rayCount << " rays" << endl;
+
+    // Sphere::Intersect one sphere at a time is the reference
+    vector<float> closest(rayCount);
+    int hits = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int i = 0; i < rayCount; i++) {
+        RayHit rayHit;
+        for(int j = 0; j < sphereCount; j++) {
+            spheres[j].Intersect(rays[i], origins[i], rayHit);
+        }
+        closest[i] = rayHit.GetTime();
+        hits += rayHit.HasHit() ? 1 : 0;
+    }
+    Report("Sphere::Intersect", "sphere", chrono::duration<double>(chrono::steady_clock::now() - start).count(), tests, hits, 0);
+
+    simd_level best = Simd::GetBestLevel();
+    for(int level = SIMD_SCALAR; level <= best; level++) {
+        SphereKernel kernel((simd_level)level);
+        hits = 0;
+        int mismatches = 0;
+
+        start = chrono::steady_clock::now();
+        for(int i = 0; i < rayCount; i++) {
+            float time = FLT_MAX;
+            for(size_t j = 0; j < packets.size(); j++) {
+                kernel.ClosestHit(packets[j], rays[i], origins[i], time, time);
+            }
+            hits += time < FLT_MAX ? 1 : 0;
+            mismatches += time != closest[i] ? 1 : 0;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        string name = string(Simd::GetLevelName((simd_level)level)) + " sphere kernel";
+        Report(name.c_str(), "sphere", seconds, tests, hits, mismatches);
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BenchmarkTraversal
+ * Arguments:
+ *     int                         - the number of triangles
+ *     vector<Vec3<float> > &      - the rays
+ *     vector<Vec3<float> > &      - the starting position of every ray
+ * Purpose: Measures the closest hit and shadow rays per second of the binary BVH layout and of the four and eight
+ *          wide layouts over the same random triangles
+ * Return Value: void
+ */
+static void BenchmarkTraversal(int triangleCount, vector<Vec3<float> > &rays, vector<Vec3<float> > &origins) {
+    int rayCount = (int)rays.size();
+    int passes = 16;
+
+    vector<Triangle> triangles;
+    for(int i = 0; i < triangleCount; i++) {
+        Vec3<float> a = RandomPoint(10.f) + Vec3<float>::vec3(0, 0, 20.f);
+        triangles.push_back(Triangle(a, a + RandomPoint(.5f), a + RandomPoint(.5f)));
+    }
+    vector<Geometry *> geometry;
+    for(int i = 0; i < triangleCount; i++) {
+        geometry.push_back(&triangles[i]);
+    }
+
+    BVH bvh;
+    bvh.Build(geometry);
+    cout << triangleCount << " triangles in a BVH, " << rayCount << " rays" << endl;
+
+    // The binary layout is the reference
+    vector<float> closest(rayCount);
+    for(int width = 2; width <= 8; width *= 2) {
+        bvh.SetWidth(width);
+        int hits = 0, mismatches = 0, occluded = 0;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for(int pass = 0; pass < passes; pass++) {
+            for(int i = 0; i < rayCount; i++) {
+                RayHit rayHit;
+                bvh.Intersect(rays[i], origins[i], rayHit);
+                if(pass == 0) {
+                    if(width == 2) {
+                        closest[i] = rayHit.GetTime();
+                    }
+                    hits += rayHit.HasHit() ? 1 : 0;
+                    mismatches += rayHit.GetTime() != closest[i] ? 1 : 0;
+                }
+            }
+        }
+        double closestSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for(int pass = 0; pass < passes; pass++) {
+            for(int i = 0; i < rayCount; i++) {
+                occluded += bvh.Occluded(rays[i], origins[i], 0, 30.f) ? 1 : 0;
+            }
+        }
+        double shadowSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        string name = width == 2 ? string("Binary BVH") : to_string(width) + " wide BVH";
+        cout << name << ": " << passes * rayCount / closestSeconds / 1000000.0 << " million closest hit rays per second, "
+             << passes * rayCount / shadowSeconds / 1000000.0 << " million shadow rays per second (" << hits << " hits, "
+             << occluded / passes << " occluded, " << mismatches << " mismatches)" << endl;
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BenchmarkRefit
+ * Arguments:
+ *     int                         - the number of triangles
+ *     vector<Vec3<float> > &      - the rays
+ *     vector<Vec3<float> > &      - the starting position of every ray
+ * Purpose: Moves a few triangles a frame and compares refitting the BVH with building it again.  The refit tree
+ *          must find the same closest hits as a tree built over the moved triangles
+ * Return Value: void
+ */
+static void BenchmarkRefit(int triangleCount, vector<Vec3<float> > &rays, vector<Vec3<float> > &origins) {
+    int rayCount = (int)rays.size();
+    int frames = 16;
+    int movedCount = triangleCount / 100;
+
+    vector<Triangle> triangles;
+    for(int i = 0; i < triangleCount; i++) {
+        Vec3<float> a = RandomPoint(10.f) + Vec3<float>::vec3(0, 0, 20.f);
+        triangles.push_back(Triangle(a, a + RandomPoint(.5f), a + RandomPoint(.5f)));
+    }
+    vector<Geometry *> geometry;
+    for(int i = 0; i < triangleCount; i++) {
+        geometry.push_back(&triangles[i]);
+    }
+
+    BVH bvh;
+    bvh.SetWidth(4);
+    bvh.Build(geometry);
+
+    double refitSeconds = 0, buildSeconds = 0;
+    int rebuilds = 0, mismatches = 0;
+    for(int frame = 0; frame < frames; frame++) {
+        vector<Geometry *> moved;
+        for(int i = 0; i < movedCount; i++) {
+            Geometry * triangle = geometry[rand() % triangleCount];
+            triangle->Translate(RandomPoint(.5f));
+            moved.push_back(triangle);
+        }
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        rebuilds += bvh.Refit(geometry, moved) ? 1 : 0;
+        refitSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        BVH built;
+        built.SetWidth(4);
+        start = chrono::steady_clock::now();
+        built.Build(geometry);
+        buildSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        for(int i = 0; i < rayCount; i++) {
+            RayHit refitHit, builtHit;
+            bvh.Intersect(rays[i], origins[i], refitHit);
+            built.Intersect(rays[i], origins[i], builtHit);
+            mismatches += refitHit.GetTime() != builtHit.GetTime() ? 1 : 0;
+        }
+    }
+
+    cout << "Moving " << movedCount << " of " << triangleCount << " triangles a frame: refit " << refitSeconds * 1000.0 / frames
+         << " ms, build " << buildSeconds * 1000.0 / frames << " ms per frame (" << rebuilds << " rebuilds, SAH cost "
+         << bvh.GetBuildStats().sahCost << ", " << mismatches << " mismatches)" << endl;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BenchmarkPng
+ * Arguments:
+ *     int - the width of the image in pixels
+ *     int - the height of the image in pixels
+ * Purpose: Measures how fast stb_image_write and the png encoder (on one thread and on every thread) compress a
+ *          rendered looking image, shaded circles over a gradient, and how large the files are
+ * Return Value: void
+ */
+static void BenchmarkPng(int width, int height) {
+    vector<unsigned char> pixels((size_t)width * height * 3);
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            unsigned char * pixel = &pixels[((size_t)y * width + x) * 3];
+            pixel[0] = (unsigned char)(40 + 60 * y / height);
+            pixel[1] = (unsigned char)(40 + 60 * x / width);
+            pixel[2] = 90;
+        }
+    }
+    for(int circle = 0; circle < 64; circle++) {
+        int centerX = rand() % width, centerY = rand() % height, radius = 20 + rand() % (height / 8);
+        unsigned char red = rand() % 256, green = rand() % 256, blue = rand() % 256;
+        for(int y = max(0, centerY - radius); y < min(height, centerY + radius); y++) {
+            for(int x = max(0, centerX - radius); x < min(width, centerX + radius); x++) {
+                float distance = (float)((x - centerX) * (x - centerX) + (y - centerY) * (y - centerY)) / (radius * radius);
+                if(distance < 1.f) {
+                    unsigned char * pixel = &pixels[((size_t)y * width + x) * 3];
+                    pixel[0] = (unsigned char)(red * (1.f - .6f * distance));
+                    pixel[1] = (unsigned char)(green * (1.f - .6f * distance));
+                    pixel[2] = (unsigned char)(blue * (1.f - .6f * distance));
+                }
+            }
+        }
+    }
+    double megabytes = pixels.size() / 1000000.0;
+    
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int length = 0;
+    unsigned char * png = stbi_write_png_to_mem(pixels.data(), width * 3, width, height, 3, &length);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    free(png);
+    cout << "stb_image_write " << width << "x" << height << ": " << megabytes / seconds << " MB per second (" << seconds * 1000.0 << " ms, " << length << " bytes)" << endl;
+    
+    ThreadPool pool;
+    int levels[4] = { 0, 1, PNG_DEFAULT_LEVEL, PNG_MAX_LEVEL };
+    for(int i = 0; i < 4; i++) {
+        for(int threaded = 0; threaded < 2; threaded++) {
+            PngEncoder encoder(threaded ? &pool : NULL, levels[i]);
+            vector<unsigned char> encoded;
+            start = chrono::steady_clock::now();
+            encoder.Encode(pixels.data(), width, height, encoded);
+            seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            cout << "PngEncoder level " << levels[i] << " on " << (threaded ? pool.GetThreadCount() : 1) << " threads: " << megabytes / seconds << " MB per second ("
+                 << seconds * 1000.0 << " ms, " << encoded.size() << " bytes)" << endl;
+        }
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GeneratePerPixel
+ * Arguments:
+ *     Config &      - the configuration of the scene
+ *     Perspective & - the camera and image plane(s) of the scene
+ *     int           - the number of eyes traced together
+ *     int           - the first row of the block
+ *     int           - the row after the last row of the block
+ *     int           - the first column of the block
+ *     int           - the column after the last column of the block
+ *     rayPacket &   - filled with the rays in the same order as PrimaryRays::Generate
+ * Purpose: Generates the primary rays of a block the way the renderer did before the pixel loop was specialized.  The
+ *          anaglyph mode, the eye and anti-aliasing are looked up and the camera of the second eye rebuilt for every ray
+ * Return Value: void
+ */
+static void GeneratePerPixel(Config &config, Perspective &perspective, int eyes, int startRow, int endRow, int startColumn, int endColumn, rayPacket &packet) {
+    packet.count = 0;
+    for(int i = startRow; i < endRow; i++) {
+        for(int j = startColumn; j < endColumn; j++) {
+            for(int sample = 0; sample < (config.IsAntialiased() ? 4 : 1); sample++) {
+                for(int eye = 0; eye < eyes; eye++) {
+                    bool isSecondary = eye == 1;
+                    
+                    float heightOffset;
+                    if(perspective.GetAnaglyphMode() == ANAGLYPH_PARALLEL || !config.IsAnaglyph()) {
+                        heightOffset = perspective.GetImagePlane()->GetCorner().y - (perspective.GetUnitsPerHeightPixel() * (float)i);
+                    }
+                    else if(isSecondary && perspective.GetAnaglyphMode() == ANAGLYPH_CONVERGE) {
+                        heightOffset = perspective.GetSecondaryImagePlane()->GetCorner().y - (perspective.GetUnitsPerHeightPixel() * (float)i);
+                    }
+                    else {
+                        heightOffset = perspective.GetImagePlane()->GetCorner().y - (perspective.GetUnitsPerHeightPixel() * (float)i);
+                    }
+                    
+                    Vec3<float> trueOffset;
+                    if(perspective.GetAnaglyphMode() == ANAGLYPH_PARALLEL && isSecondary) {
+                        trueOffset = Vec3<float>::vec3(perspective.GetSecondaryImagePlane()->GetCorner().x + (perspective.GetUnitsPerLengthPixel() * (float)j), heightOffset, perspective.GetSecondaryImagePlane()->GetCorner().z);
+                    } else {
+                        trueOffset = Vec3<float>::vec3(perspective.GetImagePlane()->GetCorner().x + (perspective.GetUnitsPerLengthPixel() * (float)j), heightOffset, perspective.GetImagePlane()->GetCorner().z);
+                    }
+                    
+                    if(config.IsAntialiased()) {
+                        int k = sample / 2, l = sample % 2;
+                        trueOffset = Vec3<float>::vec3(trueOffset.x + (perspective.GetUnitsPerLengthPixel() * (float)l), trueOffset.y - (perspective.GetUnitsPerHeightPixel() * ((float)k+1.f)), trueOffset.z);
+                    }
+                    
+                    if(isSecondary) {
+                        packet.rays[packet.count] = Vec3<float>::Normalize(trueOffset - Vec3<float>::vec3((perspective.GetCameraPosition().x - perspective.GetIntereyeDistance()), perspective.GetCameraPosition().y, perspective.GetCameraPosition().z));
+                        packet.startingPos[packet.count++] = Vec3<float>::vec3((perspective.GetCameraPosition().x - perspective.GetIntereyeDistance()), perspective.GetCameraPosition().y, perspective.GetCameraPosition().z);
+                    } else {
+                        packet.rays[packet.count] = Vec3<float>::Normalize(trueOffset - perspective.GetCameraPosition());
+                        packet.startingPos[packet.count++] = perspective.GetCameraPosition();
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GenerateImage
+ * Arguments:
+ *     Config &          - the configuration of the scene
+ *     Perspective &     - the camera and image plane(s) of the scene
+ *     PrimaryRays *     - the specialized generator, NULL for the per pixel reference
+ *     int               - the number of eyes traced together
+ *     vector<float> *   - filled with the x component of every ray when not NULL
+ * Purpose: Generates every primary ray of the image a block at a time, like the render threads do
+ * Return Value: float - the sum of the ray components, so the work can not be optimized away
+ */
+static float GenerateImage(Config &config, Perspective &perspective, PrimaryRays * primaryRays, int eyes, vector<float> * components) {
+    int blockSize = config.IsAntialiased() ? 2 : 4;
+    float sum = 0;
+    rayPacket packet;
+    
+    for(int row = 0; row < config.GetPixelHeight(); row += blockSize) {
+        for(int column = 0; column < config.GetPixelLength(); column += blockSize) {
+            int endRow = min(row + blockSize, config.GetPixelHeight());
+            int endColumn = min(column + blockSize, config.GetPixelLength());
+            
+            if(!primaryRays) {
+                GeneratePerPixel(config, perspective, eyes, row, endRow, column, endColumn, packet);
+            } else if(config.IsAntialiased()) {
+                eyes == 2 ? PrimaryRays::Generate<true, 2>(primaryRays->GetViews(false), row, endRow, column, endColumn, packet)
+                          : PrimaryRays::Generate<true, 1>(primaryRays->GetViews(false), row, endRow, column, endColumn, packet);
+            } else {
+                eyes == 2 ? PrimaryRays::Generate<false, 2>(primaryRays->GetViews(false), row, endRow, column, endColumn, packet)
+                          : PrimaryRays::Generate<false, 1>(primaryRays->GetViews(false), row, endRow, column, endColumn, packet);
+            }
+            
+            for(int i = 0; i < packet.count; i++) {
+                sum += packet.rays[i].x + packet.rays[i].y + packet.startingPos[i].x;
+                if(components) {
+                    components->push_back(packet.rays[i].x);
+                    components->push_back(packet.rays[i].y);
+                    components->push_back(packet.rays[i].z);
+                    components->push_back(packet.startingPos[i].x);
+                }
+            }
+        }
+    }
+    return sum;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BenchmarkPrimaryRays
+ * Arguments:
+ *     bool         - true to anti-alias
+ *     const char * - the anaglyph mode (PARALLEL or CONVERGE), NULL for a single image
+ * Purpose: Measures the primary rays per second of the per pixel ray generation the renderer used to do and of the
+ *          specialized pixel loop, and checks that both generate the same rays
+ * Return Value: void
+ */
+static void BenchmarkPrimaryRays(bool antialiased, const char * anaglyphMode) {
+    char scene[1024];
+    snprintf(scene, sizeof(scene),
+             "<configuration><anti_aliasing>%s</anti_aliasing><anaglyph>%s</anaglyph><image_length>1024</image_length><image_height>1024</image_height></configuration>"
+             "<image_plane><camera><location x=\"0\" y=\"-0.25\" z=\"0\"/></camera><corner x=\"-1\" y=\"1\" z=\"2\"/><length>2</length><height>2</height>"
+             "<anaglyph><mode>%s</mode><intereye_distance>.06</intereye_distance></anaglyph></image_plane>",
+             antialiased ? "true" : "false", anaglyphMode ? "true" : "false", anaglyphMode ? anaglyphMode : "PARALLEL");
+    
+    tinyxml2::XMLDocument doc;
+    doc.Parse(scene);
+    Config config;
+    config.Load(doc);
+    Perspective perspective;
+    perspective.Load(config, doc);
+    PrimaryRays primaryRays;
+    primaryRays.Setup(config, perspective);
+    int eyes = anaglyphMode ? 2 : 1;
+    
+    // Both have to produce exactly the same rays
+    vector<float> reference, specialized;
+    GenerateImage(config, perspective, NULL, eyes, &reference);
+    GenerateImage(config, perspective, &primaryRays, eyes, &specialized);
+    int mismatches = 0;
+    for(size_t i = 0; i < reference.size() && i < specialized.size(); i += 4) {
+        mismatches += (reference[i] != specialized[i] || reference[i + 1] != specialized[i + 1] || reference[i + 2] != specialized[i + 2] || reference[i + 3] != specialized[i + 3]) ? 1 : 0;
+    }
+    double rays = (double)reference.size() / 4.0;
+    
+    string name = string(antialiased ? "anti-aliased " : "") + (anaglyphMode ? string("stereo ") + anaglyphMode : string("single image"));
+    cout << name << ", " << (long)rays << " rays" << endl;
+    
+    float sum = 0;
+    for(int generator = 0; generator < 2; generator++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for(int pass = 0; pass < 10; pass++) {
+            sum += GenerateImage(config, perspective, generator == 0 ? NULL : &primaryRays, eyes, NULL);
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        
+        cout << (generator == 0 ? "Per pixel" : "Specialized") << ": " << 10.0 * rays / seconds / 1000000.0 << " million primary rays per second ("
+             << seconds * 100.0 << " ms per image, " << (generator == 0 ? 0 : mismatches) << " mismatches)" << endl;
+    }
+    
+    if(sum == 0) {
+        cout << endl;
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: main
+ * Arguments:
+ *     int    - the number of command line arguments
+ *     char** - the optional number of primitives and rays
+ * Purpose: Measures how many ray triangle and ray sphere tests per second the scalar geometry code and every
+ *          kernel the processor supports can do on the same random primitives and rays, how fast rays walk every
+ *          BVH layout, how fast the primary rays are generated in every mode and how fast images are encoded
+ * Return Value: int
+ */
+int main(int argc, char ** argv) {
+
+    int primitiveCount = argc > 1 ? atoi(argv[1]) : 4096;
+    int rayCount = argc > 2 ? atoi(argv[2]) : 4096;
+
+    if(argc > 3 || primitiveCount <= 0 || rayCount <= 0) {
+        cout << "Usage: " << argv[0] << " [primitives] [rays]" << endl;
+        return 1;
+    }
+
+    // Rays from around the origin into the box holding the primitives
+    srand(1);
+    vector<Vec3<float> > rays, origins;
+    for(int i = 0; i < rayCount; i++) {
+        origins.push_back(RandomPoint(.5f));
+        rays.push_back(Vec3<float>::Normalize(RandomPoint(.5f) + Vec3<float>::vec3(0, 0, 1.f)));
+    }
+
+    BenchmarkTriangles(primitiveCount, rays, origins);
+    BenchmarkSpheres(primitiveCount, rays, origins);
+    BenchmarkTraversal(primitiveCount * 16, rays, origins);
+    BenchmarkRefit(primitiveCount * 16, rays, origins);
+    BenchmarkPng(3840, 2160);
+    
+    for(int antialiased = 0; antialiased < 2; antialiased++) {
+        BenchmarkPrimaryRays(antialiased == 1, NULL);
+        BenchmarkPrimaryRays(antialiased == 1, "PARALLEL");
+        BenchmarkPrimaryRays(antialiased == 1, "CONVERGE");
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cfloat>
+
+#include "Vector.hpp"
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: BoundingBox
+ * Purpose: An axis aligned bounding box used by the acceleration structures
+ */
+class BoundingBox {
+
+	public :
+		Vec3<float> lower;
+		Vec3<float> upper;
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: BoundingBox (constructor)
+		 * Arguments:
+		 *     void
+		 * Purpose: Constructor.  Creates an empty (inverted) box that any Expand call will overwrite
+		 * Return Value: void
+		 */
+		BoundingBox() : lower(FLT_MAX, FLT_MAX, FLT_MAX), upper(-FLT_MAX, -FLT_MAX, -FLT_MAX) {
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: BoundingBox (constructor)
+		 * Arguments:
+		 *     Vec3<float> - the minimum corner of the box
+		 *     Vec3<float> - the maximum corner of the box
+		 * Purpose: Constructor
+		 * Return Value: void
+		 */
+		BoundingBox(Vec3<float> a, Vec3<float> b) : lower(a), upper(b) {
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Expand
+		 * Arguments:
+		 *     Vec3<float> - the point to grow the box around
+		 * Purpose: Grows the box so that it contains the point
+		 * Return Value: void
+		 */
+		void Expand(const Vec3<float> &point) {
+			lower.SetValues(fminf(lower.x, point.x), fminf(lower.y, point.y), fminf(lower.z, point.z));
+			upper.SetValues(fmaxf(upper.x, point.x), fmaxf(upper.y, point.y), fmaxf(upper.z, point.z));
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Expand
+		 * Arguments:
+		 *     BoundingBox - the box to grow the box around
+		 * Purpose: Grows the box so that it contains the other box
+		 * Return Value: void
+		 */
+		void Expand(const BoundingBox &box) {
+			Expand(box.lower);
+			Expand(box.upper);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: IsEmpty
+		 * Arguments:
+		 *     void
+		 * Purpose: Returns true if nothing has been added to the box
+		 * Return Value: bool
+		 */
+		bool IsEmpty() const {
+			return lower.x > upper.x || lower.y > upper.y || lower.z > upper.z;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetCenter
+		 * Arguments:
+		 *     void
+		 * Purpose: Returns the center point of the box
+		 * Return Value: Vec3<float>
+		 */
+		Vec3<float> GetCenter() const {
+			return Vec3<float>::vec3((lower.x + upper.x) * 0.5f, (lower.y + upper.y) * 0.5f, (lower.z + upper.z) * 0.5f);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: SurfaceArea
+		 * Arguments:
+		 *     void
+		 * Purpose: Returns the surface area of the box (used by the surface area heuristic)
+		 * Return Value: float
+		 */
+		float SurfaceArea() const {
+			if (IsEmpty()) {
+				return 0;
+			}
+			float dx = upper.x - lower.x;
+			float dy = upper.y - lower.y;
+			float dz = upper.z - lower.z;
+			return 2.f * (dx * dy + dy * dz + dz * dx);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Intersect
+		 * Arguments:
+		 *     Vec3<float> - the starting position of the ray
+		 *     Vec3<float> - the reciprocal of each ray component
+		 *     float       - the farthest time along the ray that is still of interest
+		 *     float &     - set to the entry time of the ray into the box
+		 * Purpose: Slab test between the ray and the box
+		 * Return Value: bool
+		 */
+		bool Intersect(const Vec3<float> &startingPos, const Vec3<float> &inverseRay, float maxTime, float &entryTime) const {
+			float tx0 = (lower.x - startingPos.x) * inverseRay.x;
+			float tx1 = (upper.x - startingPos.x) * inverseRay.x;
+			float ty0 = (lower.y - startingPos.y) * inverseRay.y;
+			float ty1 = (upper.y - startingPos.y) * inverseRay.y;
+			float tz0 = (lower.z - startingPos.z) * inverseRay.z;
+			float tz1 = (upper.z - startingPos.z) * inverseRay.z;
+
+			float tNear = Max(Max(Min(tx0, tx1), Min(ty0, ty1)), Min(tz0, tz1));
+			float tFar = Min(Min(Max(tx0, tx1), Max(ty0, ty1)), Max(tz0, tz1));
+
+			entryTime = tNear;
+			return tNear <= tFar && tFar >= 0 && tNear <= maxTime;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: InverseRay
+		 * Arguments:
+		 *     Vec3<float> - the ray
+		 * Purpose: Returns the reciprocal of each ray component for the slab test.  Zero components are nudged
+		 *          so a ray starting on a face of a flat box does not produce 0 * inf
+		 * Return Value: Vec3<float>
+		 */
+		static Vec3<float> InverseRay(const Vec3<float> &ray) {
+			return Vec3<float>::vec3(1.f / NonZero(ray.x), 1.f / NonZero(ray.y), 1.f / NonZero(ray.z));
+		}
+
+	private :
+
+		static inline float Min(float a, float b) {
+			return a < b ? a : b;
+		}
+
+		static inline float Max(float a, float b) {
+			return a > b ? a : b;
+		}
+
+		static inline float NonZero(float a) {
+			return (a < 1e-20f && a > -1e-20f) ? (a < 0 ? -1e-20f : 1e-20f) : a;
+		}
+};
@@ -0,0 +1,165 @@
+#include "BoxKernel.hpp"
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Every kernel evaluates the same expressions in the same order as BoundingBox::Intersect.  The SSE and AVX min and
+// max return their second operand when a comparison fails, just like BoundingBox::Min and BoundingBox::Max, so the
+// hits and entry times are identical no matter which one runs
+
+/*
+ * Date: 10/17/26
+ * Function Name: IntersectScalar
+ * Arguments:
+ *     const boxPacket<W> & - the boxes
+ *     const Vec3<float> &  - the starting position of the ray
+ *     const Vec3<float> &  - the reciprocal of each ray component
+ *     float                - the farthest time along the ray that is still of interest
+ *     float *              - set to the entry time of the ray into every box
+ * Purpose: Intersect one lane at a time
+ * Return Value: int - a bit for every box the ray hits
+ */
+template <int W>
+static int IntersectScalar(const boxPacket<W> &packet, const Vec3<float> &startingPos, const Vec3<float> &inverseRay, float maxTime, float * entryTimes) {
+	int mask = 0;
+	for (int lane = 0; lane < W; lane++) {
+		if (BoxKernel::GetBox(packet, lane).Intersect(startingPos, inverseRay, maxTime, entryTimes[lane])) {
+			mask |= 1 << lane;
+		}
+	}
+	return mask;
+}
+
+#ifdef SIMD_X86
+
+/*
+ * Date: 10/17/26
+ * Function Name: IntersectSSE
+ * Arguments:
+ *     const boxPacket<W> & - the boxes
+ *     const Vec3<float> &  - the starting position of the ray
+ *     const Vec3<float> &  - the reciprocal of each ray component
+ *     float                - the farthest time along the ray that is still of interest
+ *     float *              - set to the entry time of the ray into every box
+ * Purpose: Intersect four lanes at a time
+ * Return Value: int - a bit for every box the ray hits
+ */
+template <int W>
+static int IntersectSSE(const boxPacket<W> &packet, const Vec3<float> &startingPos, const Vec3<float> &inverseRay, float maxTime, float * entryTimes) {
+	__m128 startX = _mm_set1_ps(startingPos.x), startY = _mm_set1_ps(startingPos.y), startZ = _mm_set1_ps(startingPos.z);
+	__m128 inverseX = _mm_set1_ps(inverseRay.x), inverseY = _mm_set1_ps(inverseRay.y), inverseZ = _mm_set1_ps(inverseRay.z);
+	__m128 limit = _mm_set1_ps(maxTime);
+	int mask = 0;
+
+	for (int first = 0; first < W; first += 4) {
+		__m128 tx0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(packet.lowerX + first), startX), inverseX);
+		__m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(packet.upperX + first), startX), inverseX);
+		__m128 ty0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(packet.lowerY + first), startY), inverseY);
+		__m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(packet.upperY + first), startY), inverseY);
+		__m128 tz0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(packet.lowerZ + first), startZ), inverseZ);
+		__m128 tz1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(packet.upperZ + first), startZ), inverseZ);
+
+		__m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx0, tx1), _mm_min_ps(ty0, ty1)), _mm_min_ps(tz0, tz1));
+		__m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx0, tx1), _mm_max_ps(ty0, ty1)), _mm_max_ps(tz0, tz1));
+
+		__m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(tNear, tFar), _mm_cmpge_ps(tFar, _mm_setzero_ps())), _mm_cmple_ps(tNear, limit));
+		_mm_storeu_ps(entryTimes + first, tNear);
+		mask |= _mm_movemask_ps(hit) << first;
+	}
+	return mask;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: IntersectAVX2
+ * Arguments:
+ *     const boxPacket<8> & - the boxes
+ *     const Vec3<float> &  - the starting position of the ray
+ *     const Vec3<float> &  - the reciprocal of each ray component
+ *     float                - the farthest time along the ray that is still of interest
+ *     float *              - set to the entry time of the ray into every box
+ * Purpose: Intersect on all eight lanes at once.  Packets of four use the SSE version
+ * Return Value: int - a bit for every box the ray hits
+ */
+SIMD_TARGET_AVX2 static int IntersectAVX2(const boxPacket<8> &packet, const Vec3<float> &startingPos, const Vec3<float> &inverseRay, float maxTime, float * entryTimes) {
+	__m256 startX = _mm256_set1_ps(startingPos.x), startY = _mm256_set1_ps(startingPos.y), startZ = _mm256_set1_ps(startingPos.z);
+	__m256 inverseX = _mm256_set1_ps(inverseRay.x), inverseY = _mm256_set1_ps(inverseRay.y), inverseZ = _mm256_set1_ps(inverseRay.z);
+
+	__m256 tx0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(packet.lowerX), startX), inverseX);
+	__m256 tx1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(packet.upperX), startX), inverseX);
+	__m256 ty0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(packet.lowerY), startY), inverseY);
+	__m256 ty1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(packet.upperY), startY), inverseY);
+	__m256 tz0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(packet.lowerZ), startZ), inverseZ);
+	__m256 tz1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(packet.upperZ), startZ), inverseZ);
+
+	__m256 tNear = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(tx0, tx1), _mm256_min_ps(ty0, ty1)), _mm256_min_ps(tz0, tz1));
+	__m256 tFar = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(tx0, tx1), _mm256_max_ps(ty0, ty1)), _mm256_max_ps(tz0, tz1));
+
+	__m256 hit = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ), _mm256_cmp_ps(tFar, _mm256_setzero_ps(), _CMP_GE_OQ)),
+	                           _mm256_cmp_ps(tNear, _mm256_set1_ps(maxTime), _CMP_LE_OQ));
+	_mm256_storeu_ps(entryTimes, tNear);
+	return _mm256_movemask_ps(hit);
+}
+
+#endif
+
+/*
+ * Date: 10/17/26
+ * Function Name: BoxKernel (constructor)
+ * Arguments:
+ *     void
+ * Purpose: Constructor using the widest kernel the processor supports
+ * Return Value: void
+ */
+BoxKernel::BoxKernel() {
+	Select(Simd::GetBestLevel());
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BoxKernel (constructor)
+ * Arguments:
+ *     simd_level - the kernel to use.  Lowered to the best supported level if the processor lacks it
+ * Purpose: Constructor
+ * Return Value: void
+ */
+BoxKernel::BoxKernel(simd_level level) {
+	Select(Simd::Supported(level));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Select
+ * Arguments:
+ *     simd_level - a supported level
+ * Purpose: Points the intersect functions at the kernel for the level
+ * Return Value: void
+ */
+void BoxKernel::Select(simd_level level) {
+	_level = level;
+	_intersect4 = IntersectScalar<4>;
+	_intersect8 = IntersectScalar<8>;
+
+#ifdef SIMD_X86
+	if (level == SIMD_SSE) {
+		_intersect4 = IntersectSSE<4>;
+		_intersect8 = IntersectSSE<8>;
+	} else if (level == SIMD_AVX2) {
+		_intersect4 = IntersectSSE<4>;
+		_intersect8 = IntersectAVX2;
+	}
+#endif
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetLevel
+ * Arguments:
+ *     void
+ * Purpose: Returns the level of the kernel in use
+ * Return Value: simd_level
+ */
+simd_level BoxKernel::GetLevel() {
+	return _level;
+}
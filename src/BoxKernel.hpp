@@ -0,0 +1,128 @@
+#pragma once
+
+#include <limits>
+
+#include "BoundingBox.hpp"
+#include "Simd.hpp"
+#include "Vector.hpp"
+
+// The child boxes of a wide BVH node in structure of arrays form, so one ray is tested against all of them at once.
+// Unused lanes are NaN which no ray can hit
+template <int W>
+struct boxPacket {
+	float lowerX[W];
+	float lowerY[W];
+	float lowerZ[W];
+	float upperX[W];
+	float upperY[W];
+	float upperZ[W];
+};
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: BoxKernel
+ * Purpose: Slab tests one ray against a packet of four or eight boxes at once.  The SSE and AVX2 versions are picked
+ *          at run time when the processor supports them, the scalar version works everywhere
+ */
+class BoxKernel {
+
+	public :
+		BoxKernel();
+		BoxKernel(simd_level level);
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Intersect
+		 * Arguments:
+		 *     const boxPacket<4> & - the boxes
+		 *     const Vec3<float> &  - the starting position of the ray
+		 *     const Vec3<float> &  - the reciprocal of each ray component
+		 *     float                - the farthest time along the ray that is still of interest
+		 *     float *              - set to the entry time of the ray into every box
+		 * Purpose: BoundingBox::Intersect for four boxes
+		 * Return Value: int - a bit for every box the ray hits
+		 */
+		int Intersect(const boxPacket<4> &packet, const Vec3<float> &startingPos, const Vec3<float> &inverseRay, float maxTime, float * entryTimes) {
+			return _intersect4(packet, startingPos, inverseRay, maxTime, entryTimes);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Intersect
+		 * Arguments:
+		 *     const boxPacket<8> & - the boxes
+		 *     const Vec3<float> &  - the starting position of the ray
+		 *     const Vec3<float> &  - the reciprocal of each ray component
+		 *     float                - the farthest time along the ray that is still of interest
+		 *     float *              - set to the entry time of the ray into every box
+		 * Purpose: BoundingBox::Intersect for eight boxes
+		 * Return Value: int - a bit for every box the ray hits
+		 */
+		int Intersect(const boxPacket<8> &packet, const Vec3<float> &startingPos, const Vec3<float> &inverseRay, float maxTime, float * entryTimes) {
+			return _intersect8(packet, startingPos, inverseRay, maxTime, entryTimes);
+		}
+
+		simd_level GetLevel();
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: SetBox
+		 * Arguments:
+		 *     boxPacket<W> &      - the packet
+		 *     int                 - the lane to fill
+		 *     const BoundingBox & - the box
+		 * Purpose: Stores a box in one lane
+		 * Return Value: void
+		 */
+		template <int W>
+		static void SetBox(boxPacket<W> &packet, int lane, const BoundingBox &box) {
+			packet.lowerX[lane] = box.lower.x;
+			packet.lowerY[lane] = box.lower.y;
+			packet.lowerZ[lane] = box.lower.z;
+			packet.upperX[lane] = box.upper.x;
+			packet.upperY[lane] = box.upper.y;
+			packet.upperZ[lane] = box.upper.z;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: ClearBox
+		 * Arguments:
+		 *     boxPacket<W> & - the packet
+		 *     int            - the lane to empty
+		 * Purpose: Fills a lane with NaN so every comparison of the slab test fails
+		 * Return Value: void
+		 */
+		template <int W>
+		static void ClearBox(boxPacket<W> &packet, int lane) {
+			float nan = std::numeric_limits<float>::quiet_NaN();
+			packet.lowerX[lane] = packet.lowerY[lane] = packet.lowerZ[lane] = nan;
+			packet.upperX[lane] = packet.upperY[lane] = packet.upperZ[lane] = nan;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetBox
+		 * Arguments:
+		 *     const boxPacket<W> & - the packet
+		 *     int                  - the lane
+		 * Purpose: Gets the box in a lane
+		 * Return Value: BoundingBox
+		 */
+		template <int W>
+		static BoundingBox GetBox(const boxPacket<W> &packet, int lane) {
+			return BoundingBox(Vec3<float>::vec3(packet.lowerX[lane], packet.lowerY[lane], packet.lowerZ[lane]),
+			                   Vec3<float>::vec3(packet.upperX[lane], packet.upperY[lane], packet.upperZ[lane]));
+		}
+
+	private :
+		typedef int (*intersect4Function)(const boxPacket<4> &packet, const Vec3<float> &startingPos, const Vec3<float> &inverseRay, float maxTime, float * entryTimes);
+		typedef int (*intersect8Function)(const boxPacket<8> &packet, const Vec3<float> &startingPos, const Vec3<float> &inverseRay, float maxTime, float * entryTimes);
+
+		void Select(simd_level level);
+
+		simd_level _level;
+		intersect4Function _intersect4;
+		intersect8Function _intersect8;
+};
@@ -7,12 +7,20 @@
 #include <string>
 #include <string.h>
 #include <map>
+#include <vector>
 
 #include "tinyxml2.h"
 #include "Vector.hpp"
 
 using namespace std;
 
+// Handles every color table starts with, so the renderer can use them without looking up a name
+enum color_handle {
+	COLOR_NONE,  // Names missing from the colors section.  Always black
+	COLOR_BLACK, // The background of the image
+	COLOR_WHITE  // The color of geometry without a color tag
+};
+
 /*
  * Author: Ben Vesel
  * Date: 12/20/16
@@ -21,17 +29,31 @@ using namespace std;
  */
 class Color {
 	public: 
-		Color() {}
-
-		Color(std::string fileName) {
-			tinyxml2::XMLDocument doc;
-			doc.LoadFile(fileName.c_str());
-
-			if(doc.Error()) {
-				cout << "There was an error parsing " << fileName << endl;
-				doc.PrintError();
-				exit(1);
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Color (constructor)
+		 * Arguments:
+		 *     void
+		 * Purpose: Constructor.  Registers the constant handles, black until the colors section says otherwise
+		 * Return Value: void
+		 */
+		Color() {
+			const char * names[] = {"", "BLACK", "WHITE"};
+			for (int i = COLOR_NONE; i <= COLOR_WHITE; i++) {
+				_handles[names[i]] = i;
+				_colors.push_back(Vec3<unsigned char>::vec3(0, 0, 0));
 			}
+		}
+
+		/* 
+		 * Date: 10/17/26
+		 * Function Name: Load
+		 * Arguments: 
+		 *     tinyxml2::XMLDocument - the parsed scene document
+		 * Purpose: Maps the custom colors of the "colors" section
+		 * Return Value: void
+		 */
+		void Load(tinyxml2::XMLDocument &doc) {
 
 			// Iterate through the xml elements until we find "colors" section
 			tinyxml2::XMLElement * colorParent = doc.FirstChildElement();
@@ -66,15 +88,33 @@ class Color {
 
 				color = color->NextSiblingElement();
 
-				// Add the color to the map
+				// Add the color to the table, or replace it if the name is already there
 				if( addColor ) {
 					std::string str(colorName);
 					transform(str.begin(), str.end(), str.begin(), ::toupper);
-					_colorMap[str] = Vec3<unsigned char>::vec3(r, g, b);
+					if( _handles.find(str) == _handles.end() ) {
+						_handles[str] = (int)_colors.size();
+						_colors.push_back(Vec3<unsigned char>::vec3(0, 0, 0));
+					}
+					_colors[_handles[str]] = Vec3<unsigned char>::vec3(r, g, b);
 				}
 			}
 		}
 
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetHandle
+		 * Arguments:
+		 *     std::string - the name of the color
+		 * Purpose: Resolves a color name to its handle.  Meant for loading the scene, the renderer only uses handles
+		 * Return Value: int - the handle, COLOR_NONE if the name is not mapped
+		 */
+		int GetHandle(std::string str) {
+			transform(str.begin(), str.end(), str.begin(), ::toupper);
+			std::map<std::string, int>::iterator handle = _handles.find(str);
+			return handle == _handles.end() ? (int)COLOR_NONE : handle->second;
+		}
+
 		/* 
 		 * Date: 1/7/16
 		 * Function Name: GetColor
@@ -84,13 +124,19 @@ class Color {
 		 * Return Value: Vec3<unsigned char>
 		 */
 		Vec3<unsigned char> GetColor(std::string str) {
-			transform(str.begin(), str.end(), str.begin(), ::toupper);
-			// Check that a value exists
-			if( _colorMap.find(str) == _colorMap.end() ) {
-				return Vec3<unsigned char>::vec3(0, 0, 0);
-			}
-			return _colorMap[str];
+			return _colors[GetHandle(str)];
+		}
 
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetColor
+		 * Arguments:
+		 *     int - the handle of the color
+		 * Purpose: Gets the color of a handle from GetHandle or color_handle
+		 * Return Value: Vec3<unsigned char>
+		 */
+		Vec3<unsigned char> GetColor(int handle) const {
+			return _colors[handle];
 		}
 
 		/* 
@@ -211,6 +257,7 @@ class Color {
 		}
 
 	private:
-		std::map<std::string, Vec3<unsigned char> > _colorMap;
+		std::map<std::string, int> _handles;
+		std::vector<Vec3<unsigned char> > _colors;
 		
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "BVH.hpp"
+#include "PngEncoder.hpp"
 #include "tinyxml2.h"
 
 //TODO <BMV> Parse gradient information
@@ -13,16 +15,17 @@
 class Config {
 
 	public:
-		Config(std::string fileName) {
-			tinyxml2::XMLDocument doc;
-			doc.LoadFile(fileName.c_str());
-
-			// Parse the xml document
-			if (doc.Error()) {
-				std::cout << "There was an error parsing " << fileName << std::endl;
-				doc.PrintError();
-				exit(1);
-			}
+		Config() {}
+
+		/*
+		* Date: 10/17/26
+		* Function Name: Load
+		* Arguments:
+		*     tinyxml2::XMLDocument - the parsed scene document
+		* Purpose: Reads the settings of the "configuration" section.  Missing settings keep their defaults
+		* Return Value: void
+		*/
+		void Load(tinyxml2::XMLDocument &doc) {
 
 			// Iterate through the xml elements for the configuration section
 			tinyxml2::XMLElement * rootElement = doc.FirstChildElement();
@@ -75,12 +78,59 @@ class Config {
 						if (!strncmp(str.c_str(), "TRUE", 4)) {
 							_isAnaglyph = true;
 						}
+					} else if(!strncmp(configElement->Value(), "threads", 7)) {
+						_threadCount = atoi(str.c_str());
+						if (_threadCount < 0) {
+							std::cout << "Thread count must not be negative.  Using every hardware thread" << std::endl;
+							_threadCount = 0;
+						}
+					} else if(!strncmp(configElement->Value(), "scene_cache", 11)) {
+						if(!strncmp(str.c_str(), "TRUE", 4)) {
+							_sceneCache = true;
+						}
+					} else if(!strncmp(configElement->Value(), "cache_directory", 15)) {
+						// Paths keep their case
+						_cacheDirectory = configElement->GetText();
+						_sceneCache = true;
+					} else if(!strncmp(configElement->Value(), "packet_tracing", 14)) {
+						_packetTracing = strncmp(str.c_str(), "FALSE", 5) != 0;
+					} else if(!strncmp(configElement->Value(), "stereo_tracing", 14)) {
+						_stereoTracing = strncmp(str.c_str(), "FALSE", 5) != 0;
 					} else if(!strncmp(configElement->Value(), "normal_correction", 17)) {
 						if(!strncmp(str.c_str(), "TRUE", 4)) {
 							_normalCorrection = true;
 						} else {
 							_normalCorrection = false;
 						}
+					} else if(!strncmp(configElement->Value(), "bvh_quality", 11)) {
+						if(!strncmp(str.c_str(), "HIGH", 4)) {
+							_bvhQuality = BVH_QUALITY_HIGH;
+						} else if(!strncmp(str.c_str(), "MEDIUM", 6)) {
+							_bvhQuality = BVH_QUALITY_MEDIUM;
+						} else if(!strncmp(str.c_str(), "FAST", 4)) {
+							_bvhQuality = BVH_QUALITY_FAST;
+						} else {
+							std::cout << "BVH quality must be HIGH, MEDIUM or FAST.  Using HIGH" << std::endl;
+							_bvhQuality = BVH_QUALITY_HIGH;
+						}
+					} else if(!strncmp(configElement->Value(), "bvh_width", 9)) {
+						_bvhWidth = atoi(str.c_str());
+						if (_bvhWidth != 2 && _bvhWidth != 4 && _bvhWidth != 8) {
+							std::cout << "BVH width must be 2, 4 or 8.  Using 2" << std::endl;
+							_bvhWidth = 2;
+						}
+					} else if(!strncmp(configElement->Value(), "bvh_refit_limit", 15)) {
+						_bvhRefitLimit = (float)atof(str.c_str());
+						if (_bvhRefitLimit < 1.f) {
+							std::cout << "BVH refit limit must be at least 1.  Using 1" << std::endl;
+							_bvhRefitLimit = 1.f;
+						}
+					} else if(!strncmp(configElement->Value(), "png_compression", 15)) {
+						_pngCompression = atoi(str.c_str());
+						if (_pngCompression < 0 || _pngCompression > PNG_MAX_LEVEL) {
+							std::cout << "PNG compression must be 0 to 9.  Using " << PNG_DEFAULT_LEVEL << std::endl;
+							_pngCompression = PNG_DEFAULT_LEVEL;
+						}
 					}
 
 					// Get the next sibling element
@@ -176,6 +226,118 @@ class Config {
 			return _ambientLight;
 		}
 
+		/*
+		* Date: 10/17/26
+		* Function Name: GetThreadCount
+		* Arguments:
+		*     void
+		* Purpose: Returns the number of render threads (0 means one per hardware thread)
+		* Return Value: int
+		*/
+		int GetThreadCount() {
+			return _threadCount;
+		}
+
+		/*
+		* Date: 10/17/26
+		* Function Name: UseSceneCache
+		* Arguments:
+		*     void
+		* Purpose: Returns true if the compiled geometry is cached next to the scene file
+		* Return Value: bool
+		*/
+		bool UseSceneCache() {
+			return _sceneCache;
+		}
+
+		/*
+		* Date: 10/17/26
+		* Function Name: GetCacheDirectory
+		* Arguments:
+		*     void
+		* Purpose: Returns the directory the scene caches are kept in, relative to the scene file.  Empty to keep the
+		*          cache next to the scene file
+		* Return Value: std::string
+		*/
+		std::string GetCacheDirectory() {
+			return _cacheDirectory;
+		}
+
+		/*
+		* Date: 10/17/26
+		* Function Name: UsePacketTracing
+		* Arguments:
+		*     void
+		* Purpose: Returns true if the primary rays are traced through the hierarchy in coherent packets
+		* Return Value: bool
+		*/
+		bool UsePacketTracing() {
+			return _packetTracing;
+		}
+
+		/*
+		* Date: 10/17/26
+		* Function Name: UseStereoTracing
+		* Arguments:
+		*     void
+		* Purpose: Returns true if the two anaglyph images are traced together in one pass
+		* Return Value: bool
+		*/
+		bool UseStereoTracing() {
+			return _stereoTracing;
+		}
+
+		/*
+		* Date: 10/17/26
+		* Function Name: GetBvhQuality
+		* Arguments:
+		*     void
+		* Purpose: Returns how carefully the hierarchy is built.  HIGH sweeps every split, MEDIUM and FAST bin the
+		*          primitives and build much faster for slightly slower rendering
+		* Return Value: bvh_quality
+		*/
+		bvh_quality GetBvhQuality() {
+			return _bvhQuality;
+		}
+
+		/*
+		* Date: 10/17/26
+		* Function Name: GetBvhWidth
+		* Arguments:
+		*     void
+		* Purpose: Returns the children per node of the hierarchy the rays walk, 2 for the binary layout or 4 or 8
+		*          for a wide one
+		* Return Value: int
+		*/
+		int GetBvhWidth() {
+			return _bvhWidth;
+		}
+
+		/*
+		* Date: 10/17/26
+		* Function Name: GetBvhRefitLimit
+		* Arguments:
+		*     void
+		* Purpose: Returns how many times its built SAH cost the hierarchy may cost after refits for moved geometry
+		*          before it is rebuilt instead
+		* Return Value: float
+		*/
+		float GetBvhRefitLimit() {
+			return _bvhRefitLimit;
+		}
+
+		/*
+		* Date: 10/17/26
+		* Function Name: GetPngCompression
+		* Arguments:
+		*     void
+		* Purpose: Returns the compression level of the images written, 0 (stored) to 9 (smallest)
+		* Return Value: int
+		*/
+		int GetPngCompression() {
+			return _pngCompression;
+		}
+
 
 	private:
 		bool _antiAliasing = false;
@@ -185,6 +347,15 @@ class Config {
 		float _ambientLight = 0.2f;
 		int _imageLength = 512;
 		int _imageHeight = 512;
+		int _threadCount = 0;
+		bool _sceneCache = false;
+		std::string _cacheDirectory;
+		bool _packetTracing = true;
+		bool _stereoTracing = true;
+		bvh_quality _bvhQuality = BVH_QUALITY_HIGH;
+		int _bvhWidth = 2;
+		float _bvhRefitLimit = BVH_REFIT_LIMIT;
+		int _pngCompression = PNG_DEFAULT_LEVEL;
 
 
 };
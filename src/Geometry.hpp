@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BoundingBox.hpp"
 #include "RayHit.hpp"
 #include "Vector.hpp"
 
@@ -10,7 +11,10 @@ class Geometry {
 			TRIANGLE,
 			SPHERE, 
 			POINT,
-            SQUARE
+            SQUARE,
+			MESH,
+			SPHERE_SET,
+			INSTANCE
 		};
 
 		/* 
@@ -23,29 +27,18 @@ class Geometry {
 		 */
 		Geometry(Shape shape) {
 			_shape = shape;
+			_material = MATERIAL_DEFAULT;
 		}
 
-		/* 
-		 * Date: 1/18/16
-		 * Function Name: GetColor
-		 * Arguments: 
-		 *     void
-		 * Purpose: Gets the color
-		 * Return Value: Vec3<unsigned char>
-		 */
-		Vec3<unsigned char> GetColor() {
-			return _color;
-		}
-
-		/* 
-		 * Date: 1/18/16
-		 * Function Name: GetMaterial
-		 * Arguments: 
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetMaterialId
+		 * Arguments:
 		 *     void
-		 * Purpose: Gets the material of the geometry
-		 * Return Value: Material
+		 * Purpose: Gets the entry of the scene's MaterialTable with the color and material of the geometry
+		 * Return Value: materialId
 		 */
-		Material GetMaterial() {
+		materialId GetMaterialId() {
 			return _material;
 		}
 
@@ -61,28 +54,16 @@ class Geometry {
 			return _shape;
 		}
 
-		/* 
-		 * Date: 1/18/16
-		 * Function Name: SetColor
-		 * Arguments: 
-		 *     Vec3<unsigned char> - the color of the geometry
-		 * Purpose: Sets the color of the geometry
-		 * Return Value: void
-		 */
-		void SetColor(Vec3<unsigned char> color) {
-			_color = color;
-		}
-
-		/* 
-		 * Date: 1/18/16
-		 * Function Name: SetMaterial
-		 * Arguments: 
-		 *     Material - the material of the geometry
-		 * Purpose: Sets the material of the geometry
+		/*
+		 * Date: 10/17/26
+		 * Function Name: SetMaterialId
+		 * Arguments:
+		 *     materialId - the entry of the scene's MaterialTable
+		 * Purpose: Sets the color and material of the geometry
 		 * Return Value: void
 		 */
-		void SetMaterial(Material mat) {
-			_material = mat;
+		void SetMaterialId(materialId material) {
+			_material = material;
 		}
 		
 		/* 
@@ -91,11 +72,27 @@ class Geometry {
 		 * Arguments: 
 		 *     Vec3<float> - the ray
 		 *     Vec3<float> - the starting position of the ray
-		 * Purpose: Returns a RayHit object on the intersection of geometry
-		 * Return Value: shared_ptr<RayHit>
+		 *     RayHit &    - the caller's hit record.  Its time is the closest hit found so far
+		 * Purpose: Writes the intersection into the hit record if it is closer than the one already there
+		 * Return Value: bool - true if the record was updated
+		 */
+		virtual bool Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+			return false;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Occluded
+		 * Arguments:
+		 *     Vec3<float> - the ray
+		 *     Vec3<float> - the starting position of the ray
+		 *     float       - hits at or before this time are ignored
+		 *     float       - hits at or after this time are ignored
+		 * Purpose: Returns true if the ray hits the geometry between the two times.  Used for shadow rays
+		 * Return Value: bool
 		 */
-		virtual std::shared_ptr<RayHit> Intersect(Vec3<float> ray, Vec3<float> startingPos) {
-			return nullptr;
+		virtual bool Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+			return false;
 		}
 
 
@@ -110,6 +107,113 @@ class Geometry {
 		virtual Vec3<float> GetRandomPoint() {
 			return Vec3<float>::vec3(0, 0, 0);
 		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetBoundingBox
+		 * Arguments:
+		 *     void
+		 * Purpose: Gets the axis aligned bounds of the geometry for the acceleration structure
+		 * Return Value: BoundingBox
+		 */
+		virtual BoundingBox GetBoundingBox() {
+			return BoundingBox();
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetPrimitiveCount
+		 * Arguments:
+		 *     void
+		 * Purpose: Returns the number of primitives the acceleration structure should bound separately.  Zero for
+		 *          geometry that is bounded and intersected as a whole
+		 * Return Value: int
+		 */
+		virtual int GetPrimitiveCount() {
+			return 0;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetPrimitiveBounds
+		 * Arguments:
+		 *     int - the primitive (0 to GetPrimitiveCount() - 1)
+		 * Purpose: Gets the axis aligned bounds of one primitive
+		 * Return Value: BoundingBox
+		 */
+		virtual BoundingBox GetPrimitiveBounds(int index) {
+			return GetBoundingBox();
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: IntersectPrimitive
+		 * Arguments:
+		 *     int         - the primitive (0 to GetPrimitiveCount() - 1)
+		 *     Vec3<float> - the ray
+		 *     Vec3<float> - the starting position of the ray
+		 *     RayHit &    - the caller's hit record
+		 * Purpose: Intersect for a single primitive
+		 * Return Value: bool - true if the record was updated
+		 */
+		virtual bool IntersectPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+			return Intersect(ray, startingPos, rayHit);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: OccludedPrimitive
+		 * Arguments:
+		 *     int         - the primitive (0 to GetPrimitiveCount() - 1)
+		 *     Vec3<float> - the ray
+		 *     Vec3<float> - the starting position of the ray
+		 *     float       - hits at or before this time are ignored
+		 *     float       - hits at or after this time are ignored
+		 * Purpose: Occluded for a single primitive
+		 * Return Value: bool
+		 */
+		virtual bool OccludedPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+			return Occluded(ray, startingPos, minTime, maxTime);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetTriangles
+		 * Arguments:
+		 *     int           - the primitive (0 to GetPrimitiveCount() - 1), -1 for the whole geometry
+		 *     Vec3<float> * - filled with three vertices per triangle, room for two triangles
+		 * Purpose: Gets the triangles of a primitive so the acceleration structure can intersect them in packets.
+		 *          Geometry that returns triangles is intersected through them instead of Intersect and Occluded
+		 * Return Value: int - the number of triangles, 0 if the primitive is not made of triangles
+		 */
+		virtual int GetTriangles(int index, Vec3<float> * vertices) {
+			return 0;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetSphere
+		 * Arguments:
+		 *     int           - the primitive (0 to GetPrimitiveCount() - 1), -1 for the whole geometry
+		 *     Vec3<float> & - set to the center
+		 *     float &       - set to the radius
+		 * Purpose: Gets a primitive that is a sphere so the acceleration structure can intersect it in packets
+		 * Return Value: bool - false if the primitive is not a sphere
+		 */
+		virtual bool GetSphere(int index, Vec3<float> &center, float &radius) {
+			return false;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Translate
+		 * Arguments:
+		 *     Vec3<float> - the offset
+		 * Purpose: Moves the geometry.  An acceleration structure built over it must be refit before it is traced
+		 * Return Value: void
+		 */
+		virtual void Translate(Vec3<float> offset) {
+		}
     
         /*
 	     * Date: 3/3/17
@@ -122,8 +226,7 @@ class Geometry {
         virtual ~Geometry() { }
 
 	private :
-		Vec3<unsigned char> _color;
-		Material _material;
+		materialId _material;
 		Shape _shape;
 
 };
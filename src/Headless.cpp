@@ -0,0 +1,69 @@
+/* Standard libs */
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/* Project headers */
+#include "Renderer.hpp"
+
+using namespace std;
+
+/*
+ * Date: 10/17/26
+ * Function Name: main
+ * Arguments:
+ *     int    - the number of command line arguments
+ *     char** - the scene file followed by the optional output files, or --frames with the first and last frame of
+ *              an animation before them
+ * Purpose: Headless entry point.  Renders the scene (or a range of frames of its animation) without a display,
+ *          writes the images and exits
+ * Return Value: int
+ */
+int main(int argc, char ** argv) {
+
+    // A sequence loads the scene once and numbers the images of every frame
+    bool sequence = argc > 1 && std::string(argv[1]) == "--frames";
+    int firstFrame = 0, lastFrame = 0, sceneArgument = sequence ? 4 : 1;
+    if(sequence && argc > 3) {
+        firstFrame = atoi(argv[2]);
+        lastFrame = atoi(argv[3]);
+    }
+
+    if(argc < sceneArgument + 1 || argc > sceneArgument + 4 || firstFrame < 0 || lastFrame < firstFrame) {
+        cout << "Usage: " << argv[0] << " [--frames <first> <last>] <scene.xml> [output1.png] [output2.png] [anaglyph.png]" << endl;
+        cout << "The second image and the anaglyph are only written when anaglyph mode is enabled" << endl;
+        cout << "With --frames every frame of the animation in the range is rendered to numbered images (output1_0000.png and so on)" << endl;
+        cout << "The range ends at the last frame of the animation, a later last frame is lowered to it" << endl;
+        return 1;
+    }
+
+    std::string firstImage = argc > sceneArgument + 1 ? argv[sceneArgument + 1] : "output1.png";
+    std::string secondImage = argc > sceneArgument + 2 ? argv[sceneArgument + 2] : "output2.png";
+    std::string anaglyphImage = argc > sceneArgument + 3 ? argv[sceneArgument + 3] : "anaglyph.png";
+
+    Renderer renderer(argv[sceneArgument]);
+    if(sequence) {
+        
+        // The frame count is only known once the scene is loaded
+        int frameCount = renderer.GetAnimation().GetFrameCount();
+        if(firstFrame >= frameCount) {
+            cout << "The first frame " << firstFrame << " is past the last frame of the animation (" << frameCount - 1 << ")" << endl;
+            return 1;
+        }
+        if(lastFrame >= frameCount) {
+            cout << "The animation has " << frameCount << " frames, rendering frames " << firstFrame << " to " << frameCount - 1 << endl;
+            lastFrame = frameCount - 1;
+        }
+        renderer.RenderSequence(firstFrame, lastFrame, firstImage, secondImage, anaglyphImage);
+        return 0;
+    }
+
+    renderer.Render();
+    renderer.WriteImages(firstImage, secondImage);
+
+    if(renderer.GetConfiguration().IsAnaglyph()) {
+        renderer.WriteAnaglyph(anaglyphImage);
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "ImageWriter.hpp"
+
+#include <iostream>
+
+/*
+ * Date: 10/17/26
+ * Function Name: ImageWriter (constructor)
+ * Arguments:
+ *     ThreadPool * - the threads that compress the chunks of every image, NULL to compress on the writer thread
+ *     int          - the compression level, 0 (stored) to 9 (smallest)
+ * Purpose: Constructor.  Starts the writer thread which sleeps until an image is queued
+ * Return Value: void
+ */
+ImageWriter::ImageWriter(ThreadPool * pool, int level) : _encoder(pool, level), _busy(false), _shutdown(false) {
+	pthread_mutex_init(&_lock, NULL);
+	pthread_cond_init(&_wake, NULL);
+	pthread_cond_init(&_idle, NULL);
+	pthread_create(&_thread, NULL, WriterMain, this);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ~ImageWriter
+ * Arguments:
+ *     void
+ * Purpose: Destructor.  Writes the images still queued then joins the writer thread
+ * Return Value: void
+ */
+ImageWriter::~ImageWriter() {
+	pthread_mutex_lock(&_lock);
+	_shutdown = true;
+	pthread_cond_signal(&_wake);
+	pthread_mutex_unlock(&_lock);
+
+	pthread_join(_thread, NULL);
+	pthread_cond_destroy(&_idle);
+	pthread_cond_destroy(&_wake);
+	pthread_mutex_destroy(&_lock);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Write
+ * Arguments:
+ *     std::string           - the png file to write
+ *     const unsigned char * - the RGB pixels.  Must stay unchanged until Wait returns
+ *     int                   - the width of the image in pixels
+ *     int                   - the height of the image in pixels
+ * Purpose: Queues an image to be written and returns without waiting for it
+ * Return Value: void
+ */
+void ImageWriter::Write(std::string fileName, const unsigned char * pixels, int width, int height) {
+	imageJob job;
+	job.fileName = fileName;
+	job.pixels = pixels;
+	job.width = width;
+	job.height = height;
+
+	pthread_mutex_lock(&_lock);
+	_jobs.push_back(job);
+	pthread_cond_signal(&_wake);
+	pthread_mutex_unlock(&_lock);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Wait
+ * Arguments:
+ *     void
+ * Purpose: Blocks until every queued image has been written, after which their pixels may be reused
+ * Return Value: void
+ */
+void ImageWriter::Wait() {
+	pthread_mutex_lock(&_lock);
+	while (_busy || !_jobs.empty()) {
+		pthread_cond_wait(&_idle, &_lock);
+	}
+	pthread_mutex_unlock(&_lock);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: WriterMain
+ * Arguments:
+ *     void * - the ImageWriter
+ * Purpose: Body of the writer thread.  Writes queued images until the writer shuts down with an empty queue
+ * Return Value: void *
+ */
+void * ImageWriter::WriterMain(void * arg) {
+	ImageWriter * writer = (ImageWriter *)arg;
+
+	pthread_mutex_lock(&writer->_lock);
+	while (true) {
+		if (writer->_jobs.empty()) {
+			writer->_busy = false;
+			pthread_cond_broadcast(&writer->_idle);
+			if (writer->_shutdown) {
+				break;
+			}
+			pthread_cond_wait(&writer->_wake, &writer->_lock);
+			continue;
+		}
+
+		imageJob job = writer->_jobs.front();
+		writer->_jobs.pop_front();
+		writer->_busy = true;
+		pthread_mutex_unlock(&writer->_lock);
+
+		if (!writer->_encoder.Write(job.fileName, job.pixels, job.width, job.height)) {
+			std::cout << "Failed to write " << job.fileName << std::endl;
+		}
+
+		pthread_mutex_lock(&writer->_lock);
+	}
+	pthread_mutex_unlock(&writer->_lock);
+	return NULL;
+}
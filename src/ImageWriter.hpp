@@ -0,0 +1,50 @@
+#pragma once
+
+#include <deque>
+#include <pthread.h>
+#include <string>
+
+#include "PngEncoder.hpp"
+#include "ThreadPool.hpp"
+
+// An image waiting to be written.  The pixels (RGB rows without padding) still belong to the caller, who must keep
+// them unchanged until Wait returns
+typedef struct {
+	std::string fileName;
+	const unsigned char * pixels;
+	int width;
+	int height;
+} imageJob;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: ImageWriter
+ * Purpose: Encodes and writes png files on a thread of its own, so the next frame can be traced while the last one
+ *          is written.  Images are written in the order they were queued, each compressed in parallel on the
+ *          render threads
+ */
+class ImageWriter {
+
+	public :
+		ImageWriter(ThreadPool * pool = NULL, int level = PNG_DEFAULT_LEVEL);
+		~ImageWriter();
+
+		void Write(std::string fileName, const unsigned char * pixels, int width, int height);
+		void Wait();
+
+	private :
+		ImageWriter(const ImageWriter &other);
+		ImageWriter & operator=(const ImageWriter &other);
+
+		static void * WriterMain(void * arg);
+
+		PngEncoder _encoder;
+		pthread_t _thread;
+		pthread_mutex_t _lock;
+		pthread_cond_t _wake; // Signaled when an image is queued or the writer shuts down
+		pthread_cond_t _idle; // Signaled when the queue runs dry
+		std::deque<imageJob> _jobs;
+		bool _busy;
+		bool _shutdown;
+};
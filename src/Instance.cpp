@@ -0,0 +1,118 @@
+#include "Instance.hpp"
+
+/*
+ * Date: 10/17/26
+ * Function Name: Instance (constructor)
+ * Arguments:
+ *     BVH *      - the hierarchy of the mesh, shared by all of its instances and owned by the scene.  It only has
+ *                  to be built before the instance is traced or bounded
+ *     int        - the index of the mesh among the meshes that are instanced
+ *     Transform  - places the mesh in the scene.  It must have an inverse
+ *     materialId - the entry of the material table used for every hit
+ * Purpose: Constructor
+ * Return Value: void
+ */
+Instance::Instance(BVH * hierarchy, int prototype, Transform transform, materialId material) : super(INSTANCE), _hierarchy(hierarchy), _prototype(prototype), _transform(transform) {
+	_transform.Inverse(_inverse);
+	SetMaterialId(material);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Intersect
+ * Arguments:
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     RayHit &    - the hit record holding the closest hit so far
+ * Purpose: Traces the ray through the hierarchy of the mesh in the space of the mesh.  The direction is not
+ *          normalized there, so the times of the hits are the same in both spaces and the closest hit so far still
+ *          bounds the search.  The normal is carried back by the transpose of the inverse
+ * Return Value: bool - true if the hit record was updated
+ */
+bool Instance::Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+	RayHit localHit = rayHit;
+	if (!_hierarchy->Intersect(_inverse.Vector(ray), _inverse.Point(startingPos), localHit)) {
+		return false;
+	}
+
+	float time = localHit.GetTime();
+	Vec3<float> normal = Vec3<float>::Normalize(_inverse.TransposedVector(localHit.GetNormal()));
+	Vec3<float> hitLocation = Vec3<float>::Add(Vec3<float>::vec3(time * ray.x, time * ray.y, time * ray.z), startingPos);
+	rayHit.SetHit(time, GetMaterialId(), normal, Vec3<float>::vec3(0, 0, 0) - normal, hitLocation, ray);
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Occluded
+ * Arguments:
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Tests if the mesh blocks the ray, in the space of the mesh
+ * Return Value: bool
+ */
+bool Instance::Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	return _hierarchy->Occluded(_inverse.Vector(ray), _inverse.Point(startingPos), minTime, maxTime);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetRandomPoint
+ * Arguments:
+ *     void
+ * Purpose: Returns where the origin of the mesh is placed, meshes have no points of their own to sample
+ * Return Value: Vec3<float>
+ */
+Vec3<float> Instance::GetRandomPoint() {
+	return _transform.GetColumn(3);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetBoundingBox
+ * Arguments:
+ *     void
+ * Purpose: Bounds the transformed box of the hierarchy of the mesh
+ * Return Value: BoundingBox
+ */
+BoundingBox Instance::GetBoundingBox() {
+	const std::vector<BVHNode, ArenaAllocator<BVHNode> > &nodes = _hierarchy->GetNodes();
+	return nodes.empty() ? BoundingBox() : _transform.Box(nodes[0].bounds);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Translate
+ * Arguments:
+ *     Vec3<float> - the offset
+ * Purpose: Moves the instance.  The mesh and its hierarchy stay as they are
+ * Return Value: void
+ */
+void Instance::Translate(Vec3<float> offset) {
+	_transform = _transform.Then(Transform::Translation(offset));
+	_transform.Inverse(_inverse);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPrototype
+ * Arguments:
+ *     void
+ * Return Value: int - the index of the mesh among the meshes that are instanced
+ */
+int Instance::GetPrototype() {
+	return _prototype;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetTransform
+ * Arguments:
+ *     void
+ * Return Value: const Transform &
+ */
+const Transform & Instance::GetTransform() {
+	return _transform;
+}
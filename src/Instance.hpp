@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "BVH.hpp"
+#include "Geometry.hpp"
+#include "Material.hpp"
+#include "RayHit.hpp"
+#include "Transform.hpp"
+#include "Vector.hpp"
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: Instance
+ * Purpose: One placement of a mesh defined once in the scene.  The mesh has a hierarchy of its own that every
+ *          instance of it shares, rays are moved into the space of the mesh and traced through that hierarchy.  An
+ *          instance only stores its transform, so the memory of the scene grows with the unique meshes and not
+ *          with the copies of them
+ */
+class Instance : public Geometry {
+
+	public :
+		Instance(BVH * hierarchy, int prototype, Transform transform, materialId material = MATERIAL_DEFAULT);
+		bool Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		bool Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		Vec3<float> GetRandomPoint();
+		BoundingBox GetBoundingBox();
+		void Translate(Vec3<float> offset);
+
+		int GetPrototype();
+		const Transform & GetTransform();
+
+	private :
+		BVH * _hierarchy;
+		int _prototype;
+		Transform _transform;
+		Transform _inverse;
+
+		typedef Geometry super;
+};
@@ -0,0 +1,157 @@
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Date: 10/17/26
+ * Function Name: MappedFile (constructor)
+ * Arguments:
+ *     void
+ * Purpose: Constructor.  Nothing is mapped until Open is called
+ * Return Value: void
+ */
+#ifdef _WIN32
+MappedFile::MappedFile() : _data(NULL), _size(0), _file(INVALID_HANDLE_VALUE), _mapping(NULL) {
+}
+#else
+MappedFile::MappedFile() : _data(NULL), _size(0), _file(-1) {
+}
+#endif
+
+/*
+ * Date: 10/17/26
+ * Function Name: ~MappedFile
+ * Arguments:
+ *     void
+ * Purpose: Destructor.  Unmaps the file
+ * Return Value: void
+ */
+MappedFile::~MappedFile() {
+	Close();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Open
+ * Arguments:
+ *     std::string - the file to map
+ * Purpose: Maps the whole file into memory for reading
+ * Return Value: bool - false if the file does not exist, is empty or could not be mapped
+ */
+bool MappedFile::Open(std::string fileName) {
+	Close();
+
+#ifdef _WIN32
+	_file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (_file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0) {
+		Close();
+		return false;
+	}
+
+	_mapping = CreateFileMappingA(_file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (_mapping == NULL) {
+		Close();
+		return false;
+	}
+
+	_data = (const unsigned char *) MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+	if (_data == NULL) {
+		Close();
+		return false;
+	}
+	_size = (size_t)size.QuadPart;
+#else
+	_file = open(fileName.c_str(), O_RDONLY);
+	if (_file < 0) {
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(_file, &info) != 0 || info.st_size == 0) {
+		Close();
+		return false;
+	}
+
+	void * data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, _file, 0);
+	if (data == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	_data = (const unsigned char *) data;
+	_size = (size_t)info.st_size;
+#endif
+
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Close
+ * Arguments:
+ *     void
+ * Purpose: Unmaps and closes the file.  Pointers from GetData are invalid afterwards
+ * Return Value: void
+ */
+void MappedFile::Close() {
+#ifdef _WIN32
+	if (_data != NULL) {
+		UnmapViewOfFile(_data);
+	}
+	if (_mapping != NULL) {
+		CloseHandle(_mapping);
+	}
+	if (_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(_file);
+	}
+	_mapping = NULL;
+	_file = INVALID_HANDLE_VALUE;
+#else
+	if (_data != NULL) {
+		munmap((void *)_data, _size);
+	}
+	if (_file >= 0) {
+		close(_file);
+	}
+	_file = -1;
+#endif
+	_data = NULL;
+	_size = 0;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetData
+ * Arguments:
+ *     void
+ * Purpose: Returns the start of the mapped file
+ * Return Value: const unsigned char * - null if nothing is mapped
+ */
+const unsigned char * MappedFile::GetData() {
+	return _data;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetSize
+ * Arguments:
+ *     void
+ * Purpose: Returns the size of the mapped file in bytes
+ * Return Value: size_t
+ */
+size_t MappedFile::GetSize() {
+	return _size;
+}
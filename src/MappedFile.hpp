@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stddef.h>
+#include <string>
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: MappedFile
+ * Purpose: A read only memory mapping of a whole file.  The pages are only read from disk when they are touched
+ */
+class MappedFile {
+
+	public :
+		MappedFile();
+		~MappedFile();
+
+		bool Open(std::string fileName);
+		void Close();
+		const unsigned char * GetData();
+		size_t GetSize();
+
+	private :
+		MappedFile(const MappedFile &);
+		MappedFile & operator=(const MappedFile &);
+
+		const unsigned char * _data;
+		size_t _size;
+#ifdef _WIN32
+		void * _file; // HANDLE, windows.h stays out of the header
+		void * _mapping;
+#else
+		int _file;
+#endif
+};
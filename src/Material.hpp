@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 /*
  * Author: Ben Vesel
  * Date: 12/20/16
@@ -11,3 +13,9 @@ enum Material {
 	MATERIAL_GLASS,
 	MATERIAL_NONE
 };
+
+// Index of an entry of the scene's MaterialTable.  Primitives and hit records store this instead of their color and
+// material
+typedef uint16_t materialId;
+
+#define MATERIAL_DEFAULT 0 // White and MATERIAL_NONE, the material of geometry that is not given one (points)
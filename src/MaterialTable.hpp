@@ -0,0 +1,139 @@
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "Arena.hpp"
+#include "Material.hpp"
+#include "Vector.hpp"
+
+#define MATERIAL_TABLE_SIZE 65536 // Materials a scene can have, one for every value of materialId
+
+// Everything the shading needs to know about a surface.  The reflectivity and index of refraction are not read by
+// the renderer yet, they are filled in from the material type
+typedef struct {
+	Vec3<unsigned char> color;
+	Material type;
+	float reflectivity;
+	float ior;
+} materialEntry;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: MaterialTable
+ * Purpose: The materials of a scene in one flat array, stored in the arena of the scene.  Geometry with the same
+ *          color and material type shares an entry, so primitives and hit records only carry its index
+ */
+class MaterialTable {
+
+	public :
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: MaterialTable (constructor)
+		 * Arguments:
+		 *     Arena * - the arena of the scene the table is stored in, NULL to store it on the heap
+		 * Purpose: Constructor.  Adds the default material
+		 * Return Value: void
+		 */
+		MaterialTable(Arena * arena = NULL) : _entries(ArenaAllocator<materialEntry>(arena)), _lookup(std::less<uint32_t>(), ArenaAllocator<std::pair<const uint32_t, materialId> >(arena)) {
+			Clear();
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: SetArena
+		 * Arguments:
+		 *     Arena * - the arena of the scene, NULL to store the table on the heap
+		 * Purpose: Moves the table to another arena.  Every material but the default one is removed
+		 * Return Value: void
+		 */
+		void SetArena(Arena * arena) {
+			std::vector<materialEntry, ArenaAllocator<materialEntry> >(ArenaAllocator<materialEntry>(arena)).swap(_entries);
+			materialLookup(std::less<uint32_t>(), ArenaAllocator<std::pair<const uint32_t, materialId> >(arena)).swap(_lookup);
+			Clear();
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Clear
+		 * Arguments:
+		 *     void
+		 * Purpose: Removes every material but the default one
+		 * Return Value: void
+		 */
+		void Clear() {
+			_entries.clear();
+			_lookup.clear();
+			Add(Vec3<unsigned char>::vec3(255, 255, 255), MATERIAL_NONE);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Add
+		 * Arguments:
+		 *     Vec3<unsigned char> - the color of the surface
+		 *     Material            - the material type of the surface
+		 * Purpose: Returns the entry with the color and type, adding it if the scene does not have it yet.  Only
+		 *          called while loading, the table must not change while the scene is rendered
+		 * Return Value: materialId
+		 */
+		materialId Add(Vec3<unsigned char> color, Material type) {
+			uint32_t key = ((uint32_t)color.x << 24) | ((uint32_t)color.y << 16) | ((uint32_t)color.z << 8) | (uint32_t)type;
+			materialLookup::iterator found = _lookup.find(key);
+			if (found != _lookup.end()) {
+				return found->second;
+			}
+
+			if (_entries.size() >= MATERIAL_TABLE_SIZE) {
+				std::cout << "The scene has more than " << MATERIAL_TABLE_SIZE << " materials.  Exiting" << std::endl;
+				exit(10);
+			}
+
+			materialEntry entry;
+			entry.color = color;
+			entry.type = type;
+			entry.reflectivity = type == MATERIAL_REFLECTIVE ? 1.f : 0.f;
+			entry.ior = type == MATERIAL_GLASS ? 1.5f : 1.f;
+
+			materialId id = (materialId)_entries.size();
+			_entries.push_back(entry);
+			_lookup[key] = id;
+			return id;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Get
+		 * Arguments:
+		 *     materialId - the entry
+		 * Purpose: Gets an entry of the table
+		 * Return Value: const materialEntry &
+		 */
+		const materialEntry & Get(materialId id) const {
+			return _entries[id];
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetCount
+		 * Arguments:
+		 *     void
+		 * Purpose: Returns the number of entries, including the default one
+		 * Return Value: int
+		 */
+		int GetCount() const {
+			return (int)_entries.size();
+		}
+
+	private :
+		typedef std::map<uint32_t, materialId, std::less<uint32_t>, ArenaAllocator<std::pair<const uint32_t, materialId> > > materialLookup;
+
+		std::vector<materialEntry, ArenaAllocator<materialEntry> > _entries;
+		materialLookup _lookup;
+};
@@ -0,0 +1,272 @@
+#include "Mesh.hpp"
+
+/*
+ * Date: 10/17/26
+ * Function Name: Mesh (constructor)
+ * Arguments:
+ *     Vec3<float> * - the shared vertices.  Must stay valid as long as the mesh, Translate moves them in place
+ *     int           - the number of vertices
+ *     const int *   - three vertex indices per triangle.  Must stay valid as long as the mesh
+ *     int           - the number of indices, a partial triangle at the end is ignored
+ *     materialId    - the entry of the material table of the mesh
+ * Purpose: Constructor.  The indices must be in range of the vertices
+ * Return Value: void
+ */
+Mesh::Mesh(Vec3<float> * vertices, int vertexCount, const int * indices, int indexCount, materialId material) : super(MESH), _vertices(vertices), _indices(indices),
+                                                                                                                 _vertexCount(vertexCount), _indexCount(indexCount - indexCount % 3) {
+	SetMaterialId(material);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: HitTime
+ * Arguments:
+ *     int         - the triangle
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     float       - hits before this time are ignored
+ *     float       - hits at or after this time are ignored
+ *     float &     - set to the time of the hit
+ * Purpose: Same intersection as Triangle::Intersect on the shared vertices
+ * Return Value: bool - true if the ray hits the triangle between the two times
+ */
+bool Mesh::HitTime(int index, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime, float &time) {
+	const Vec3<float> &vertexA = _vertices[_indices[3 * index]];
+	const Vec3<float> &vertexB = _vertices[_indices[3 * index + 1]];
+	const Vec3<float> &vertexC = _vertices[_indices[3 * index + 2]];
+
+	float A = vertexA.x - vertexB.x;
+	float B = vertexA.y - vertexB.y;
+	float C = vertexA.z - vertexB.z;
+	float D = vertexA.x - vertexC.x;
+	float E = vertexA.y - vertexC.y;
+	float F = vertexA.z - vertexC.z;
+
+	float G = ray.x;
+	float H = ray.y;
+	float I = ray.z;
+
+	float J = vertexA.x - startingPos.x;
+	float K = vertexA.y - startingPos.y;
+	float L = vertexA.z - startingPos.z;
+
+	float M = A * (E * I - H * F) + B * (G * F - D * I) + C * (D * H - E * G);
+	float t = (-1 * (F * (A * K - J * B) + E * (J * C - A * L) + D * (B * L - K * C) ) ) / M;
+
+	if( !(t >= minTime && t < maxTime) ) {
+		return false;
+	}
+	float gamma = (I * (A * K - J * B) + H * (J * C - A * L) + G * (B * L - K * C)) / M;
+
+	if( gamma < 0 || gamma > 1 ) {
+		return false;
+	}
+	float beta = (J * (E * I - H * F) + K * (G * F - D * I) + L * (D * H - E * G)) / M;
+
+	if( beta < 0 || beta > 1 - gamma ) {
+		return false;
+	}
+
+	time = t;
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Intersect
+ * Arguments:
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     RayHit &    - the hit record holding the closest hit so far
+ * Purpose: Intersects every triangle of the mesh.  The acceleration structure uses IntersectPrimitive instead
+ * Return Value: bool - true if the hit record was updated
+ */
+bool Mesh::Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+	bool hit = false;
+	for (int i = 0; i < GetTriangleCount(); i++) {
+		hit |= IntersectPrimitive(i, ray, startingPos, rayHit);
+	}
+	return hit;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Occluded
+ * Arguments:
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Tests every triangle of the mesh.  The acceleration structure uses OccludedPrimitive instead
+ * Return Value: bool
+ */
+bool Mesh::Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	for (int i = 0; i < GetTriangleCount(); i++) {
+		if (OccludedPrimitive(i, ray, startingPos, minTime, maxTime)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetBoundingBox
+ * Arguments:
+ *     void
+ * Purpose: Gets the bounds of every vertex
+ * Return Value: BoundingBox
+ */
+BoundingBox Mesh::GetBoundingBox() {
+	BoundingBox box;
+	for (int i = 0; i < _vertexCount; i++) {
+		box.Expand(_vertices[i]);
+	}
+	return box;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPrimitiveCount
+ * Arguments:
+ *     void
+ * Purpose: Every triangle is bounded separately
+ * Return Value: int
+ */
+int Mesh::GetPrimitiveCount() {
+	return GetTriangleCount();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPrimitiveBounds
+ * Arguments:
+ *     int - the triangle
+ * Purpose: Gets the bounds of one triangle
+ * Return Value: BoundingBox
+ */
+BoundingBox Mesh::GetPrimitiveBounds(int index) {
+	BoundingBox box;
+	box.Expand(_vertices[_indices[3 * index]]);
+	box.Expand(_vertices[_indices[3 * index + 1]]);
+	box.Expand(_vertices[_indices[3 * index + 2]]);
+	return box;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: IntersectPrimitive
+ * Arguments:
+ *     int         - the triangle
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     RayHit &    - the hit record holding the closest hit so far
+ * Purpose: Intersects one triangle.  The normal is only computed for hits that are kept
+ * Return Value: bool - true if the hit record was updated
+ */
+bool Mesh::IntersectPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+	float t;
+	if (!HitTime(index, ray, startingPos, 0, rayHit.GetTime(), t)) {
+		return false;
+	}
+
+	Vec3<float> vertexA = _vertices[_indices[3 * index]];
+	Vec3<float> vertexB = _vertices[_indices[3 * index + 1]];
+	Vec3<float> vertexC = _vertices[_indices[3 * index + 2]];
+	Vec3<float> normal = Vec3<float>::Normalize(Vec3<float>::Cross(vertexB - vertexA, vertexC - vertexA));
+
+	Vec3<float> hitLocation = Vec3<float>::Add(Vec3<float>::vec3(t * ray.x, t * ray.y, t* ray.z), startingPos);
+	rayHit.SetHit(t, GetMaterialId(), normal, Vec3<float>::vec3(0, 0, 0) - normal, hitLocation, ray);
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: OccludedPrimitive
+ * Arguments:
+ *     int         - the triangle
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Tests one triangle for shadow rays
+ * Return Value: bool
+ */
+bool Mesh::OccludedPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	float t;
+	return HitTime(index, ray, startingPos, minTime, maxTime, t) && t > minTime;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetTriangles
+ * Arguments:
+ *     int           - the triangle
+ *     Vec3<float> * - filled with its three vertices
+ * Purpose: Gets one triangle for the packet intersection
+ * Return Value: int - 1
+ */
+int Mesh::GetTriangles(int index, Vec3<float> * vertices) {
+	vertices[0] = _vertices[_indices[3 * index]];
+	vertices[1] = _vertices[_indices[3 * index + 1]];
+	vertices[2] = _vertices[_indices[3 * index + 2]];
+	return 1;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetVertexCount
+ * Arguments:
+ *     void
+ * Return Value: int
+ */
+int Mesh::GetVertexCount() {
+	return _vertexCount;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetTriangleCount
+ * Arguments:
+ *     void
+ * Return Value: int
+ */
+int Mesh::GetTriangleCount() {
+	return _indexCount / 3;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetVertices
+ * Arguments:
+ *     void
+ * Return Value: const Vec3<float> * - GetVertexCount vertices
+ */
+const Vec3<float> * Mesh::GetVertices() {
+	return _vertices;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetIndices
+ * Arguments:
+ *     void
+ * Return Value: const int * - three vertex indices for each of the GetTriangleCount triangles
+ */
+const int * Mesh::GetIndices() {
+	return _indices;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Translate
+ * Arguments:
+ *     Vec3<float> - the offset
+ * Purpose: Moves every vertex of the mesh
+ * Return Value: void
+ */
+void Mesh::Translate(Vec3<float> offset) {
+	for (int i = 0; i < _vertexCount; i++) {
+		_vertices[i] = _vertices[i] + offset;
+	}
+}
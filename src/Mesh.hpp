@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "Geometry.hpp"
+#include "Material.hpp"
+#include "RayHit.hpp"
+#include "Vector.hpp"
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: Mesh
+ * Purpose: Triangles sharing one vertex array.  Every triangle is three indices into the array so a vertex used
+ *          by several triangles is only stored once.  The triangles are bounded separately in the acceleration
+ *          structure.  The arrays belong to the scene (they live in its arena), the mesh only points at them
+ */
+class Mesh : public Geometry {
+
+	public :
+		Mesh(Vec3<float> * vertices, int vertexCount, const int * indices, int indexCount, materialId material = MATERIAL_DEFAULT);
+		bool Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		bool Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		BoundingBox GetBoundingBox();
+
+		int GetPrimitiveCount();
+		BoundingBox GetPrimitiveBounds(int index);
+		bool IntersectPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		bool OccludedPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		int GetTriangles(int index, Vec3<float> * vertices);
+		void Translate(Vec3<float> offset);
+
+		int GetVertexCount();
+		int GetTriangleCount();
+		const Vec3<float> * GetVertices();
+		const int * GetIndices();
+
+	private :
+		bool HitTime(int index, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime, float &time);
+
+		Vec3<float> * _vertices;
+		const int * _indices;
+		int _vertexCount;
+		int _indexCount;
+
+		typedef Geometry super;
+};
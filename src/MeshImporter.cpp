@@ -0,0 +1,651 @@
+/* Standard libs */
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdint.h>
+
+/* Project headers */
+#include "MeshImporter.hpp"
+#include "MappedFile.hpp"
+
+// Scalar types of a PLY property
+enum ply_type {
+	PLY_INT8,
+	PLY_UINT8,
+	PLY_INT16,
+	PLY_UINT16,
+	PLY_INT32,
+	PLY_UINT32,
+	PLY_FLOAT32,
+	PLY_FLOAT64,
+	PLY_UNKNOWN
+};
+
+// What a PLY property is used for
+enum ply_role {
+	PLY_ROLE_NONE,
+	PLY_ROLE_X,
+	PLY_ROLE_Y,
+	PLY_ROLE_Z,
+	PLY_ROLE_FACE
+};
+
+typedef struct {
+	std::string name;
+	ply_type type;
+	bool isList;
+	ply_type countType;
+	ply_role role;
+} plyProperty;
+
+typedef struct {
+	std::string name;
+	long long count;
+	std::vector<plyProperty> properties;
+} plyElement;
+
+/*
+ * Date: 10/17/26
+ * Function Name: IsLineSpace
+ * Arguments:
+ *     char - the character
+ * Purpose: Returns true for the white space that separates tokens within a line
+ * Return Value: bool
+ */
+static inline bool IsLineSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SkipLineSpace
+ * Arguments:
+ *     const char *& - the position, moved past the white space
+ *     const char *  - the end of the data
+ * Purpose: Skips the white space before the next token of a line
+ * Return Value: void
+ */
+static inline void SkipLineSpace(const char *&p, const char * end) {
+	while (p < end && IsLineSpace(*p)) {
+		p++;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SkipLine
+ * Arguments:
+ *     const char *& - the position, moved to the start of the next line
+ *     const char *  - the end of the data
+ * Purpose: Skips the rest of the current line
+ * Return Value: void
+ */
+static inline void SkipLine(const char *&p, const char * end) {
+	const char * newline = (const char *) memchr(p, '\n', end - p);
+	p = newline ? newline + 1 : end;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ParseFloat
+ * Arguments:
+ *     const char *& - the position, moved past the number
+ *     const char *  - the end of the data
+ *     float &       - set to the number
+ * Purpose: Reads a decimal number ([-]digits[.digits][e[-]digits]).  Much faster than atof/strtod since it does
+ *          not deal with locales
+ * Return Value: bool - false if there is no number at the position
+ */
+static bool ParseFloat(const char *&p, const char * end, float &value) {
+	static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	SkipLineSpace(p, end);
+
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		p++;
+	}
+
+	unsigned long long mantissa = 0;
+	int exponent = 0;
+	int digits = 0;
+	for (; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+		if (mantissa < 100000000000000000ULL) {
+			mantissa = mantissa * 10 + (*p - '0');
+		} else {
+			exponent++;
+		}
+	}
+	if (p < end && *p == '.') {
+		for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+			if (mantissa < 100000000000000000ULL) {
+				mantissa = mantissa * 10 + (*p - '0');
+				exponent--;
+			}
+		}
+	}
+	if (digits == 0) {
+		return false;
+	}
+
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		p++;
+		bool negativeExponent = false;
+		if (p < end && (*p == '-' || *p == '+')) {
+			negativeExponent = *p == '-';
+			p++;
+		}
+		int power = 0;
+		for (; p < end && *p >= '0' && *p <= '9'; p++) {
+			if (power < 10000) {
+				power = power * 10 + (*p - '0');
+			}
+		}
+		exponent += negativeExponent ? -power : power;
+	}
+
+	double result = (double)mantissa;
+	if (exponent < 0) {
+		result = -exponent <= 22 ? result / powers[-exponent] : result * pow(10.0, exponent);
+	} else if (exponent > 0) {
+		result = exponent <= 22 ? result * powers[exponent] : result * pow(10.0, exponent);
+	}
+
+	value = (float)(negative ? -result : result);
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ParseInt
+ * Arguments:
+ *     const char *& - the position, moved past the number
+ *     const char *  - the end of the data
+ *     long long &   - set to the number
+ * Purpose: Reads an optionally signed integer
+ * Return Value: bool - false if there is no number at the position
+ */
+static bool ParseInt(const char *&p, const char * end, long long &value) {
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		p++;
+	}
+
+	const char * start = p;
+	long long result = 0;
+	for (; p < end && *p >= '0' && *p <= '9'; p++) {
+		if (result < 1000000000000LL) {
+			result = result * 10 + (*p - '0');
+		}
+	}
+
+	value = negative ? -result : result;
+	return p != start;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddPolygon
+ * Arguments:
+ *     std::vector<int> & - the corners of the polygon
+ *     std::vector<int> & - the triangle index array
+ * Purpose: Splits a convex polygon into a fan of triangles
+ * Return Value: void
+ */
+static void AddPolygon(std::vector<int> &polygon, std::vector<int> &indices) {
+	for (size_t i = 1; i + 1 < polygon.size(); i++) {
+		indices.push_back(polygon[0]);
+		indices.push_back(polygon[i]);
+		indices.push_back(polygon[i + 1]);
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Load
+ * Arguments:
+ *     std::string                 - the model file (.obj or .ply)
+ *     std::vector<Vec3<float> > & - the vertices of the model are appended to it
+ *     std::vector<int> &          - three indices per triangle are appended to it
+ *     std::string &               - set to the reason if the file could not be read
+ * Purpose: Reads a model.  The format is picked by the contents (PLY files start with "ply"), everything else
+ *          is read as OBJ
+ * Return Value: bool - false if the file could not be read
+ */
+bool MeshImporter::Load(std::string fileName, std::vector<Vec3<float> > &vertices, std::vector<int> &indices, std::string &error) {
+	MappedFile file;
+	if (!file.Open(fileName)) {
+		error = "could not open the file";
+		return false;
+	}
+
+	const char * data = (const char *) file.GetData();
+	size_t size = file.GetSize();
+
+	if (size >= 3 && !strncmp(data, "ply", 3)) {
+		return LoadPLY(data, size, vertices, indices, error);
+	}
+	return LoadOBJ(data, size, vertices, indices, error);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadOBJ
+ * Arguments:
+ *     const char *                - the file contents
+ *     size_t                      - the size of the contents
+ *     std::vector<Vec3<float> > & - the vertices are appended to it
+ *     std::vector<int> &          - three indices per triangle are appended to it
+ *     std::string &               - set to the reason if the file could not be read
+ * Purpose: Reads the "v" and "f" lines of a Wavefront OBJ file.  Faces with more than three corners are split
+ *          into fans, texture and normal indices are ignored and negative indices count back from the last vertex
+ * Return Value: bool
+ */
+bool MeshImporter::LoadOBJ(const char * data, size_t size, std::vector<Vec3<float> > &vertices, std::vector<int> &indices, std::string &error) {
+	const char * p = data;
+	const char * end = data + size;
+	std::vector<int> polygon;
+	int line = 1;
+	long long firstVertex = (long long)vertices.size();
+	size_t firstIndex = indices.size();
+
+	while (p < end) {
+		SkipLineSpace(p, end);
+
+		if (end - p > 1 && p[0] == 'v' && IsLineSpace(p[1])) {
+			p++;
+			Vec3<float> vertex;
+			if (!ParseFloat(p, end, vertex.x) || !ParseFloat(p, end, vertex.y) || !ParseFloat(p, end, vertex.z)) {
+				std::ostringstream message;
+				message << "bad vertex on line " << line;
+				error = message.str();
+				return false;
+			}
+			vertices.push_back(vertex);
+		}
+		else if (end - p > 1 && p[0] == 'f' && IsLineSpace(p[1])) {
+			p++;
+			polygon.clear();
+			for (;;) {
+				SkipLineSpace(p, end);
+				if (p >= end || *p == '\n' || *p == '#') {
+					break;
+				}
+
+				long long index;
+				if (!ParseInt(p, end, index)) {
+					std::ostringstream message;
+					message << "bad face on line " << line;
+					error = message.str();
+					return false;
+				}
+
+				// Skip the texture and normal indices (v/vt/vn, v//vn)
+				while (p < end && !IsLineSpace(*p) && *p != '\n') {
+					p++;
+				}
+
+				long long resolved = index > 0 ? firstVertex + index - 1 : (long long)vertices.size() + index;
+				if (index == 0 || resolved < firstVertex || resolved >= (long long)vertices.size()) {
+					std::ostringstream message;
+					message << "face on line " << line << " uses a vertex that was not defined before it";
+					error = message.str();
+					return false;
+				}
+				polygon.push_back((int)resolved);
+			}
+			AddPolygon(polygon, indices);
+		}
+
+		SkipLine(p, end);
+		line++;
+	}
+
+	if (indices.size() == firstIndex) {
+		error = "no faces found";
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPLYType
+ * Arguments:
+ *     std::string - the type name from the header
+ * Purpose: Converts both spellings of the PLY type names (uchar and uint8) to the type
+ * Return Value: ply_type
+ */
+static ply_type GetPLYType(std::string name) {
+	if (name == "char" || name == "int8") {
+		return PLY_INT8;
+	}
+	if (name == "uchar" || name == "uint8") {
+		return PLY_UINT8;
+	}
+	if (name == "short" || name == "int16") {
+		return PLY_INT16;
+	}
+	if (name == "ushort" || name == "uint16") {
+		return PLY_UINT16;
+	}
+	if (name == "int" || name == "int32") {
+		return PLY_INT32;
+	}
+	if (name == "uint" || name == "uint32") {
+		return PLY_UINT32;
+	}
+	if (name == "float" || name == "float32") {
+		return PLY_FLOAT32;
+	}
+	if (name == "double" || name == "float64") {
+		return PLY_FLOAT64;
+	}
+	return PLY_UNKNOWN;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPLYSize
+ * Arguments:
+ *     ply_type - the type
+ * Purpose: Returns the size in bytes of a PLY type
+ * Return Value: size_t
+ */
+static size_t GetPLYSize(ply_type type) {
+	switch (type) {
+		case PLY_INT8 :
+		case PLY_UINT8 :
+			return 1;
+		case PLY_INT16 :
+		case PLY_UINT16 :
+			return 2;
+		case PLY_INT32 :
+		case PLY_UINT32 :
+		case PLY_FLOAT32 :
+			return 4;
+		case PLY_FLOAT64 :
+			return 8;
+		default :
+			return 0;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ReadPLYValue
+ * Arguments:
+ *     const unsigned char * - the value in the file
+ *     ply_type              - its type
+ *     bool                  - true if the bytes must be swapped (file and machine endianness differ)
+ * Purpose: Reads one binary value of any PLY type
+ * Return Value: double
+ */
+static double ReadPLYValue(const unsigned char * p, ply_type type, bool swap) {
+	unsigned char bytes[8];
+	size_t size = GetPLYSize(type);
+	for (size_t i = 0; i < size; i++) {
+		bytes[i] = swap ? p[size - 1 - i] : p[i];
+	}
+
+	switch (type) {
+		case PLY_INT8 : {
+			int8_t value;
+			memcpy(&value, bytes, 1);
+			return value;
+		}
+		case PLY_UINT8 :
+			return bytes[0];
+		case PLY_INT16 : {
+			int16_t value;
+			memcpy(&value, bytes, 2);
+			return value;
+		}
+		case PLY_UINT16 : {
+			uint16_t value;
+			memcpy(&value, bytes, 2);
+			return value;
+		}
+		case PLY_INT32 : {
+			int32_t value;
+			memcpy(&value, bytes, 4);
+			return value;
+		}
+		case PLY_UINT32 : {
+			uint32_t value;
+			memcpy(&value, bytes, 4);
+			return value;
+		}
+		case PLY_FLOAT32 : {
+			float value;
+			memcpy(&value, bytes, 4);
+			return value;
+		}
+		case PLY_FLOAT64 : {
+			double value;
+			memcpy(&value, bytes, 8);
+			return value;
+		}
+		default :
+			return 0;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadPLY
+ * Arguments:
+ *     const char *                - the file contents
+ *     size_t                      - the size of the contents
+ *     std::vector<Vec3<float> > & - the vertices are appended to it
+ *     std::vector<int> &          - three indices per triangle are appended to it
+ *     std::string &               - set to the reason if the file could not be read
+ * Purpose: Reads the x, y and z properties of the "vertex" element and the index list of the "face" element of a
+ *          binary (either endianness) PLY file.  Every other element and property is skipped
+ * Return Value: bool
+ */
+bool MeshImporter::LoadPLY(const char * data, size_t size, std::vector<Vec3<float> > &vertices, std::vector<int> &indices, std::string &error) {
+	const char * p = data;
+	const char * end = data + size;
+	std::vector<plyElement> elements;
+	bool bigEndian = false;
+	bool headerDone = false;
+
+	// The header is text, one keyword per line
+	SkipLine(p, end);
+	while (p < end && !headerDone) {
+		const char * lineEnd = (const char *) memchr(p, '\n', end - p);
+		if (!lineEnd) {
+			lineEnd = end;
+		}
+		std::istringstream line(std::string(p, lineEnd));
+		p = lineEnd < end ? lineEnd + 1 : end;
+
+		std::string keyword;
+		line >> keyword;
+		if (keyword == "format") {
+			std::string format;
+			line >> format;
+			if (format == "binary_big_endian") {
+				bigEndian = true;
+			} else if (format != "binary_little_endian") {
+				error = "only binary PLY files are supported (format " + format + ")";
+				return false;
+			}
+		}
+		else if (keyword == "element") {
+			plyElement element;
+			element.count = 0;
+			line >> element.name >> element.count;
+			elements.push_back(element);
+		}
+		else if (keyword == "property") {
+			if (elements.empty()) {
+				error = "property before the first element";
+				return false;
+			}
+
+			plyProperty property;
+			std::string type;
+			line >> type;
+			property.isList = type == "list";
+			property.countType = PLY_UNKNOWN;
+			if (property.isList) {
+				std::string countType;
+				line >> countType >> type;
+				property.countType = GetPLYType(countType);
+			}
+			property.type = GetPLYType(type);
+			line >> property.name;
+
+			// Work out once what the property is used for instead of comparing names for every value
+			property.role = PLY_ROLE_NONE;
+			if (elements.back().name == "vertex" && !property.isList) {
+				if (property.name == "x") {
+					property.role = PLY_ROLE_X;
+				} else if (property.name == "y") {
+					property.role = PLY_ROLE_Y;
+				} else if (property.name == "z") {
+					property.role = PLY_ROLE_Z;
+				}
+			} else if (elements.back().name == "face" && property.isList && (property.name == "vertex_indices" || property.name == "vertex_index")) {
+				property.role = PLY_ROLE_FACE;
+			}
+
+			if (property.type == PLY_UNKNOWN || (property.isList && property.countType == PLY_UNKNOWN)) {
+				error = "unknown type of property " + property.name;
+				return false;
+			}
+			elements.back().properties.push_back(property);
+		}
+		else if (keyword == "end_header") {
+			headerDone = true;
+		}
+	}
+	if (!headerDone) {
+		error = "missing end_header";
+		return false;
+	}
+
+	uint16_t endianTest = 1;
+	bool machineBigEndian = *(unsigned char *)&endianTest == 0;
+	bool swap = bigEndian != machineBigEndian;
+
+	const unsigned char * position = (const unsigned char *) p;
+	const unsigned char * dataEnd = (const unsigned char *) end;
+	std::vector<int> polygon;
+	int firstVertex = (int)vertices.size();
+	size_t firstIndex = indices.size();
+	long long vertexCount = 0;
+
+	// Check the counts before anything is reserved for them.  Every row holds at least its fixed size properties and
+	// the counts of its lists, so a count that cannot fit in the rest of the file is corrupt
+	for (size_t e = 0; e < elements.size(); e++) {
+		plyElement &element = elements[e];
+		size_t rowBytes = 0;
+		for (size_t j = 0; j < element.properties.size(); j++) {
+			plyProperty &property = element.properties[j];
+			rowBytes += GetPLYSize(property.isList ? property.countType : property.type);
+		}
+
+		if (element.count < 0 || element.count > INT_MAX) {
+			error = "element " + element.name + " has an invalid count";
+			return false;
+		}
+		if (element.count > 0 && (rowBytes == 0 || (unsigned long long)element.count > (size_t)(end - p) / rowBytes)) {
+			error = "element " + element.name + " has more rows than the file holds";
+			return false;
+		}
+		if (element.name == "vertex") {
+			vertexCount = element.count;
+		}
+	}
+	if (vertexCount > INT_MAX - firstVertex) {
+		error = "too many vertices";
+		return false;
+	}
+
+	for (size_t e = 0; e < elements.size(); e++) {
+		plyElement &element = elements[e];
+		bool isVertex = element.name == "vertex";
+		bool isFace = element.name == "face";
+
+		if (isVertex) {
+			vertices.reserve(vertices.size() + (size_t)element.count);
+		} else if (isFace) {
+			indices.reserve(indices.size() + 3 * (size_t)element.count);
+		}
+
+		for (long long i = 0; i < element.count; i++) {
+			Vec3<float> vertex(0, 0, 0);
+
+			for (size_t j = 0; j < element.properties.size(); j++) {
+				plyProperty &property = element.properties[j];
+				size_t valueSize = GetPLYSize(property.type);
+
+				if (!property.isList) {
+					if ((size_t)(dataEnd - position) < valueSize) {
+						error = "the file ends early";
+						return false;
+					}
+					if (property.role == PLY_ROLE_X) {
+						vertex.x = (float)ReadPLYValue(position, property.type, swap);
+					} else if (property.role == PLY_ROLE_Y) {
+						vertex.y = (float)ReadPLYValue(position, property.type, swap);
+					} else if (property.role == PLY_ROLE_Z) {
+						vertex.z = (float)ReadPLYValue(position, property.type, swap);
+					}
+					position += valueSize;
+					continue;
+				}
+
+				size_t countSize = GetPLYSize(property.countType);
+				if ((size_t)(dataEnd - position) < countSize) {
+					error = "the file ends early";
+					return false;
+				}
+				double countValue = ReadPLYValue(position, property.countType, swap);
+				position += countSize;
+				if (!(countValue >= 0 && countValue <= (double)((size_t)(dataEnd - position) / valueSize))) {
+					error = "the file ends early";
+					return false;
+				}
+				long long count = (long long)countValue;
+
+				if (property.role == PLY_ROLE_FACE) {
+					polygon.clear();
+					for (long long k = 0; k < count; k++) {
+						double index = ReadPLYValue(position + k * valueSize, property.type, swap);
+						if (!(index >= 0 && index < (double)vertexCount)) {
+							error = "a face uses a vertex that does not exist";
+							return false;
+						}
+						polygon.push_back(firstVertex + (int)index);
+					}
+					AddPolygon(polygon, indices);
+				}
+				position += (size_t)count * valueSize;
+			}
+
+			if (isVertex) {
+				vertices.push_back(vertex);
+			}
+		}
+	}
+
+	for (size_t i = firstIndex; i < indices.size(); i++) {
+		if (indices[i] < firstVertex || indices[i] >= (int)vertices.size()) {
+			error = "a face uses a vertex that does not exist";
+			return false;
+		}
+	}
+	if (indices.size() == firstIndex) {
+		error = "no faces found";
+		return false;
+	}
+	return true;
+}
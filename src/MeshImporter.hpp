@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "Vector.hpp"
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: MeshImporter
+ * Purpose: Reads Wavefront OBJ and binary PLY models straight into the shared vertex and index arrays of a mesh.
+ *          The file is memory mapped and parsed in one pass without building any intermediate strings
+ */
+class MeshImporter {
+
+	public :
+		static bool Load(std::string fileName, std::vector<Vec3<float> > &vertices, std::vector<int> &indices, std::string &error);
+
+	private :
+		static bool LoadOBJ(const char * data, size_t size, std::vector<Vec3<float> > &vertices, std::vector<int> &indices, std::string &error);
+		static bool LoadPLY(const char * data, size_t size, std::vector<Vec3<float> > &vertices, std::vector<int> &indices, std::string &error);
+};
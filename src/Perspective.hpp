@@ -29,18 +29,19 @@ class Perspective {
      * Purpose: Constructor
      * Return Value: void (Constructor)
      */
-    Perspective(Config config, std::string fileName) : _unitsPerLengthPixel(0), _unitsPerHeightPixel(0), _imagePlane(nullptr), _secondaryImagePlane(nullptr), _cameraPosition(0, 0, 0), _intereyeDistance(0), _anaglyphMode(ANAGLYPH_NONE) {
-        
-        
-        tinyxml2::XMLDocument doc;
-        doc.LoadFile(fileName.c_str());
-        
-        // Parse the xml document
-        if (doc.Error()) {
-            std::cout << "There was an error parsing " << fileName << std::endl;
-            doc.PrintError();
-            exit(1);
-        }
+    Perspective() : _unitsPerLengthPixel(0), _unitsPerHeightPixel(0), _imagePlane(nullptr), _secondaryImagePlane(nullptr), _cameraPosition(0, 0, 0), _intereyeDistance(0), _anaglyphMode(ANAGLYPH_NONE) {
+    }
+    
+    /*
+     * Date: 10/17/26
+     * Function Name: Load
+     * Arguments:
+     *      Config                - the configuration of the scene
+     *      tinyxml2::XMLDocument - the parsed scene document
+     * Purpose: Reads the camera and image plane(s) of the "image_plane" section
+     * Return Value: void
+     */
+    void Load(Config &config, tinyxml2::XMLDocument &doc) {
         
         // Iterate through the xml elements for the configuration section
         tinyxml2::XMLElement * rootElement = doc.FirstChildElement();
@@ -165,7 +166,31 @@ class Perspective {
         }
     }
     
-    
+    /*
+     * Date: 10/17/26
+     * Function Name: SetView
+     * Arguments:
+     *      Vec3<float> - the new camera position
+     *      Vec3<float> - the new top left corner of the image plane
+     * Purpose: Moves the camera and the image plane (both image planes in anaglyph mode) for a frame of an animation.  The size
+     *          of the image plane stays the same
+     * Return Value: void
+     */
+    void SetView(Vec3<float> cameraPosition, Vec3<float> corner) {
+        _cameraPosition = cameraPosition;
+
+        ImagePlane * imagePlane = new ImagePlane(corner, _imagePlane->GetLength(), _imagePlane->GetHeight());
+        delete(_imagePlane);
+        _imagePlane = imagePlane;
+
+        if(_secondaryImagePlane != nullptr) {
+            Vec3<float> newCorner(corner.x + _intereyeDistance, corner.y, corner.z);
+            ImagePlane * secondaryImagePlane = new ImagePlane(newCorner, _secondaryImagePlane->GetLength(), _secondaryImagePlane->GetHeight());
+            delete(_secondaryImagePlane);
+            _secondaryImagePlane = secondaryImagePlane;
+        }
+    }
+
     /*
      * Date: 3/4/17
      * Function Name: ~Perspective
@@ -0,0 +1,695 @@
+#include "PngEncoder.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define DEFLATE_WINDOW 32768 // Farthest back a match may reach
+#define DEFLATE_MIN_MATCH 3
+#define DEFLATE_MAX_MATCH 258
+#define DEFLATE_HASH_BITS 15
+#define DEFLATE_STORED_MAX 65535 // Largest stored block
+#define ADLER_BASE 65521
+
+// Bits waiting to be written to a deflate stream.  Deflate fills every byte from its least significant bit up
+typedef struct {
+	std::vector<unsigned char> * out;
+	unsigned int buffer;
+	int count;
+} bitStream;
+
+// The hash chains of a chunk.  The head of every hash is the last position with it, previous links each position to
+// the one before it with the same hash
+typedef struct {
+	const unsigned char * data;
+	int length;
+	std::vector<int> head;
+	std::vector<int> previous;
+	int maxChain;
+	int niceLength;
+} matchFinder;
+
+// How hard every level searches, the same trade offs as zlib.  A match of the good length cuts the search for a
+// longer one at the next byte to a quarter.  Matches shorter than the lazy length are checked against the match at the
+// next byte (levels 4 and up) or have their bytes hashed (levels 1 to 3).  The search stops at the nice length or
+// after following the chain length of positions
+typedef struct {
+	int goodLength;
+	int lazyLength;
+	int niceLength;
+	int chainLength;
+} deflateLevel;
+
+static const deflateLevel deflateLevels[PNG_MAX_LEVEL + 1] = {
+	{ 0, 0, 0, 0 }, { 4, 4, 8, 4 }, { 4, 5, 16, 8 }, { 4, 6, 32, 32 }, { 4, 4, 16, 16 },
+	{ 8, 16, 32, 32 }, { 8, 16, 128, 128 }, { 8, 32, 128, 256 }, { 32, 128, 258, 1024 }, { 32, 258, 258, 4096 }
+};
+
+// Base values and extra bits of the length and distance codes of deflate
+static const int lengthBases[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const int lengthExtraBits[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const int distanceBases[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const int distanceExtraBits[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddBits
+ * Arguments:
+ *     bitStream &  - the stream
+ *     unsigned int - the bits, least significant first
+ *     int          - the number of bits
+ * Purpose: Appends bits to a deflate stream, writing out every byte that fills up
+ * Return Value: void
+ */
+static void AddBits(bitStream &stream, unsigned int bits, int count) {
+	stream.buffer |= bits << stream.count;
+	stream.count += count;
+	while (stream.count >= 8) {
+		stream.out->push_back((unsigned char)(stream.buffer & 255));
+		stream.buffer >>= 8;
+		stream.count -= 8;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddCode
+ * Arguments:
+ *     bitStream &  - the stream
+ *     unsigned int - the Huffman code
+ *     int          - the length of the code
+ * Purpose: Appends a Huffman code, which deflate stores starting from its most significant bit
+ * Return Value: void
+ */
+static void AddCode(bitStream &stream, unsigned int code, int length) {
+	unsigned int reversed = 0;
+	for (int bit = 0; bit < length; bit++) {
+		reversed = (reversed << 1) | ((code >> bit) & 1);
+	}
+	AddBits(stream, reversed, length);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddSymbol
+ * Arguments:
+ *     bitStream & - the stream
+ *     int         - a literal byte (0 to 255), the end of block (256) or a length code (257 to 285)
+ * Purpose: Appends a symbol with the fixed Huffman code of deflate
+ * Return Value: void
+ */
+static void AddSymbol(bitStream &stream, int symbol) {
+	if (symbol <= 143) {
+		AddCode(stream, 0x30 + symbol, 8);
+	} else if (symbol <= 255) {
+		AddCode(stream, 0x190 + symbol - 144, 9);
+	} else if (symbol <= 279) {
+		AddCode(stream, symbol - 256, 7);
+	} else {
+		AddCode(stream, 0xc0 + symbol - 280, 8);
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddMatch
+ * Arguments:
+ *     bitStream & - the stream
+ *     int         - the length of the match
+ *     int         - how far back the match starts
+ * Purpose: Appends a match as its length and distance codes with their extra bits
+ * Return Value: void
+ */
+static void AddMatch(bitStream &stream, int length, int distance) {
+	int code = 28;
+	while (lengthBases[code] > length) {
+		code--;
+	}
+	AddSymbol(stream, 257 + code);
+	AddBits(stream, length - lengthBases[code], lengthExtraBits[code]);
+
+	code = 29;
+	while (distanceBases[code] > distance) {
+		code--;
+	}
+	AddCode(stream, code, 5);
+	AddBits(stream, distance - distanceBases[code], distanceExtraBits[code]);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: HashPosition
+ * Arguments:
+ *     const unsigned char * - the first of three bytes
+ * Purpose: Hashes the three bytes a match has to start with
+ * Return Value: int
+ */
+static int HashPosition(const unsigned char * bytes) {
+	unsigned int key = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16);
+	return (int)((key * 2654435761u) >> (32 - DEFLATE_HASH_BITS));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: InsertPosition
+ * Arguments:
+ *     matchFinder & - the hash chains
+ *     int           - the position
+ * Purpose: Makes a position the most recent one of its hash
+ * Return Value: void
+ */
+static void InsertPosition(matchFinder &finder, int position) {
+	if (position + DEFLATE_MIN_MATCH > finder.length) {
+		return;
+	}
+	int hash = HashPosition(finder.data + position);
+	finder.previous[position] = finder.head[hash];
+	finder.head[hash] = position;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LongestMatch
+ * Arguments:
+ *     matchFinder & - the hash chains, holding every position before this one
+ *     int           - the position
+ *     int &         - set to how far back the match starts
+ * Purpose: Follows the chain of the position for the longest earlier run of the same bytes
+ * Return Value: int - the length of the match, 0 if there is none of at least three bytes
+ */
+static int LongestMatch(matchFinder &finder, int position, int &distance) {
+	int limit = finder.length - position;
+	if (limit > DEFLATE_MAX_MATCH) {
+		limit = DEFLATE_MAX_MATCH;
+	}
+	if (limit < DEFLATE_MIN_MATCH) {
+		return 0;
+	}
+
+	const unsigned char * current = finder.data + position;
+	int best = DEFLATE_MIN_MATCH - 1;
+	int candidate = finder.head[HashPosition(current)];
+	for (int chain = finder.maxChain; candidate >= 0 && position - candidate <= DEFLATE_WINDOW && chain > 0; chain--) {
+		const unsigned char * earlier = finder.data + candidate;
+
+		// The byte that would make the match longer than the best one is the most likely to differ
+		if (earlier[best] == current[best] && earlier[0] == current[0]) {
+			int length = 1;
+			while (length < limit && earlier[length] == current[length]) {
+				length++;
+			}
+			if (length > best) {
+				best = length;
+				distance = position - candidate;
+				if (length >= finder.niceLength || length == limit) {
+					break;
+				}
+			}
+		}
+		candidate = finder.previous[candidate];
+	}
+	return best >= DEFLATE_MIN_MATCH ? best : 0;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Predict
+ * Arguments:
+ *     int - the png filter type
+ *     int - the byte to the left (a)
+ *     int - the byte above (b)
+ *     int - the byte above and to the left (c)
+ * Purpose: Returns the value a png filter predicts for a byte
+ * Return Value: int
+ */
+static inline int Predict(int filter, int a, int b, int c) {
+	switch (filter) {
+		case 1 : return a;
+		case 2 : return b;
+		case 3 : return (a + b) >> 1;
+		case 4 : {
+			int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+			if (pa <= pb && pa <= pc) {
+				return a;
+			}
+			return pb <= pc ? b : c;
+		}
+		default : return 0;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ApplyFilter
+ * Arguments:
+ *     const unsigned char * - the row
+ *     const unsigned char * - the row above it (zeros for the first row)
+ *     int                   - the bytes in a row
+ *     unsigned char *       - set to the filtered row
+ * Purpose: Filters a row with one png filter
+ * Return Value: long - the sum of the magnitudes of the filtered bytes, which is smaller for rows that compress better
+ */
+template <int filter>
+static long ApplyFilter(const unsigned char * row, const unsigned char * above, int rowBytes, unsigned char * filtered) {
+	long cost = 0;
+	for (int i = 0; i < 3; i++) {
+		filtered[i] = (unsigned char)(row[i] - Predict(filter, 0, above[i], 0));
+		cost += abs((signed char)filtered[i]);
+	}
+	for (int i = 3; i < rowBytes; i++) {
+		filtered[i] = (unsigned char)(row[i] - Predict(filter, row[i - 3], above[i], above[i - 3]));
+		cost += abs((signed char)filtered[i]);
+	}
+	return cost;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: CrcTable
+ * Arguments:
+ *     void
+ * Purpose: Returns the CRC-32 of every byte, made on the first call
+ * Return Value: const unsigned int *
+ */
+static const unsigned int * CrcTable() {
+	struct table {
+		unsigned int values[256];
+		table() {
+			for (unsigned int n = 0; n < 256; n++) {
+				unsigned int c = n;
+				for (int k = 0; k < 8; k++) {
+					c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+				}
+				values[n] = c;
+			}
+		}
+	};
+	static const table crcTable;
+	return crcTable.values;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: PngEncoder (constructor)
+ * Arguments:
+ *     ThreadPool * - the threads that compress the chunks of an image, NULL to compress them on the calling thread
+ *     int          - the compression level, 0 (stored) to 9 (smallest)
+ * Purpose: Constructor
+ * Return Value: void
+ */
+PngEncoder::PngEncoder(ThreadPool * pool, int level) : _pool(pool) {
+	SetLevel(level);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Write
+ * Arguments:
+ *     std::string           - the png file to write
+ *     const unsigned char * - the RGB pixels, rows without padding
+ *     int                   - the width of the image in pixels
+ *     int                   - the height of the image in pixels
+ * Purpose: Encodes an image and writes it to a file
+ * Return Value: bool - false if the file could not be written
+ */
+bool PngEncoder::Write(std::string fileName, const unsigned char * pixels, int width, int height) {
+	std::vector<unsigned char> png;
+	Encode(pixels, width, height, png);
+
+	FILE * file = fopen(fileName.c_str(), "wb");
+	if (!file) {
+		return false;
+	}
+	bool written = fwrite(png.data(), 1, png.size(), file) == png.size();
+	return fclose(file) == 0 && written;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Encode
+ * Arguments:
+ *     const unsigned char *        - the RGB pixels, rows without padding
+ *     int                          - the width of the image in pixels
+ *     int                          - the height of the image in pixels
+ *     std::vector<unsigned char> & - set to the png file
+ * Purpose: Encodes an image.  The zlib header, every compressed chunk and the checksum each get an IDAT chunk,
+ *          which a decoder joins back into one zlib stream
+ * Return Value: void
+ */
+void PngEncoder::Encode(const unsigned char * pixels, int width, int height, std::vector<unsigned char> &png) {
+	int rowBytes = 3 * width;
+	int rowsPerChunk = PNG_CHUNK_BYTES / (rowBytes + 1);
+	if (rowsPerChunk < 1) {
+		rowsPerChunk = 1;
+	}
+	int chunkCount = (height + rowsPerChunk - 1) / rowsPerChunk;
+
+	std::vector<pngChunk> chunks(chunkCount);
+	for (int i = 0; i < chunkCount; i++) {
+		chunks[i].firstRow = i * rowsPerChunk;
+		chunks[i].rowCount = (height - chunks[i].firstRow < rowsPerChunk) ? height - chunks[i].firstRow : rowsPerChunk;
+	}
+
+	if (_pool && chunkCount > 1) {
+		TaskGroup encodeGroup;
+		for (int i = 0; i < chunkCount; i++) {
+			pngChunk * chunk = &chunks[i];
+			bool isLast = i == chunkCount - 1;
+			_pool->Submit(encodeGroup, [this, pixels, width, height, isLast, chunk]() { EncodeChunk(pixels, width, height, isLast, *chunk); });
+		}
+		_pool->Wait(encodeGroup);
+	} else {
+		for (int i = 0; i < chunkCount; i++) {
+			EncodeChunk(pixels, width, height, i == chunkCount - 1, chunks[i]);
+		}
+	}
+
+	static const unsigned char signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+	png.clear();
+	png.insert(png.end(), signature, signature + 8);
+
+	// 8 bit RGB without interlacing
+	unsigned char header[13] = { (unsigned char)(width >> 24), (unsigned char)(width >> 16), (unsigned char)(width >> 8), (unsigned char)width,
+	                             (unsigned char)(height >> 24), (unsigned char)(height >> 16), (unsigned char)(height >> 8), (unsigned char)height,
+	                             8, 2, 0, 0, 0 };
+	AppendChunk(png, "IHDR", header, 13, Crc32(Crc32(0, (const unsigned char *)"IHDR", 4), header, 13));
+
+	// A 32K window with the level hint of zlib, chosen so the two bytes are a multiple of 31
+	unsigned char zlibHeader[2] = { 0x78, (unsigned char)(_level <= 1 ? 0x01 : _level <= 5 ? 0x5e : _level == 6 ? 0x9c : 0xda) };
+	AppendChunk(png, "IDAT", zlibHeader, 2, Crc32(Crc32(0, (const unsigned char *)"IDAT", 4), zlibHeader, 2));
+
+	unsigned int adler = 1;
+	for (int i = 0; i < chunkCount; i++) {
+		AppendChunk(png, "IDAT", chunks[i].data.data(), chunks[i].data.size(), chunks[i].crc);
+		adler = CombineAdler32(adler, chunks[i].adler, (size_t)chunks[i].rowCount * (rowBytes + 1));
+	}
+
+	unsigned char checksum[4] = { (unsigned char)(adler >> 24), (unsigned char)(adler >> 16), (unsigned char)(adler >> 8), (unsigned char)adler };
+	AppendChunk(png, "IDAT", checksum, 4, Crc32(Crc32(0, (const unsigned char *)"IDAT", 4), checksum, 4));
+	AppendChunk(png, "IEND", NULL, 0, Crc32(0, (const unsigned char *)"IEND", 4));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetLevel
+ * Arguments:
+ *     int - the compression level, clamped to 0 (stored) to 9 (smallest)
+ * Purpose: Sets the compression level of the images encoded after this
+ * Return Value: void
+ */
+void PngEncoder::SetLevel(int level) {
+	_level = level < 0 ? 0 : (level > PNG_MAX_LEVEL ? PNG_MAX_LEVEL : level);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetLevel
+ * Arguments:
+ *     void
+ * Purpose: Returns the compression level
+ * Return Value: int
+ */
+int PngEncoder::GetLevel() {
+	return _level;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: EncodeChunk
+ * Arguments:
+ *     const unsigned char * - the RGB pixels of the whole image
+ *     int                   - the width of the image in pixels
+ *     int                   - the height of the image in pixels
+ *     bool                  - true for the chunk holding the last rows, which ends the deflate stream
+ *     pngChunk &            - the rows to encode.  Gets their compressed data and checksums
+ * Purpose: Filters and compresses the rows of one chunk.  Only reads the image, so the chunks run in parallel
+ * Return Value: void
+ */
+void PngEncoder::EncodeChunk(const unsigned char * pixels, int width, int height, bool isLast, pngChunk &chunk) {
+	int rowBytes = 3 * width;
+	std::vector<unsigned char> filtered((size_t)chunk.rowCount * (rowBytes + 1));
+	std::vector<unsigned char> zeros(rowBytes, 0), scratch(rowBytes);
+	for (int i = 0; i < chunk.rowCount; i++) {
+		int row = chunk.firstRow + i;
+		const unsigned char * pixelRow = pixels + (size_t)row * rowBytes;
+		unsigned char * filteredRow = &filtered[(size_t)i * (rowBytes + 1)];
+
+		// Stored images are not compressed, so filtering them gains nothing
+		if (_level == 0) {
+			filteredRow[0] = 0;
+			memcpy(filteredRow + 1, pixelRow, rowBytes);
+		} else {
+			FilterRow(pixelRow, row > 0 ? pixelRow - rowBytes : zeros.data(), rowBytes, filteredRow, scratch.data());
+		}
+	}
+
+	chunk.adler = Adler32(filtered.data(), filtered.size());
+	chunk.data.clear();
+	Deflate(filtered.data(), (int)filtered.size(), _level, isLast, chunk.data);
+	chunk.crc = Crc32(Crc32(0, (const unsigned char *)"IDAT", 4), chunk.data.data(), chunk.data.size());
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: FilterRow
+ * Arguments:
+ *     const unsigned char * - the row
+ *     const unsigned char * - the row above it (zeros for the first row)
+ *     int                   - the bytes in a row
+ *     unsigned char *       - set to the filter type followed by the filtered row
+ *     unsigned char *       - space for another filtered row
+ * Purpose: Filters a row with the png filter whose output has the smallest sum of magnitudes, which usually
+ *          compresses best
+ * Return Value: void
+ */
+void PngEncoder::FilterRow(const unsigned char * row, const unsigned char * above, int rowBytes, unsigned char * filtered, unsigned char * scratch) {
+	filtered[0] = 0;
+	long bestCost = ApplyFilter<0>(row, above, rowBytes, filtered + 1);
+
+	long costs[4];
+	costs[0] = ApplyFilter<1>(row, above, rowBytes, scratch);
+	if (costs[0] < bestCost) {
+		bestCost = costs[0];
+		filtered[0] = 1;
+		memcpy(filtered + 1, scratch, rowBytes);
+	}
+	costs[1] = ApplyFilter<2>(row, above, rowBytes, scratch);
+	if (costs[1] < bestCost) {
+		bestCost = costs[1];
+		filtered[0] = 2;
+		memcpy(filtered + 1, scratch, rowBytes);
+	}
+	costs[2] = ApplyFilter<3>(row, above, rowBytes, scratch);
+	if (costs[2] < bestCost) {
+		bestCost = costs[2];
+		filtered[0] = 3;
+		memcpy(filtered + 1, scratch, rowBytes);
+	}
+	costs[3] = ApplyFilter<4>(row, above, rowBytes, scratch);
+	if (costs[3] < bestCost) {
+		filtered[0] = 4;
+		memcpy(filtered + 1, scratch, rowBytes);
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Deflate
+ * Arguments:
+ *     const unsigned char *        - the data
+ *     int                          - the bytes of data
+ *     int                          - the compression level
+ *     bool                         - true for the last chunk of the stream
+ *     std::vector<unsigned char> & - gets the deflate blocks
+ * Purpose: Compresses a chunk into one block of matches and literals with the fixed Huffman codes.  A chunk that is
+ *          not the last is closed with an empty stored block, which ends it on a byte boundary so the next chunk can
+ *          start a block of its own right after it
+ * Return Value: void
+ */
+void PngEncoder::Deflate(const unsigned char * data, int length, int level, bool isLast, std::vector<unsigned char> &out) {
+	if (level == 0) {
+		Store(data, length, isLast, out);
+		return;
+	}
+
+	matchFinder finder;
+	finder.data = data;
+	finder.length = length;
+	finder.head.assign(1 << DEFLATE_HASH_BITS, -1);
+	finder.previous.resize(length);
+	finder.maxChain = deflateLevels[level].chainLength;
+	finder.niceLength = deflateLevels[level].niceLength;
+	bool lazy = level >= 4;
+	int lazyLength = deflateLevels[level].lazyLength;
+
+	out.reserve(length / 2);
+	bitStream stream = { &out, 0, 0 };
+	AddBits(stream, isLast ? 1 : 0, 1);
+	AddBits(stream, 1, 2);
+
+	int position = 0;
+	while (position < length) {
+		int distance = 0;
+		int match = LongestMatch(finder, position, distance);
+		InsertPosition(finder, position);
+
+		// Lazy matching, a longer match at the next byte is worth a literal here
+		if (match && lazy && match < lazyLength) {
+			int nextDistance = 0;
+			int chain = finder.maxChain;
+			if (match >= deflateLevels[level].goodLength) {
+				finder.maxChain = chain / 4 > 0 ? chain / 4 : 1;
+			}
+			int next = LongestMatch(finder, position + 1, nextDistance);
+			finder.maxChain = chain;
+			if (next > match) {
+				AddSymbol(stream, data[position]);
+				position++;
+				continue;
+			}
+		}
+
+		if (match) {
+			AddMatch(stream, match, distance);
+
+			// The fast levels skip hashing the inside of long matches
+			if (lazy || match <= lazyLength) {
+				for (int i = 1; i < match; i++) {
+					InsertPosition(finder, position + i);
+				}
+			}
+			position += match;
+		} else {
+			AddSymbol(stream, data[position]);
+			position++;
+		}
+	}
+	AddSymbol(stream, 256);
+
+	if (!isLast) {
+		AddBits(stream, 0, 3);
+	}
+	if (stream.count > 0) {
+		AddBits(stream, 0, 8 - stream.count);
+	}
+	if (!isLast) {
+		static const unsigned char emptyStored[4] = { 0, 0, 0xff, 0xff };
+		out.insert(out.end(), emptyStored, emptyStored + 4);
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Store
+ * Arguments:
+ *     const unsigned char *        - the data
+ *     int                          - the bytes of data
+ *     bool                         - true for the last chunk of the stream
+ *     std::vector<unsigned char> & - gets the deflate blocks
+ * Purpose: Copies a chunk into stored blocks without compressing it.  Starts and ends on a byte boundary
+ * Return Value: void
+ */
+void PngEncoder::Store(const unsigned char * data, int length, bool isLast, std::vector<unsigned char> &out) {
+	out.reserve(out.size() + length + 5 * (length / DEFLATE_STORED_MAX + 1));
+	int position = 0;
+	do {
+		int blockLength = length - position > DEFLATE_STORED_MAX ? DEFLATE_STORED_MAX : length - position;
+		bool isFinal = isLast && position + blockLength == length;
+
+		out.push_back(isFinal ? 1 : 0);
+		out.push_back((unsigned char)(blockLength & 255));
+		out.push_back((unsigned char)(blockLength >> 8));
+		out.push_back((unsigned char)(~blockLength & 255));
+		out.push_back((unsigned char)((~blockLength >> 8) & 255));
+		out.insert(out.end(), data + position, data + position + blockLength);
+		position += blockLength;
+	} while (position < length);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Adler32
+ * Arguments:
+ *     const unsigned char * - the data
+ *     size_t                - the bytes of data
+ * Purpose: Returns the Adler-32 checksum zlib ends its stream with
+ * Return Value: unsigned int
+ */
+unsigned int PngEncoder::Adler32(const unsigned char * data, size_t length) {
+	unsigned int s1 = 1, s2 = 0;
+	while (length > 0) {
+
+		// The sums can not overflow within 5552 bytes
+		size_t block = length < 5552 ? length : 5552;
+		for (size_t i = 0; i < block; i++) {
+			s1 += data[i];
+			s2 += s1;
+		}
+		s1 %= ADLER_BASE;
+		s2 %= ADLER_BASE;
+		data += block;
+		length -= block;
+	}
+	return (s2 << 16) | s1;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: CombineAdler32
+ * Arguments:
+ *     unsigned int - the checksum of the first data
+ *     unsigned int - the checksum of the data that follows it
+ *     size_t       - the bytes of the data that follows
+ * Purpose: Returns the checksum of the two pieces of data joined, so the chunks can be summed separately
+ * Return Value: unsigned int
+ */
+unsigned int PngEncoder::CombineAdler32(unsigned int first, unsigned int second, size_t secondLength) {
+	unsigned long long remainder = secondLength % ADLER_BASE;
+	unsigned long long s1 = first & 0xffff;
+	unsigned long long s2 = (remainder * s1) % ADLER_BASE;
+	s1 += (second & 0xffff) + ADLER_BASE - 1;
+	s2 += (first >> 16) + (second >> 16) + ADLER_BASE - remainder;
+	return (unsigned int)(((s2 % ADLER_BASE) << 16) | (s1 % ADLER_BASE));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Crc32
+ * Arguments:
+ *     unsigned int          - the CRC of the data before this, 0 to start
+ *     const unsigned char * - the data
+ *     size_t                - the bytes of data
+ * Purpose: Continues the CRC-32 that ends every png chunk
+ * Return Value: unsigned int
+ */
+unsigned int PngEncoder::Crc32(unsigned int crc, const unsigned char * data, size_t length) {
+	const unsigned int * table = CrcTable();
+	crc = ~crc;
+	for (size_t i = 0; i < length; i++) {
+		crc = table[(crc ^ data[i]) & 255] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AppendChunk
+ * Arguments:
+ *     std::vector<unsigned char> & - the png file
+ *     const char *                 - the four letter chunk type
+ *     const unsigned char *        - the data of the chunk
+ *     size_t                       - the bytes of data
+ *     unsigned int                 - the CRC-32 of the type and data
+ * Purpose: Appends a chunk to a png file
+ * Return Value: void
+ */
+void PngEncoder::AppendChunk(std::vector<unsigned char> &png, const char * type, const unsigned char * data, size_t length, unsigned int crc) {
+	unsigned char lengthBytes[4] = { (unsigned char)(length >> 24), (unsigned char)(length >> 16), (unsigned char)(length >> 8), (unsigned char)length };
+	unsigned char crcBytes[4] = { (unsigned char)(crc >> 24), (unsigned char)(crc >> 16), (unsigned char)(crc >> 8), (unsigned char)crc };
+	png.insert(png.end(), lengthBytes, lengthBytes + 4);
+	png.insert(png.end(), type, type + 4);
+	if (length > 0) {
+		png.insert(png.end(), data, data + length);
+	}
+	png.insert(png.end(), crcBytes, crcBytes + 4);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+#define PNG_DEFAULT_LEVEL 6 // Compression level of png files when the configuration does not set one
+#define PNG_MAX_LEVEL 9
+#define PNG_CHUNK_BYTES 131072 // Filtered bytes compressed by one task.  Rows are never split between tasks
+
+// The compressed form of a run of rows.  Every chunk is a complete sequence of deflate blocks that ends on a byte
+// boundary, so the chunks joined in order are one deflate stream
+typedef struct {
+	int firstRow;
+	int rowCount;
+	std::vector<unsigned char> data;
+	unsigned int adler; // Adler-32 of the filtered rows of the chunk
+	unsigned int crc; // CRC-32 of the IDAT chunk that holds the data
+} pngChunk;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: PngEncoder
+ * Purpose: Writes RGB images as png files.  The rows are filtered and compressed in independent chunks on the
+ *          render threads, each stored as an IDAT chunk of its own, so a large image takes all of the cores
+ *          instead of one.  Level 0 stores the image uncompressed, 1 to 9 trade speed for smaller files
+ */
+class PngEncoder {
+
+	public :
+		PngEncoder(ThreadPool * pool = NULL, int level = PNG_DEFAULT_LEVEL);
+
+		bool Write(std::string fileName, const unsigned char * pixels, int width, int height);
+		void Encode(const unsigned char * pixels, int width, int height, std::vector<unsigned char> &png);
+		void SetLevel(int level);
+		int GetLevel();
+
+	private :
+		void EncodeChunk(const unsigned char * pixels, int width, int height, bool isLast, pngChunk &chunk);
+		static void FilterRow(const unsigned char * row, const unsigned char * above, int rowBytes, unsigned char * filtered, unsigned char * scratch);
+		static void Deflate(const unsigned char * data, int length, int level, bool isLast, std::vector<unsigned char> &out);
+		static void Store(const unsigned char * data, int length, bool isLast, std::vector<unsigned char> &out);
+		static unsigned int Adler32(const unsigned char * data, size_t length);
+		static unsigned int CombineAdler32(unsigned int first, unsigned int second, size_t secondLength);
+		static unsigned int Crc32(unsigned int crc, const unsigned char * data, size_t length);
+		static void AppendChunk(std::vector<unsigned char> &png, const char * type, const unsigned char * data, size_t length, unsigned int crc);
+
+		ThreadPool * _pool;
+		int _level;
+};
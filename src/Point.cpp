@@ -10,9 +10,6 @@
  */
 Point::Point(Vec3<float> pos) : super(POINT) {
 	_position = pos;
-	Material mat = MATERIAL_NONE;
-	SetMaterial(mat);
-	SetColor(Vec3<unsigned char>::vec3(255, 255, 255));
 }
 
 /* 
@@ -21,10 +18,11 @@ Point::Point(Vec3<float> pos) : super(POINT) {
  * Arguments:
  *		Vec3<float> - the ray being cast
  *		Vec3<float> - the starting position of the ray
- * Return Value: void
+ *		RayHit &    - the hit record holding the closest hit so far
+ * Return Value: bool
  */
-std::shared_ptr<RayHit> Point::Intersect(Vec3<float> ray, Vec3<float> startingPos) {
-	return nullptr;
+bool Point::Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+	return false;
 }
 
 /*
@@ -37,3 +35,25 @@ std::shared_ptr<RayHit> Point::Intersect(Vec3<float> ray, Vec3<float> startingPo
 Vec3<float> Point::GetRandomPoint() {
 	return _position;
 }
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetBoundingBox
+ * Arguments:
+ *		void
+ * Return Value: BoundingBox
+ */
+BoundingBox Point::GetBoundingBox() {
+	return BoundingBox(_position, _position);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Translate
+ * Arguments:
+ *		Vec3<float> - the offset
+ * Return Value: void
+ */
+void Point::Translate(Vec3<float> offset) {
+	_position = _position + offset;
+}
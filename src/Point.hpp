@@ -18,8 +18,10 @@ class Point : public Geometry {
 
 	public :
 		Point(Vec3<float> pos);
-		std::shared_ptr<RayHit> Intersect(Vec3<float> ray, Vec3<float> startingPos);
+		bool Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		BoundingBox GetBoundingBox();
 		Vec3<float> GetRandomPoint();
+		void Translate(Vec3<float> offset);
 
 
 	private :
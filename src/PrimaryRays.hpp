@@ -0,0 +1,124 @@
+#pragma once
+
+#include "BVH.hpp"
+#include "Config.hpp"
+#include "Perspective.hpp"
+#include "Vector.hpp"
+
+// Where the primary rays of one eye start and the corner of the image plane they pass through.  The corner holds the
+// x and z of the plane the eye looks through and the y its rows are measured from
+typedef struct {
+	Vec3<float> eyePosition;
+	Vec3<float> corner;
+	float unitsPerLength;
+	float unitsPerHeight;
+} eyeView;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: PrimaryRays
+ * Purpose: Generates the primary rays of blocks of pixels.  The image plane and camera of each eye are picked from the
+ *          anaglyph mode once, and the pixel loop is specialized at compile time on anti-aliasing and on the number of
+ *          eyes traced together
+ */
+class PrimaryRays {
+
+	public :
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Setup
+		 * Arguments:
+		 *     Config &      - the configuration of the scene
+		 *     Perspective & - the camera and image plane(s) of the scene
+		 * Purpose: Works out the view of the first (left) and second (right) eye
+		 * Return Value: void
+		 */
+		void Setup(Config &config, Perspective &perspective) {
+			ImagePlane * imagePlane = perspective.GetImagePlane();
+			ImagePlane * secondaryPlane = perspective.GetSecondaryImagePlane();
+			Vec3<float> camera = perspective.GetCameraPosition();
+
+			for (int eye = 0; eye < 2; eye++) {
+				eyeView &view = _views[eye];
+				view.unitsPerLength = perspective.GetUnitsPerLengthPixel();
+				view.unitsPerHeight = perspective.GetUnitsPerHeightPixel();
+				view.eyePosition = camera;
+				view.corner = imagePlane->GetCorner();
+
+				if (eye == 0 || !config.IsAnaglyph()) {
+					continue;
+				}
+
+				// The second eye sits to the side of the camera.  Parallel views look through their own image plane,
+				// converging views share the rows of the second plane and the columns of the first
+				view.eyePosition = Vec3<float>::vec3(camera.x - perspective.GetIntereyeDistance(), camera.y, camera.z);
+				if (perspective.GetAnaglyphMode() == ANAGLYPH_PARALLEL) {
+					view.corner = Vec3<float>::vec3(secondaryPlane->GetCorner().x, imagePlane->GetCorner().y, secondaryPlane->GetCorner().z);
+				} else if (perspective.GetAnaglyphMode() == ANAGLYPH_CONVERGE) {
+					view.corner = Vec3<float>::vec3(imagePlane->GetCorner().x, secondaryPlane->GetCorner().y, imagePlane->GetCorner().z);
+				}
+			}
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetViews
+		 * Arguments:
+		 *     bool - true to start at the second (right) eye
+		 * Purpose: Returns the views handed to Generate.  A stereo block uses both views from the first eye on
+		 * Return Value: const eyeView *
+		 */
+		const eyeView * GetViews(bool isSecondary) const {
+			return isSecondary ? &_views[1] : &_views[0];
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Generate
+		 * Arguments:
+		 *     const eyeView * - the view of every eye traced
+		 *     int             - the first row of the block
+		 *     int             - the row after the last row of the block
+		 *     int             - the first column of the block
+		 *     int             - the column after the last column of the block
+		 *     rayPacket &     - filled with the rays.  Pixel by pixel, then anti-aliasing sample, then eye
+		 * Purpose: Generates the primary rays of a block of pixels.  Anti-aliased pixels take 2x2 rays each
+		 * Return Value: void
+		 */
+		template <bool antialiased, int eyes>
+		static void Generate(const eyeView * views, int startRow, int endRow, int startColumn, int endColumn, rayPacket &packet) {
+			const int samples = antialiased ? 4 : 1;
+
+			packet.count = 0;
+			for (int i = startRow; i < endRow; i++) {
+				float heightOffset[eyes];
+				for (int eye = 0; eye < eyes; eye++) {
+					heightOffset[eye] = views[eye].corner.y - (views[eye].unitsPerHeight * (float)i);
+				}
+
+				for (int j = startColumn; j < endColumn; j++) {
+					for (int sample = 0; sample < samples; sample++) {
+						for (int eye = 0; eye < eyes; eye++) {
+							const eyeView &view = views[eye];
+							Vec3<float> target = Vec3<float>::vec3(view.corner.x + (view.unitsPerLength * (float)j), heightOffset[eye], view.corner.z);
+
+							// Anti-aliasing 4 rays per pixel
+							if (antialiased) {
+								int k = sample / 2, l = sample % 2;
+								target = Vec3<float>::vec3(target.x + (view.unitsPerLength * (float)l), target.y - (view.unitsPerHeight * ((float)k + 1.f)), target.z);
+							}
+
+							Vec3<float> eyePosition = view.eyePosition;
+							packet.rays[packet.count] = Vec3<float>::Normalize(target - eyePosition);
+							packet.startingPos[packet.count++] = eyePosition;
+						}
+					}
+				}
+			}
+		}
+
+	private :
+		eyeView _views[2];
+};
@@ -1,25 +1,34 @@
 #include "RayHit.hpp"
 
+/*
+ * Date: 10/17/26
+ * Function Name: RayHit (constructor)
+ * Arguments:
+ *     void
+ * Purpose: Constructor for an empty hit record.  The time starts at FLT_MAX so any intersection is closer
+ * Return Value: void
+ */
+RayHit::RayHit() : _time(FLT_MAX), _normal(0, 0, 0), _secondNorm(0, 0, 0), _hitLocation(0, 0, 0), _ray(0, 0, 0), _material(MATERIAL_DEFAULT) {
+}
+
 /*
  * Date: 12/28/16
  * Function Name: RayHit (constructor)
  * Arguments:
  *     float       - time to hit
- *     Material    - material of the intesected object
- *     Color       - color of the intersected object
+ *     materialId  - the entry of the material table of the intersected object
  *     Vec3<float> - the normal of the intersected object
  *     Vec3<float> - the hit location of the intersected object
  *     Vec3<float> - the original ray 
  * Purpose: Constructor
  * Return Value: void
 */
-RayHit::RayHit(float t, Material mat, Vec3<unsigned char> color, Vec3<float> norm, Vec3<float> loc, Vec3<float> r) : _secondNorm(0, 0, 0){
+RayHit::RayHit(float t, materialId material, Vec3<float> norm, Vec3<float> loc, Vec3<float> r) : _secondNorm(0, 0, 0){
 	_time = t;
-	_material = mat;
+	_material = material;
 	_normal = Vec3<float>::vec3(norm.x, norm.y, norm.z);
 	_hitLocation = Vec3<float>::vec3(loc.x, loc.y, loc.z);
 	_ray = Vec3<float>::vec3(r.x, r.y, r.z);
-	_color = color;
 }
 
 /*
@@ -27,8 +36,7 @@ RayHit::RayHit(float t, Material mat, Vec3<unsigned char> color, Vec3<float> nor
 * Function Name: RayHit (constructor)
 * Arguments:
 *     float       - time to hit
-*     Material    - material of the intesected object
-*     Color       - color of the intersected object
+*     materialId  - the entry of the material table of the intersected object
 *     Vec3<float> - the normal of the intersected object
 *     Vec3<float> - the secondary normal of the intersected object.  - of normal
 *     Vec3<float> - the hit location of the intersected object
@@ -36,26 +44,13 @@ RayHit::RayHit(float t, Material mat, Vec3<unsigned char> color, Vec3<float> nor
 * Purpose: Constructor
 * Return Value: void
 */
-RayHit::RayHit(float t, Material mat, Vec3<unsigned char> color, Vec3<float> norm, Vec3<float> secondNorm, Vec3<float> loc, Vec3<float> r) {
+RayHit::RayHit(float t, materialId material, Vec3<float> norm, Vec3<float> secondNorm, Vec3<float> loc, Vec3<float> r) {
 	_time = t;
-	_material = mat;
+	_material = material;
 	_normal = Vec3<float>::vec3(norm.x, norm.y, norm.z);
 	_secondNorm = Vec3<float>::vec3(secondNorm.x, secondNorm.y, secondNorm.z);
 	_hitLocation = Vec3<float>::vec3(loc.x, loc.y, loc.z);
 	_ray = Vec3<float>::vec3(r.x, r.y, r.z);
-	_color = color;
-}
-
-/*
-* Date: 1/16/17
-* Function Name: GetColor()
-* Arguments:
-*     void
-* Purpose: Returns the color of the hit object
-* Return Value: Vec3<unsigned char>
-*/
-Vec3<unsigned char> RayHit::GetColor() {
-	return _color;
 }
 
 /*
@@ -71,14 +66,14 @@ Vec3<float> RayHit::GetHitLocation() {
 }
 
 /*
-* Date: 1/16/17
-* Function Name: GetMaterial()
+* Date: 10/17/26
+* Function Name: GetMaterialId()
 * Arguments:
 *     void
-* Purpose: Returns the material of the object hit
-* Return Value: Material
+* Purpose: Returns the entry of the material table with the color and material of the object hit
+* Return Value: materialId
 */
-Material RayHit::GetMaterial() {
+materialId RayHit::GetMaterialId() {
 	return _material;
 }
 
@@ -128,4 +123,38 @@ Vec3<float> RayHit::GetRay() {
 */
 float RayHit::GetTime() {
 	return _time;
-}
\ No newline at end of file
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: HasHit()
+ * Arguments:
+ *     void
+ * Purpose: Returns true if an intersection has been written into the record
+ * Return Value: bool
+ */
+bool RayHit::HasHit() {
+	return _time < FLT_MAX;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetHit()
+ * Arguments:
+ *     float       - time to hit
+ *     materialId  - the entry of the material table of the intersected object
+ *     Vec3<float> - the normal of the intersected object
+ *     Vec3<float> - the secondary normal of the intersected object
+ *     Vec3<float> - the hit location of the intersected object
+ *     Vec3<float> - the original ray
+ * Purpose: Overwrites the record with a closer intersection
+ * Return Value: void
+ */
+void RayHit::SetHit(float t, materialId material, Vec3<float> norm, Vec3<float> secondNorm, Vec3<float> loc, Vec3<float> r) {
+	_time = t;
+	_material = material;
+	_normal = norm;
+	_secondNorm = secondNorm;
+	_hitLocation = loc;
+	_ray = r;
+}
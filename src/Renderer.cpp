@@ -0,0 +1,829 @@
+#define TILE_SIZE 16 // Width and height in pixels of the image tiles handed to the render threads
+#define PACKET_BLOCK_SIZE 4 // Width and height in rays of the blocks of primary rays traced as one packet
+
+/* Standard libs */
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+/* Project headers */
+#include "Renderer.hpp"
+#include "Material.hpp"
+
+using namespace std;
+
+static void setPixelColor(Vec3<unsigned char> color, Vec2<int> coordinate, unsigned char * array, int width) {
+    
+    int pos = (coordinate.y * 3 * width) + (coordinate.x * 3);
+    
+    array[pos] = color.x;
+    array[++pos] = color.y;
+    array[++pos] = color.z;
+}
+
+static Vec3<unsigned char> getPixelColor(Vec2<int> coordinate, unsigned char * array, int width) {
+    int pos = (coordinate.y * 3 * width) + (coordinate.x * 3);
+    
+    Vec3<unsigned char> color;
+    color.x = array[pos];
+    color.y = array[++pos];
+    color.z = array[++pos];
+    return color;
+    
+}
+
+static void drawGradient(Vec3<float> gradientStart, Vec3<float> gradientEnd, int width, int height, unsigned char * imageArray, bool hsl) {
+    float t;
+    
+    // HSL gradient
+    if (hsl) {
+        Color::RGBToHSL(gradientStart);
+        Color::RGBToHSL(gradientEnd);
+    }
+    for (int i = 0; i < height; i++) {
+        t = i / (float)(height - 1.0f);
+        float r = gradientStart.x + (gradientEnd.x - gradientStart.x) * t;
+        float g = gradientStart.y + (gradientEnd.y - gradientStart.y) * t;
+        float b = gradientStart.z + (gradientEnd.z - gradientStart.z) * t;
+        Vec3<float> color(r, g, b);
+        
+        // Convert the hsl interpolation to rgb if necessary so we can draw it
+        if (hsl) {
+            Color::HSLToRGB(color);
+        }
+        
+        Vec3<unsigned char> col((unsigned char)color.x, (unsigned char)color.y, (unsigned char)color.z);
+        
+        for (int j = 0; j < width; j++) {
+            // a + (b - a) * t
+            Vec2<int> coordinate(j, i);
+            setPixelColor(col, coordinate, imageArray, width);
+        }
+    }
+}
+
+static void gammaCorrect(unsigned char * imageArray, int height, int width) {
+    Vec3<unsigned char> color;
+    Vec2<int> coordinate;
+    
+    // Go through each of the pixels
+    for (int i = 0; i < height; i++) {
+        for (int j = 0; j < width; j++) {
+            
+            // Corrected = 255 * (Image/255)^(1/2.2)
+            coordinate.SetValues(j, i);
+            color = getPixelColor(coordinate, imageArray, width);
+            color.x = (unsigned char)(255 * pow((color.x / 255.f), 0.45454545454));
+            color.z = (unsigned char)(255 * pow((color.z / 255.f), 0.45454545454));
+            color.y = (unsigned char)(255 * pow((color.y / 255.f), 0.45454545454));
+            
+            setPixelColor(color, coordinate, imageArray, width);
+        }
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ElapsedMilliseconds
+ * Arguments:
+ *     std::chrono::steady_clock::time_point - when the stage started
+ * Purpose: Returns the milliseconds passed since the start of a stage of a frame
+ * Return Value: double
+ */
+static double ElapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: FrameFileName
+ * Arguments:
+ *     std::string - the file name of the image
+ *     int         - the frame
+ * Purpose: Numbers the file name of an image of a sequence, output1.png becomes output1_0007.png for frame 7
+ * Return Value: std::string
+ */
+static std::string FrameFileName(std::string fileName, int frame) {
+    char number[16];
+    snprintf(number, sizeof(number), "_%04d", frame);
+    
+    size_t dot = fileName.find_last_of('.');
+    size_t slash = fileName.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return fileName + number;
+    }
+    return fileName.substr(0, dot) + number + fileName.substr(dot);
+}
+
+static Vec3<float> GetReflection(Vec3<float> ray, Vec3<float> norm) {
+    float temp = 2 * (ray * norm);
+    return Vec3<float>::Normalize(ray - (norm * temp));
+}
+
+static void RemoveRedChannel(unsigned char * imageArray, int length, int height) {
+    for(int i = 0; i < height * length * 3; i++) {
+        if(i % 3 != 0) {
+            imageArray[i] = 0;
+        }
+    }
+}
+
+static void RemoveCyanChannel(unsigned char * imageArray, int length, int height) {
+    for(int i = 0; i < height * length * 3; i++) {
+        if(i % 3 == 0) {
+            imageArray[i] = 0;
+        }
+    }
+}
+
+static void ConvertImageToGrayScale(unsigned char * imageArray, int length, int height) {
+    //http://stackoverflow.com/questions/17615963/standard-rgb-to-grayscale-conversion
+    for(int i = 0; i < length * height * 3; i+=3) {
+        unsigned char y = 255 * (imageArray[i] / 255.f * 0.2126f +imageArray[i+1] / 255.f * 0.7152f + imageArray[i+2] / 255.f * 0.0722f);
+        imageArray[i]   = y;
+        imageArray[i+1] = y;
+        imageArray[i+2] = y;
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Renderer (constructor)
+ * Arguments:
+ *     std::string - the scene (xml) file to render
+ * Purpose: Constructor.  Starts the render threads, loads the scene and its hierarchy (from the cache when possible) and allocates the image arrays
+ * Return Value: void
+ */
+Renderer::Renderer(std::string fileName) : _fileName(fileName), _printedConfiguration(false), _pixelOffset(0) {
+    
+    // Parse the file once and build the whole scene from the same document
+    SceneLoader loader(fileName);
+    loader.LoadColors(_colorMapping);
+    loader.LoadConfiguration(_configuration);
+    loader.LoadPerspective(_configuration, _perspective);
+    loader.LoadAnimation(_animation);
+    _trackOffsets.assign(_animation.GetTrackCount(), Vec3<float>::vec3(0, 0, 0));
+    
+    // The render threads also build the hierarchy
+    _pool = new ThreadPool(_configuration.GetThreadCount());
+    _writer = new ImageWriter(_pool, _configuration.GetPngCompression());
+    _materials.SetArena(&_scene.GetArena());
+    _bvh.SetArena(&_scene.GetArena());
+    _bvh.SetWidth(_configuration.GetBvhWidth());
+    _bvh.SetRefitLimit(_configuration.GetBvhRefitLimit());
+    
+    // The compiled geometry and hierarchies of an unchanged scene, including those of the instanced meshes, come
+    // straight from the cache.  Otherwise the instanced meshes are built first, the hierarchy over the objects
+    // bounds the instances by them
+    bool cached = _configuration.UseSceneCache() && loader.LoadCache(_configuration, _materials, _scene, _bvh);
+    if (!cached) {
+        loader.LoadGeometry(_colorMapping, _materials, _scene);
+        _scene.BuildPrototypes(_pool, _configuration.GetBvhQuality(), _configuration.GetBvhWidth());
+        _bvh.Build(_scene.GetObjects(), _pool, _configuration.GetBvhQuality());
+        
+        if (_configuration.UseSceneCache()) {
+            loader.SaveCache(_configuration, _materials, _scene, _bvh);
+        }
+    }
+    _loadTimings = loader.GetTimings();
+    if (_configuration.UseSceneCache()) {
+        _cachePath = loader.GetCachePath(_configuration);
+    }
+    
+    /* Image arrays */
+    _imageArray0 = (unsigned char *) malloc(3 * _configuration.GetPixelLength() * _configuration.GetPixelHeight() * sizeof(unsigned char));
+    _imageArray1 = (unsigned char *) malloc(3 * _configuration.GetPixelLength() * _configuration.GetPixelHeight() * sizeof(unsigned char));
+    _anaglyphImage = (unsigned char *) malloc(3 * (_configuration.GetPixelLength() + _configuration.GetPixelLength()) * _configuration.GetPixelHeight() * sizeof(unsigned char));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ~Renderer
+ * Arguments:
+ *     void
+ * Purpose: Destructor
+ * Return Value: void
+ */
+Renderer::~Renderer() {
+    delete(_writer);
+    delete(_pool);
+    free(_imageArray0);
+    free(_imageArray1);
+    free(_anaglyphImage);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: FollowReflections
+ * Arguments:
+ *     bool     - true if the ray hit something
+ *     RayHit & - the hit record of the ray.  Replaced by the hit of the last reflected ray
+ * Purpose: Follows the ray off reflective surfaces until it hits something that is not reflective
+ * Return Value: bool - true if the final hit record holds a surface to shade
+ */
+bool Renderer::FollowReflections(bool hit, RayHit &rayHit) {
+    
+    for(int depth = 0; hit; depth++) {
+        
+        /* Check reflection */
+        if(_materials.Get(rayHit.GetMaterialId()).type != MATERIAL_REFLECTIVE) {
+            return true;
+        }
+        if(depth > 9) {
+            return false;
+        }
+        
+        // Follow the reflected ray with a fresh hit record
+        Vec3<float> ray = GetReflection(rayHit.GetRay(), rayHit.GetNormal());
+        Vec3<float> startingPos = rayHit.GetHitLocation() + (rayHit.GetNormal() * .00005f);
+        rayHit = RayHit();
+        hit = _bvh.Intersect(ray, startingPos, rayHit);
+    }
+    return false;
+}
+
+Vec3<unsigned char> Renderer::CheckShadows(float ambientLight, RayHit &rayHit) {
+    
+    bool intersected = false;
+    float scale = ambientLight;
+    
+    // Go through each light source
+    std::vector<Geometry *> &lights = _scene.GetLights();
+    for (size_t i = 0; i < lights.size(); i++) {
+        Vec3<float> randomPoint = lights[i]->GetRandomPoint();
+        Vec3<float> toLightRay = Vec3<float>::Normalize(randomPoint - (rayHit.GetHitLocation() + (rayHit.GetNormal() * .00005f)) ); // Bump
+        Vec3<float> toLightSecondary = Vec3<float>::Normalize(randomPoint - (rayHit.GetHitLocation() + (rayHit.GetSecondaryNormal() * .00005f))); // Bump
+        float maxTime = __FLT_MAX__;
+        
+        // Find the max time before we hit the light source
+        if(toLightRay.x == 0) {
+            if(toLightRay.y == 0) {
+                if(toLightRay.z == 0) {
+                    
+                } else {
+                    maxTime = randomPoint.z / toLightRay.z;
+                }
+            }
+            else {
+                maxTime = randomPoint.y / toLightRay.y;
+            }
+        }
+        else {
+            maxTime = randomPoint.x / toLightRay.x;
+        }
+        
+        
+        // See if anything blocks the way to the light source along either normal
+        if (_bvh.Occluded(toLightRay, rayHit.GetHitLocation(), 0.0005f, maxTime) || _bvh.Occluded(toLightSecondary, rayHit.GetHitLocation(), 0.0005f, maxTime)) {
+            intersected = true;
+        }
+        
+        // We didn't hit anything so take the dot product
+        if (!intersected) {
+            float temp1 = toLightRay * rayHit.GetNormal();
+			float temp2 = toLightRay * rayHit.GetSecondaryNormal();
+            
+            // Diffuse light shading
+            if (temp1 > scale) {
+                scale = temp1;
+            }
+            if (temp2 > scale) {
+                scale = temp2;
+            }
+        }
+    }
+    
+    Vec3<unsigned char> color = _materials.Get(rayHit.GetMaterialId()).color;
+    return color * scale;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ShootRays
+ * Arguments:
+ *     tileArgs & - the tile to render
+ * Purpose: Renders one image tile with the pixel loop specialized for its anti-aliasing and number of eyes
+ * Return Value: void
+ */
+void Renderer::ShootRays(tileArgs &args) {
+    bool stereo = args.secondaryImageArray != NULL;
+    
+    if(_configuration.IsAntialiased()) {
+        stereo ? ShootTile<true, 2>(args) : ShootTile<true, 1>(args);
+    } else {
+        stereo ? ShootTile<false, 2>(args) : ShootTile<false, 1>(args);
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ShootTile
+ * Arguments:
+ *     tileArgs & - the tile to render
+ * Purpose: Renders one image tile a block of pixels at a time.  The primary rays of a block (of both eyes for a
+ *          stereo tile) are traced together as one packet, or one at a time when packet tracing is off, then every
+ *          ray follows its reflections and is shaded on its own
+ * Return Value: void
+ */
+template <bool antialiased, int eyes>
+void Renderer::ShootTile(tileArgs &args) {
+    
+    // Anti-aliased pixels take 2x2 rays each, so their blocks cover half as many pixels
+    const int samples = antialiased ? 4 : 1;
+    const int blockSize = antialiased ? PACKET_BLOCK_SIZE / 2 : PACKET_BLOCK_SIZE;
+    
+    const eyeView * views = _primaryRays.GetViews(args.isSecondary);
+    unsigned char * imageArrays[2] = {args.imageArray, args.secondaryImageArray};
+    bool packetTracing = _configuration.UsePacketTracing();
+    float ambientLight = _configuration.GetAmbientLight();
+    int pixelLength = _configuration.GetPixelLength();
+    Vec3<unsigned char> black = _colorMapping.GetColor(COLOR_BLACK);
+    
+    rayPacket packet;
+    RayHit rayHits[RAY_PACKET_SIZE];
+    bool hits[RAY_PACKET_SIZE];
+    
+    for(int row = args.startRow; row < args.endRow; row += blockSize) {
+        for(int column = args.startColumn; column < args.endColumn; column += blockSize) {
+            int endRow = min(row + blockSize, args.endRow);
+            int endColumn = min(column + blockSize, args.endColumn);
+            
+            PrimaryRays::Generate<antialiased, eyes>(views, row, endRow, column, endColumn, packet);
+            
+            for(int ray = 0; ray < packet.count; ray++) {
+                rayHits[ray] = RayHit();
+            }
+            if(packetTracing) {
+                _bvh.IntersectPacket(packet, rayHits, hits);
+            } else {
+                for(int ray = 0; ray < packet.count; ray++) {
+                    hits[ray] = _bvh.Intersect(packet.rays[ray], packet.startingPos[ray], rayHits[ray]);
+                }
+            }
+            
+            // Set every pixel to the average color of its rays
+            int ray = 0;
+            for(int i = row; i < endRow; i++) {
+                for(int j = column; j < endColumn; j++) {
+                    int avg [eyes][3] = {{0}};
+                    for(int sample = 0; sample < samples; sample++) {
+                        for(int eye = 0; eye < eyes; eye++, ray++) {
+                            Vec3<unsigned char> color = FollowReflections(hits[ray], rayHits[ray]) ? CheckShadows(ambientLight, rayHits[ray]) : black;
+                            avg[eye][0] += color.x;
+                            avg[eye][1] += color.y;
+                            avg[eye][2] += color.z;
+                        }
+                    }
+                    
+                    Vec2<int> coord(j, i);
+                    for(int eye = 0; eye < eyes; eye++) {
+                        Vec3<unsigned char> colorAvg(avg[eye][0] / samples, avg[eye][1] / samples, avg[eye][2] / samples);
+                        setPixelColor(colorAvg, coord, imageArrays[eye], pixelLength);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Renderer::CreateAnaglyph() {
+
+	Vec3<unsigned char> black = _colorMapping.GetColor(COLOR_BLACK);
+
+	// Copy the images on top of oneanother
+	for (int i = 0; i < _configuration.GetPixelLength() + _pixelOffset; i++) {
+		for (int j = 0; j < _configuration.GetPixelHeight(); j++) {
+
+			Vec2<int> coord(i, j);
+			Vec2<int> offsetCoord(i - abs(_pixelOffset), j);
+			Vec3<unsigned char> newColor, imageOneColor, imageTwoColor;
+
+			if (_pixelOffset == 0) {
+				imageOneColor = getPixelColor(coord, _imageArray0, _configuration.GetPixelLength());
+				imageTwoColor = getPixelColor(coord, _imageArray1, _configuration.GetPixelLength());
+			}
+			else if (_pixelOffset > 0) { // pixel offset is greater than 0 (move right eye image to the right)
+				if (coord.x > _configuration.GetPixelLength()) {
+					imageOneColor = black;
+				}
+				else {
+					imageOneColor = getPixelColor(coord, _imageArray0, _configuration.GetPixelLength());
+				}
+				
+				if (offsetCoord.x < 0) {
+					imageTwoColor = black;
+				}
+				else {
+					imageTwoColor = getPixelColor(offsetCoord, _imageArray1, _configuration.GetPixelLength());
+				}
+				
+			}
+			else { // Pixel offset is negative (move right eye image in front of the left (red))
+				if (coord.x > _configuration.GetPixelLength()) {
+					imageTwoColor = black;
+				}
+				else {
+					imageTwoColor = getPixelColor(coord, _imageArray1, _configuration.GetPixelLength());
+				}
+
+				if (offsetCoord.x < 0) {
+					imageOneColor = black;
+				}
+				else {
+					imageOneColor = getPixelColor(offsetCoord, _imageArray0, _configuration.GetPixelLength());
+				}
+			}
+			newColor.SetValues(min(imageOneColor.x + imageTwoColor.x, 255), min(imageOneColor.y + imageTwoColor.y, 255), min(imageOneColor.z + imageTwoColor.z, 255));
+			setPixelColor(newColor, coord, _anaglyphImage, _configuration.GetPixelLength()+_pixelOffset);
+			
+		}
+	}
+}
+
+
+/*
+ * Date: 10/17/26
+ * Function Name: Render
+ * Arguments:
+ *     void
+ * Purpose: Raytraces the image (both eyes in anaglyph mode) and applies the post processing
+ * Return Value: void
+ */
+void Renderer::Render() {
+    
+    bool background_gradient = false, hsl_interpolation = false;
+    Vec3<float> gradientStart(0, 0, 0), gradientEnd(0, 0, 0);
+    
+    // A sequence only prints the configuration before its first frame
+    if(!_printedConfiguration) {
+        PrintConfiguration();
+        _printedConfiguration = true;
+    }
+    
+    // Make sure the image array was allocated correctly
+    if(!_imageArray0 || !_imageArray1) {
+        cout << "Failed to allocate memory for the image array.  Exiting" << endl;
+        exit(1);
+    }
+    
+    // Draw the gradient on the image
+    if(background_gradient) {
+        drawGradient(gradientStart, gradientEnd, _configuration.GetPixelLength(), _configuration.GetPixelHeight(), _imageArray0, hsl_interpolation);
+    }
+    
+    // Arguments shared by every tile of an image
+    tileArgs baseArgs;
+    
+    // Make sure the ImagePlane is set already
+    assert(_perspective.GetImagePlane() != nullptr);
+    _primaryRays.Setup(_configuration, _perspective);
+    
+    // Hand out the tiles of both eyes (anaglyph mode) or the single image to the thread pool.  Stereo tiles trace
+    // both eyes in one pass
+    TaskGroup renderGroup;
+    bool stereo = _configuration.IsAnaglyph() && _configuration.UseStereoTracing();
+    int imageCount = (_configuration.IsAnaglyph() && !stereo) ? 2 : 1;
+    for(int image = 0; image < imageCount; image++) {
+        for(int row = 0; row < _configuration.GetPixelHeight(); row += TILE_SIZE) {
+            for(int column = 0; column < _configuration.GetPixelLength(); column += TILE_SIZE) {
+                tileArgs tile = baseArgs;
+                tile.isSecondary = image == 1;
+                tile.imageArray = image == 1 ? _imageArray1 : _imageArray0;
+                tile.secondaryImageArray = stereo ? _imageArray1 : NULL;
+                tile.startRow = row;
+                tile.endRow = min(row + TILE_SIZE, _configuration.GetPixelHeight());
+                tile.startColumn = column;
+                tile.endColumn = min(column + TILE_SIZE, _configuration.GetPixelLength());
+                _pool->Submit(renderGroup, [this, tile]() mutable { ShootRays(tile); });
+            }
+        }
+    }
+    _pool->Wait(renderGroup);
+    
+    // Combine images if in anaglyph mode
+    if(_configuration.IsAnaglyph()) {
+        // Convert images to grayscale
+        ConvertImageToGrayScale(_imageArray0, _configuration.GetPixelLength(), _configuration.GetPixelHeight());
+        ConvertImageToGrayScale(_imageArray1, _configuration.GetPixelLength(), _configuration.GetPixelHeight());
+        
+        
+        // Remove red channel from the first image
+        RemoveRedChannel(_imageArray0, _configuration.GetPixelLength(), _configuration.GetPixelHeight());
+        RemoveCyanChannel(_imageArray1, _configuration.GetPixelLength(), _configuration.GetPixelHeight());
+        
+        if(!_anaglyphImage) {
+            cout << "Failed to allocate memory.  Exiting" << endl;
+            exit(10);
+        }
+		
+		CreateAnaglyph();
+        
+        // Gamma correction on images
+        if(_configuration.GammaCorrect()) {
+            gammaCorrect(_imageArray1, _configuration.GetPixelHeight(), _configuration.GetPixelLength());
+            gammaCorrect(_anaglyphImage, _configuration.GetPixelHeight(), _configuration.GetPixelLength());
+        }
+    }
+    
+    
+    
+    // Gamma correction
+    if(_configuration.GammaCorrect()) {
+        gammaCorrect(_imageArray0, _configuration.GetPixelHeight(), _configuration.GetPixelLength());
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: RenderSequence
+ * Arguments:
+ *     int         - the first frame to render
+ *     int         - the last frame to render
+ *     std::string - the png file of the first (left eye) image, numbered for every frame
+ *     std::string - the png file of the second (right eye) image, numbered for every frame.  Only written in anaglyph mode
+ *     std::string - the png file of the anaglyph, numbered for every frame.  Only written in anaglyph mode
+ * Purpose: Renders a range of frames of the animation.  The images of a frame are handed to the writer thread in a
+ *          second set of image arrays, so they are encoded while the next frame is moved into place and traced
+ * Return Value: void
+ */
+void Renderer::RenderSequence(int firstFrame, int lastFrame, std::string firstImage, std::string secondImage, std::string anaglyphImage) {
+    int pixelLength = _configuration.GetPixelLength();
+    int pixelHeight = _configuration.GetPixelHeight();
+    size_t imageSize = 3 * pixelLength * pixelHeight * sizeof(unsigned char);
+    
+    // The arrays the writer encodes from.  Swapped with the image arrays after every frame
+    unsigned char * written[3];
+    written[0] = (unsigned char *) malloc(imageSize);
+    written[1] = (unsigned char *) malloc(imageSize);
+    written[2] = (unsigned char *) malloc(2 * imageSize);
+    if(!written[0] || !written[1] || !written[2]) {
+        cout << "Failed to allocate memory.  Exiting" << endl;
+        exit(10);
+    }
+    
+    for(int frame = firstFrame; frame <= lastFrame; frame++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        SetFrame(frame);
+        double update = ElapsedMilliseconds(start);
+        
+        start = std::chrono::steady_clock::now();
+        Render();
+        double render = ElapsedMilliseconds(start);
+        
+        // The previous frame has to be written before its arrays take the images of this one
+        start = std::chrono::steady_clock::now();
+        _writer->Wait();
+        double wait = ElapsedMilliseconds(start);
+        
+        std::swap(_imageArray0, written[0]);
+        std::swap(_imageArray1, written[1]);
+        std::swap(_anaglyphImage, written[2]);
+        _writer->Write(FrameFileName(firstImage, frame), written[0], pixelLength, pixelHeight);
+        if(_configuration.IsAnaglyph()) {
+            _writer->Write(FrameFileName(secondImage, frame), written[1], pixelLength, pixelHeight);
+            _writer->Write(FrameFileName(anaglyphImage, frame), written[2], pixelLength + _pixelOffset, pixelHeight);
+        }
+        
+        cout << "Frame " << frame << ": update " << update << " ms, render " << render << " ms, waited " << wait << " ms for the previous frame to be written" << endl;
+    }
+    _writer->Wait();
+    
+    free(written[0]);
+    free(written[1]);
+    free(written[2]);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: PrintConfiguration
+ * Arguments:
+ *     void
+ * Purpose: Prints the configuration and perspective information of the scene
+ * Return Value: void
+ */
+void Renderer::PrintConfiguration() {
+    
+    // Debug --- Configuration information
+    cout << "Configuration Information" << endl;
+    cout << "Anti-aliasing: "  << _configuration.IsAntialiased() << endl;
+    cout << "Gamma correction: " << _configuration.GammaCorrect() << endl;
+    cout << "Normal correction: "  << _configuration.NormalCorrect() << endl;
+    cout << "Ambient light value: " << _configuration.GetAmbientLight() << endl;
+    cout << "Image length: " << _configuration.GetPixelLength() << endl;
+    cout << "Image height: "  << _configuration.GetPixelHeight() << endl;
+    cout << "Render threads: " << _pool->GetThreadCount() << endl;
+    cout << "Geometry objects: " << _scene.GetObjects().size() << ", lights: " << _scene.GetLights().size() << endl;
+    cout << "Geometry shapes: " << _scene.GetShapeCount(Geometry::TRIANGLE) << " triangles, " << _scene.GetShapeCount(Geometry::SQUARE) << " squares, " << _scene.GetShapeCount(Geometry::SPHERE) << " spheres, "
+         << _scene.GetShapeCount(Geometry::SPHERE_SET) << " sphere sets, " << _scene.GetShapeCount(Geometry::MESH) << " meshes, " << _scene.GetShapeCount(Geometry::POINT) << " points" << endl;
+    if (_scene.GetPrototypeCount() > 0) {
+        cout << "Instances: " << _scene.GetShapeCount(Geometry::INSTANCE) << " of " << _scene.GetPrototypeCount() << " prototype meshes" << endl;
+    }
+    if (_animation.GetFrameCount() > 1) {
+        cout << "Animation: " << _animation.GetFrameCount() << " frames, " << _animation.GetTrackCount() << " moving objects" << endl;
+    }
+    cout << "Scene arena (KB): " << _scene.GetArena().GetUsed() / 1024.0 << " used, " << _scene.GetArena().GetReserved() / 1024.0 << " reserved in " << _scene.GetArena().GetBlockCount() << " blocks" << endl;
+    cout << "BVH nodes: " << _bvh.GetNodeCount() << " (depth " << _bvh.GetDepth() << ")" << endl;
+    if (_bvh.GetWidth() > 2) {
+        cout << "BVH layout: " << _bvh.GetWidth() << " wide, " << _bvh.GetWideNodeCount() << " nodes" << endl;
+    }
+    else {
+        cout << "BVH layout: binary" << endl;
+    }
+    const BVHBuildStats &buildStats = _bvh.GetBuildStats();
+    if (buildStats.fromCache) {
+        cout << "BVH build: loaded from the scene cache, " << buildStats.leaves << " leaves, SAH cost " << buildStats.sahCost << endl;
+    }
+    else {
+        cout << "BVH build: " << BVH::GetQualityName(_configuration.GetBvhQuality()) << " quality, " << buildStats.milliseconds << " ms on " << buildStats.threads << " threads, "
+             << buildStats.leaves << " leaves, SAH cost " << buildStats.sahCost << endl;
+    }
+    cout << "Packet tracing: " << _configuration.UsePacketTracing() << endl;
+    cout << "Stereo tracing: " << (_configuration.IsAnaglyph() && _configuration.UseStereoTracing()) << endl;
+    cout << "Triangle kernel: " << Simd::GetLevelName(_bvh.GetKernelLevel()) << endl;
+    cout << "PNG compression: " << _configuration.GetPngCompression() << endl;
+    if (!_cachePath.empty()) {
+        cout << "Scene cache: " << _cachePath << endl;
+    }
+    cout << "Scene load (ms): parse " << _loadTimings.parse << ", colors " << _loadTimings.colors << ", configuration " << _loadTimings.configuration
+         << ", perspective " << _loadTimings.perspective << ", geometry " << _loadTimings.geometry << ", cache " << _loadTimings.cache << endl;
+    
+    
+    // Debug --- PERSPECTIVE INFORMATION
+    cout << endl << "Perspective Information" << endl;
+    Vec3<float> temp = _perspective.GetImagePlane()->GetCorner();
+    cout << "Image Plane " << temp.x << " " << temp.y << " " << temp.z << endl;
+    cout << "Length of image plane " << _perspective.GetImagePlane()->GetLength() << endl;
+    cout << "Height of image plane " << _perspective.GetImagePlane()->GetHeight() << endl;
+    temp = _perspective.GetCameraPosition();
+    cout << "Camera Location " << temp.x << " " << temp.y << " " << temp.z << endl;
+    cout << "Anaglyph mode " << _perspective.GetAnaglyphMode() << endl;
+    cout << "Intereye distance " << _perspective.GetIntereyeDistance() << endl;
+    cout << "Units per length " << _perspective.GetUnitsPerLengthPixel() << endl;
+	cout << "Units per height " << _perspective.GetUnitsPerHeightPixel() << endl;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: WriteImages
+ * Arguments:
+ *     std::string - the png file of the first (left eye) image
+ *     std::string - the png file of the second (right eye) image.  Only written in anaglyph mode
+ * Purpose: Writes out the rendered image(s).  Both are compressed at once on the render threads, this returns once
+ *          they are written
+ * Return Value: void
+ */
+void Renderer::WriteImages(std::string firstImage, std::string secondImage) {
+    if(_configuration.IsAnaglyph()) {
+        _writer->Write(secondImage, _imageArray1, _configuration.GetPixelLength(), _configuration.GetPixelHeight());
+    }
+    _writer->Write(firstImage, _imageArray0, _configuration.GetPixelLength(), _configuration.GetPixelHeight());
+    _writer->Wait();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: WriteAnaglyph
+ * Arguments:
+ *     std::string - the png file to write the combined anaglyph to
+ * Purpose: Writes out the anaglyph image using the current pixel offset
+ * Return Value: void
+ */
+void Renderer::WriteAnaglyph(std::string anaglyphImage) {
+    _writer->Write(anaglyphImage, _anaglyphImage, _configuration.GetPixelLength()+_pixelOffset, _configuration.GetPixelHeight());
+    _writer->Wait();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: UpdateScene
+ * Arguments:
+ *     const std::vector<Geometry *> & - the objects of the scene that moved since the last render
+ * Purpose: Refits the hierarchy around geometry moved through GetScene so the next render sees it where it is now.
+ *          The hierarchy is rebuilt instead once refitting has made it too slow to trace
+ * Return Value: bool - true if the hierarchy was rebuilt
+ */
+bool Renderer::UpdateScene(const std::vector<Geometry *> &changed) {
+    return _bvh.Refit(_scene.GetObjects(), changed, _pool);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetFrame
+ * Arguments:
+ *     int - the frame of the animation
+ * Purpose: Moves the camera, the image plane and the objects of the animation to where they are at a frame.  Only the
+ *          objects that moved since the last frame are refit in the hierarchy
+ * Return Value: void
+ */
+void Renderer::SetFrame(int frame) {
+    Vec3<float> camera = _perspective.GetCameraPosition();
+    Vec3<float> corner = _perspective.GetImagePlane()->GetCorner();
+    bool cameraMoves = _animation.GetCamera(frame, camera);
+    bool cornerMoves = _animation.GetCorner(frame, corner);
+    if(cameraMoves || cornerMoves) {
+        _perspective.SetView(camera, corner);
+    }
+    
+    std::vector<Geometry *> &objects = _scene.GetObjects();
+    std::vector<Geometry *> changed;
+    for(int track = 0; track < _animation.GetTrackCount(); track++) {
+        Vec3<float> offset = _animation.GetObjectOffset(track, frame);
+        Vec3<float> move = offset - _trackOffsets[track];
+        if(move.x != 0 || move.y != 0 || move.z != 0) {
+            objects[_animation.GetTrackObject(track)]->Translate(move);
+            _trackOffsets[track] = offset;
+            changed.push_back(objects[_animation.GetTrackObject(track)]);
+        }
+    }
+    if(!changed.empty()) {
+        UpdateScene(changed);
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetConfiguration
+ * Arguments:
+ *     void
+ * Purpose: Returns the configuration of the scene
+ * Return Value: Config &
+ */
+Config & Renderer::GetConfiguration() {
+    return _configuration;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetScene
+ * Arguments:
+ *     void
+ * Purpose: Returns the geometry of the scene.  Call UpdateScene after moving any of it
+ * Return Value: Scene &
+ */
+Scene & Renderer::GetScene() {
+    return _scene;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetAnimation
+ * Arguments:
+ *     void
+ * Purpose: Returns the keyframes of the scene
+ * Return Value: Animation &
+ */
+Animation & Renderer::GetAnimation() {
+    return _animation;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetImage
+ * Arguments:
+ *     int - 0 for the first image, 1 for the second (anaglyph mode) image
+ * Purpose: Returns the RGB image array
+ * Return Value: unsigned char *
+ */
+unsigned char * Renderer::GetImage(int index) {
+    return index == 0 ? _imageArray0 : _imageArray1;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetAnaglyphImage
+ * Arguments:
+ *     void
+ * Purpose: Returns the RGB array of the combined anaglyph image
+ * Return Value: unsigned char *
+ */
+unsigned char * Renderer::GetAnaglyphImage() {
+    return _anaglyphImage;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPixelOffset
+ * Arguments:
+ *     void
+ * Purpose: Returns the pixel offset between the two images of the anaglyph
+ * Return Value: int
+ */
+int Renderer::GetPixelOffset() {
+    return _pixelOffset;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetPixelOffset
+ * Arguments:
+ *     int - the pixel offset between the two images of the anaglyph
+ * Purpose: Sets the pixel offset used by CreateAnaglyph and WriteAnaglyph
+ * Return Value: void
+ */
+void Renderer::SetPixelOffset(int offset) {
+    _pixelOffset = offset;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Animation.hpp"
+#include "BVH.hpp"
+#include "Color.hpp"
+#include "Config.hpp"
+#include "Geometry.hpp"
+#include "ImageWriter.hpp"
+#include "MaterialTable.hpp"
+#include "Perspective.hpp"
+#include "PrimaryRays.hpp"
+#include "RayHit.hpp"
+#include "Scene.hpp"
+#include "SceneLoader.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
+
+typedef struct {
+    int startRow;
+    int endRow;
+    int startColumn;
+    int endColumn;
+    bool isSecondary;
+    unsigned char * imageArray;
+    unsigned char * secondaryImageArray; // Second (right eye) image of a tile that traces both eyes, NULL otherwise
+} tileArgs;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: Renderer
+ * Purpose: Loads a scene file and raytraces it into image arrays.  Shared by the wxWidgets viewer and the
+ *          headless command line front end
+ */
+class Renderer {
+
+    public :
+    Renderer(std::string fileName);
+    ~Renderer();
+
+    void Render();
+    void RenderSequence(int firstFrame, int lastFrame, std::string firstImage, std::string secondImage, std::string anaglyphImage);
+    void CreateAnaglyph();
+    void WriteImages(std::string firstImage, std::string secondImage);
+    void WriteAnaglyph(std::string anaglyphImage);
+
+    bool UpdateScene(const std::vector<Geometry *> &changed);
+    void SetFrame(int frame);
+
+    Config & GetConfiguration();
+    Scene & GetScene();
+    Animation & GetAnimation();
+    unsigned char * GetImage(int index);
+    unsigned char * GetAnaglyphImage();
+    int GetPixelOffset();
+    void SetPixelOffset(int offset);
+
+    private :
+    void PrintConfiguration();
+    bool FollowReflections(bool hit, RayHit &rayHit);
+    Vec3<unsigned char> CheckShadows(float ambientLight, RayHit &rayHit);
+    void ShootRays(tileArgs &args);
+    template <bool antialiased, int eyes> void ShootTile(tileArgs &args);
+
+    std::string _fileName;
+    Color _colorMapping;
+    Scene _scene; // Declared before the material table and hierarchy that are stored in its arena, so it outlives them
+    MaterialTable _materials;
+    Config _configuration;
+    Perspective _perspective;
+    PrimaryRays _primaryRays;
+    ThreadPool * _pool;
+    ImageWriter * _writer;
+    BVH _bvh;
+    loadTimings _loadTimings;
+    Animation _animation;
+    std::vector<Vec3<float> > _trackOffsets; // Where SetFrame has moved every animated object so far
+    bool _printedConfiguration;
+    std::string _cachePath;
+
+    unsigned char * _imageArray0;
+    unsigned char * _imageArray1;
+    unsigned char * _anaglyphImage;
+    int _pixelOffset;
+};
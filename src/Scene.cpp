@@ -0,0 +1,458 @@
+#include "Scene.hpp"
+
+#include <new>
+#include <utility>
+
+/*
+ * Date: 10/17/26
+ * Function Name: ClearArray
+ * Arguments:
+ *     std::vector<T, ArenaAllocator<T> > & - the array
+ * Purpose: Destroys the elements of an array and lets go of its memory in the arena
+ * Return Value: void
+ */
+template <typename T>
+static void ClearArray(std::vector<T, ArenaAllocator<T> > &array) {
+	std::vector<T, ArenaAllocator<T> >(array.get_allocator()).swap(array);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Scene (constructor)
+ * Arguments:
+ *     void
+ * Purpose: Constructor for an empty scene
+ * Return Value: void
+ */
+Scene::Scene() : _arena(new Arena()), _triangles(ArenaAllocator<Triangle>(_arena)), _spheres(ArenaAllocator<Sphere>(_arena)),
+                 _squares(ArenaAllocator<Square>(_arena)), _points(ArenaAllocator<Point>(_arena)), _meshes(ArenaAllocator<Mesh>(_arena)),
+                 _sphereSets(ArenaAllocator<SphereSet>(_arena)), _instances(ArenaAllocator<Instance>(_arena)), _prototypes(ArenaAllocator<Mesh>(_arena)),
+                 _prototypeHierarchies(ArenaAllocator<BVH *>(_arena)), _entries(ArenaAllocator<sceneEntry>(_arena)) {
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ~Scene
+ * Arguments:
+ *     void
+ * Purpose: Destructor.  The geometry is destroyed before the arena it lives in is released
+ * Return Value: void
+ */
+Scene::~Scene() {
+	Clear();
+	delete(_arena);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Add
+ * Arguments:
+ *     Triangle - the triangle
+ *     bool     - true if it is a light
+ * Purpose: Adds a triangle.  Finish must be called before the object and light lists are used
+ * Return Value: void
+ */
+void Scene::Add(Triangle triangle, bool isLight) {
+	_triangles.push_back(std::move(triangle));
+	AddEntry(Geometry::TRIANGLE, (int)_triangles.size() - 1, isLight);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Add
+ * Arguments:
+ *     Sphere - the sphere
+ *     bool   - true if it is a light
+ * Purpose: Adds a sphere
+ * Return Value: void
+ */
+void Scene::Add(Sphere sphere, bool isLight) {
+	_spheres.push_back(std::move(sphere));
+	AddEntry(Geometry::SPHERE, (int)_spheres.size() - 1, isLight);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Add
+ * Arguments:
+ *     Square - the square
+ *     bool   - true if it is a light
+ * Purpose: Adds a square
+ * Return Value: void
+ */
+void Scene::Add(Square square, bool isLight) {
+	_squares.push_back(std::move(square));
+	AddEntry(Geometry::SQUARE, (int)_squares.size() - 1, isLight);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Add
+ * Arguments:
+ *     Point - the point
+ *     bool  - true if it is a light
+ * Purpose: Adds a point
+ * Return Value: void
+ */
+void Scene::Add(Point point, bool isLight) {
+	_points.push_back(std::move(point));
+	AddEntry(Geometry::POINT, (int)_points.size() - 1, isLight);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Add
+ * Arguments:
+ *     Mesh - the mesh.  Its vertex and index arrays are moved into the scene
+ *     bool - true if it is a light
+ * Purpose: Adds a mesh
+ * Return Value: void
+ */
+void Scene::Add(Mesh mesh, bool isLight) {
+	_meshes.push_back(std::move(mesh));
+	AddEntry(Geometry::MESH, (int)_meshes.size() - 1, isLight);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Add
+ * Arguments:
+ *     SphereSet - the sphere set.  Its packets are moved into the scene
+ *     bool      - true if it is a light
+ * Purpose: Adds a sphere set
+ * Return Value: void
+ */
+void Scene::Add(SphereSet sphereSet, bool isLight) {
+	_sphereSets.push_back(std::move(sphereSet));
+	AddEntry(Geometry::SPHERE_SET, (int)_sphereSets.size() - 1, isLight);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Add
+ * Arguments:
+ *     Instance - the instance of a prototype of this scene
+ *     bool     - true if it is a light
+ * Purpose: Adds an instance
+ * Return Value: void
+ */
+void Scene::Add(Instance instance, bool isLight) {
+	_instances.push_back(std::move(instance));
+	AddEntry(Geometry::INSTANCE, (int)_instances.size() - 1, isLight);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddPrototype
+ * Arguments:
+ *     Mesh - the mesh.  Its vertex and index arrays are moved into the scene
+ * Purpose: Adds a mesh that is only drawn through instances.  All of the prototypes must be added before any of
+ *          their instances
+ * Return Value: int - the index of the prototype
+ */
+int Scene::AddPrototype(Mesh mesh) {
+	_prototypes.push_back(std::move(mesh));
+	_prototypeHierarchies.push_back(new (_arena->Allocate(sizeof(BVH), alignof(BVH))) BVH(_arena));
+	return (int)_prototypes.size() - 1;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: BuildPrototypes
+ * Arguments:
+ *     ThreadPool * - builds large hierarchies in parallel, NULL to build on the calling thread only
+ *     bvh_quality  - how hard to look for good splits
+ *     int          - the children per node the hierarchies are traced with
+ * Purpose: Builds the hierarchy of every prototype.  Must be done before the hierarchy over the objects, which
+ *          bounds the instances by the hierarchies of their prototypes
+ * Return Value: void
+ */
+void Scene::BuildPrototypes(ThreadPool * pool, bvh_quality quality, int width) {
+	for (size_t i = 0; i < _prototypes.size(); i++) {
+		std::vector<Geometry *> geometry(1, &_prototypes[i]);
+		_prototypeHierarchies[i]->SetWidth(width);
+		_prototypeHierarchies[i]->Build(geometry, pool, quality);
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Reserve
+ * Arguments:
+ *     Geometry::Shape - the shape
+ *     int             - the number of objects and lights of the shape that will be added
+ * Purpose: Sizes the array of a shape before anything is added to it.  Arrays that grow leave their old memory
+ *          behind in the arena until it is released
+ * Return Value: void
+ */
+void Scene::Reserve(Geometry::Shape shape, int count) {
+	switch (shape) {
+		case Geometry::TRIANGLE :
+			_triangles.reserve(count);
+			break;
+		case Geometry::SPHERE :
+			_spheres.reserve(count);
+			break;
+		case Geometry::SQUARE :
+			_squares.reserve(count);
+			break;
+		case Geometry::POINT :
+			_points.reserve(count);
+			break;
+		case Geometry::MESH :
+			_meshes.reserve(count);
+			break;
+		case Geometry::SPHERE_SET :
+			_sphereSets.reserve(count);
+			break;
+		case Geometry::INSTANCE :
+			_instances.reserve(count);
+			break;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ReserveEntries
+ * Arguments:
+ *     int - the number of objects and lights of every shape that will be added
+ * Purpose: Sizes the list of entries before anything is added, so it is allocated once in the arena
+ * Return Value: void
+ */
+void Scene::ReserveEntries(int count) {
+	_entries.reserve(count);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ReservePrototypes
+ * Arguments:
+ *     int - the number of prototypes that will be added
+ * Purpose: Sizes the prototype array before the first prototype is added
+ * Return Value: void
+ */
+void Scene::ReservePrototypes(int count) {
+	_prototypes.reserve(count);
+	_prototypeHierarchies.reserve(count);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Finish
+ * Arguments:
+ *     void
+ * Purpose: Builds the object and light lists once everything is added.  They keep the order the geometry was
+ *          added in, so the hierarchy and the scene cache do not depend on how the arrays are split by shape
+ * Return Value: void
+ */
+void Scene::Finish() {
+	_objects.clear();
+	_lights.clear();
+	for (size_t i = 0; i < _entries.size(); i++) {
+		if (_entries[i].isLight) {
+			_lights.push_back(GetGeometry(_entries[i]));
+		}
+		else {
+			_objects.push_back(GetGeometry(_entries[i]));
+		}
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Clear
+ * Arguments:
+ *     void
+ * Purpose: Removes all of the geometry and releases the arena in one go.  That also frees the hierarchies and the
+ *          material table stored in the arena, which have to be set to the arena again and rebuilt before use
+ * Return Value: void
+ */
+void Scene::Clear() {
+	ClearArray(_triangles);
+	ClearArray(_spheres);
+	ClearArray(_squares);
+	ClearArray(_points);
+	ClearArray(_meshes);
+	ClearArray(_sphereSets);
+	ClearArray(_instances);
+	ClearArray(_prototypes);
+	ClearArray(_entries);
+	for (size_t i = 0; i < _prototypeHierarchies.size(); i++) {
+		_prototypeHierarchies[i]->~BVH();
+	}
+	ClearArray(_prototypeHierarchies);
+	_objects.clear();
+	_lights.clear();
+	_arena->Release();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Swap
+ * Arguments:
+ *     Scene & - the other scene
+ * Purpose: Exchanges the geometry of two scenes along with their arenas.  The geometry itself does not move, so
+ *          the object and light lists (and a hierarchy built over them) and the instances stay valid
+ * Return Value: void
+ */
+void Scene::Swap(Scene &other) {
+	std::swap(_arena, other._arena);
+	_triangles.swap(other._triangles);
+	_spheres.swap(other._spheres);
+	_squares.swap(other._squares);
+	_points.swap(other._points);
+	_meshes.swap(other._meshes);
+	_sphereSets.swap(other._sphereSets);
+	_instances.swap(other._instances);
+	_prototypes.swap(other._prototypes);
+	_prototypeHierarchies.swap(other._prototypeHierarchies);
+	_entries.swap(other._entries);
+	_objects.swap(other._objects);
+	_lights.swap(other._lights);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetObjects
+ * Arguments:
+ *     void
+ * Purpose: Returns the objects, the geometry the hierarchy is built over
+ * Return Value: std::vector<Geometry *> &
+ */
+std::vector<Geometry *> & Scene::GetObjects() {
+	return _objects;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetLights
+ * Arguments:
+ *     void
+ * Purpose: Returns the lights
+ * Return Value: std::vector<Geometry *> &
+ */
+std::vector<Geometry *> & Scene::GetLights() {
+	return _lights;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetShapeCount
+ * Arguments:
+ *     Geometry::Shape - the shape
+ * Purpose: Returns the number of objects and lights of a shape
+ * Return Value: int
+ */
+int Scene::GetShapeCount(Geometry::Shape shape) {
+	switch (shape) {
+		case Geometry::TRIANGLE :
+			return (int)_triangles.size();
+		case Geometry::SPHERE :
+			return (int)_spheres.size();
+		case Geometry::SQUARE :
+			return (int)_squares.size();
+		case Geometry::POINT :
+			return (int)_points.size();
+		case Geometry::MESH :
+			return (int)_meshes.size();
+		case Geometry::SPHERE_SET :
+			return (int)_sphereSets.size();
+		case Geometry::INSTANCE :
+			return (int)_instances.size();
+	}
+	return 0;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPrototypeCount
+ * Arguments:
+ *     void
+ * Purpose: Returns the number of meshes that are instanced
+ * Return Value: int
+ */
+int Scene::GetPrototypeCount() {
+	return (int)_prototypes.size();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPrototype
+ * Arguments:
+ *     int - the prototype
+ * Purpose: Returns the mesh of a prototype
+ * Return Value: Mesh &
+ */
+Mesh & Scene::GetPrototype(int index) {
+	return _prototypes[index];
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPrototypeHierarchy
+ * Arguments:
+ *     int - the prototype
+ * Purpose: Returns the hierarchy shared by the instances of a prototype
+ * Return Value: BVH *
+ */
+BVH * Scene::GetPrototypeHierarchy(int index) {
+	return _prototypeHierarchies[index];
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetArena
+ * Arguments:
+ *     void
+ * Purpose: Returns the arena the geometry is stored in, for its usage
+ * Return Value: Arena &
+ */
+Arena & Scene::GetArena() {
+	return *_arena;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddEntry
+ * Arguments:
+ *     Geometry::Shape - the array the geometry was added to
+ *     int             - its index in that array
+ *     bool            - true if it is a light
+ * Purpose: Records the order geometry is added in
+ * Return Value: void
+ */
+void Scene::AddEntry(Geometry::Shape shape, int index, bool isLight) {
+	sceneEntry entry;
+	entry.shape = shape;
+	entry.index = index;
+	entry.isLight = isLight;
+	_entries.push_back(entry);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetGeometry
+ * Arguments:
+ *     const sceneEntry & - the entry
+ * Purpose: Finds the geometry of an entry in the array of its shape
+ * Return Value: Geometry *
+ */
+Geometry * Scene::GetGeometry(const sceneEntry &entry) {
+	switch (entry.shape) {
+		case Geometry::TRIANGLE :
+			return &_triangles[entry.index];
+		case Geometry::SPHERE :
+			return &_spheres[entry.index];
+		case Geometry::SQUARE :
+			return &_squares[entry.index];
+		case Geometry::POINT :
+			return &_points[entry.index];
+		case Geometry::MESH :
+			return &_meshes[entry.index];
+		case Geometry::SPHERE_SET :
+			return &_sphereSets[entry.index];
+		case Geometry::INSTANCE :
+			return &_instances[entry.index];
+	}
+	return NULL;
+}
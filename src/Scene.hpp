@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+
+#include "Arena.hpp"
+#include "BVH.hpp"
+#include "Geometry.hpp"
+#include "Instance.hpp"
+#include "Mesh.hpp"
+#include "Point.hpp"
+#include "Sphere.hpp"
+#include "SphereSet.hpp"
+#include "Square.hpp"
+#include "Triangle.hpp"
+
+// An object or light in the order it was added.  The shape selects the array it is stored in and the index is its
+// position in that array
+typedef struct {
+	Geometry::Shape shape;
+	int index;
+	bool isLight;
+} sceneEntry;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: Scene
+ * Purpose: Owns the geometry of a scene.  Every shape is stored by value in its own contiguous array instead of
+ *          being allocated one object at a time, and the object and light lists the BVH and the renderer walk
+ *          point into those arrays.  The arrays live in an arena of the scene that is released all at once,
+ *          together with the mesh and sphere set arrays and the hierarchies and material table given the arena.
+ *          Meshes that are instanced are kept apart from the objects, each with a hierarchy of its own
+ */
+class Scene {
+
+	public :
+		Scene();
+		~Scene();
+
+		void Add(Triangle triangle, bool isLight);
+		void Add(Sphere sphere, bool isLight);
+		void Add(Square square, bool isLight);
+		void Add(Point point, bool isLight);
+		void Add(Mesh mesh, bool isLight);
+		void Add(SphereSet sphereSet, bool isLight);
+		void Add(Instance instance, bool isLight);
+		int AddPrototype(Mesh mesh);
+		void BuildPrototypes(ThreadPool * pool, bvh_quality quality, int width);
+		void Reserve(Geometry::Shape shape, int count);
+		void ReserveEntries(int count);
+		void ReservePrototypes(int count);
+		void Finish();
+		void Clear();
+		void Swap(Scene &other);
+
+		std::vector<Geometry *> & GetObjects();
+		std::vector<Geometry *> & GetLights();
+		int GetShapeCount(Geometry::Shape shape);
+		int GetPrototypeCount();
+		Mesh & GetPrototype(int index);
+		BVH * GetPrototypeHierarchy(int index);
+		Arena & GetArena();
+
+	private :
+		// The object and light lists point into the arrays, so a scene cannot be copied
+		Scene(const Scene &other);
+		Scene & operator=(const Scene &other);
+
+		void AddEntry(Geometry::Shape shape, int index, bool isLight);
+		Geometry * GetGeometry(const sceneEntry &entry);
+
+		Arena * _arena;
+		std::vector<Triangle, ArenaAllocator<Triangle> > _triangles;
+		std::vector<Sphere, ArenaAllocator<Sphere> > _spheres;
+		std::vector<Square, ArenaAllocator<Square> > _squares;
+		std::vector<Point, ArenaAllocator<Point> > _points;
+		std::vector<Mesh, ArenaAllocator<Mesh> > _meshes;
+		std::vector<SphereSet, ArenaAllocator<SphereSet> > _sphereSets;
+		std::vector<Instance, ArenaAllocator<Instance> > _instances;
+
+		// The hierarchies are allocated in the arena with the prototype, so instances can point at them before they
+		// are built and they never move
+		std::vector<Mesh, ArenaAllocator<Mesh> > _prototypes;
+		std::vector<BVH *, ArenaAllocator<BVH *> > _prototypeHierarchies;
+
+		std::vector<sceneEntry, ArenaAllocator<sceneEntry> > _entries;
+		std::vector<Geometry *> _objects;
+		std::vector<Geometry *> _lights;
+};
@@ -0,0 +1,479 @@
+/* Standard libs */
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+/* Project headers */
+#include "SceneCache.hpp"
+#include "Instance.hpp"
+#include "Material.hpp"
+#include "Mesh.hpp"
+#include "Point.hpp"
+#include "Sphere.hpp"
+#include "SphereSet.hpp"
+#include "Square.hpp"
+#include "Triangle.hpp"
+
+/*
+ * Date: 10/17/26
+ * Function Name: SceneCache (constructor)
+ * Arguments:
+ *     std::string - the cache file
+ *     uint64_t    - the hash of the scene geometry the cache must match
+ * Purpose: Constructor
+ * Return Value: void
+ */
+SceneCache::SceneCache(std::string fileName, uint64_t hash) : _fileName(fileName), _hash(hash) {
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Load
+ * Arguments:
+ *     MaterialTable &           - replaced by the materials of the scene
+ *     Scene &                   - replaced by the objects and lights of the scene
+ *     BVH &                     - restored to the hierarchy over the objects
+ * Purpose: Maps the cache file and recreates the geometry and the hierarchies of the objects and prototypes from it
+ * Return Value: bool - false if the cache is missing, stale or damaged.  Nothing is filled in that case
+ */
+bool SceneCache::Load(MaterialTable &materials, Scene &scene, BVH &bvh) {
+	MappedFile file;
+	if (!file.Open(_fileName) || file.GetSize() < sizeof(sceneCacheHeader)) {
+		return false;
+	}
+
+	sceneCacheHeader header;
+	memcpy(&header, file.GetData(), sizeof(header));
+	if (header.magic != SCENE_CACHE_MAGIC || header.version != SCENE_CACHE_VERSION || header.hash != _hash) {
+		return false;
+	}
+	if (header.objectCount < 0 || header.lightCount < 0 || header.vertexCount < 0 || header.indexCount < 0 || header.nodeCount < 0 || header.referenceCount < 0 || header.radiusCount < 0
+	    || header.materialCount < 1 || header.materialCount > MATERIAL_TABLE_SIZE || header.prototypeCount < 0 || header.prototypeNodeCount < 0 || header.prototypeReferenceCount < 0) {
+		return false;
+	}
+
+	// Every array is a multiple of 4 bytes and the header a multiple of 8 so the arrays are aligned in the mapping
+	size_t materialOffset = sizeof(sceneCacheHeader);
+	size_t primitiveOffset = materialOffset + sizeof(cachedMaterial) * (size_t)header.materialCount;
+	if ((int64_t)header.objectCount + header.lightCount + header.prototypeCount > INT_MAX) {
+		return false;
+	}
+	int primitiveCount = header.objectCount + header.lightCount + header.prototypeCount;
+	size_t vertexOffset = primitiveOffset + sizeof(cachedPrimitive) * (size_t)primitiveCount;
+	size_t indexOffset = vertexOffset + 3 * sizeof(float) * (size_t)header.vertexCount;
+	size_t radiusOffset = indexOffset + sizeof(int32_t) * (size_t)header.indexCount;
+	size_t nodeOffset = radiusOffset + sizeof(float) * (size_t)header.radiusCount;
+	size_t referenceOffset = nodeOffset + sizeof(BVHNode) * (size_t)header.nodeCount;
+	size_t hierarchyOffset = referenceOffset + sizeof(BVHReference) * (size_t)header.referenceCount;
+	size_t prototypeNodeOffset = hierarchyOffset + sizeof(cachedHierarchy) * (size_t)header.prototypeCount;
+	size_t prototypeReferenceOffset = prototypeNodeOffset + sizeof(BVHNode) * (size_t)header.prototypeNodeCount;
+	size_t totalSize = prototypeReferenceOffset + sizeof(BVHReference) * (size_t)header.prototypeReferenceCount;
+	if (file.GetSize() != totalSize) {
+		return false;
+	}
+
+	const cachedMaterial * cachedMaterials = (const cachedMaterial *)(file.GetData() + materialOffset);
+	const cachedPrimitive * primitives = (const cachedPrimitive *)(file.GetData() + primitiveOffset);
+	const unsigned char * vertices = file.GetData() + vertexOffset;
+	const unsigned char * indices = file.GetData() + indexOffset;
+	const unsigned char * radii = file.GetData() + radiusOffset;
+	const BVHNode * nodes = (const BVHNode *)(file.GetData() + nodeOffset);
+	const BVHReference * references = (const BVHReference *)(file.GetData() + referenceOffset);
+	const cachedHierarchy * hierarchies = (const cachedHierarchy *)(file.GetData() + hierarchyOffset);
+	const BVHNode * prototypeNodes = (const BVHNode *)(file.GetData() + prototypeNodeOffset);
+	const BVHReference * prototypeReferences = (const BVHReference *)(file.GetData() + prototypeReferenceOffset);
+
+	// The table is rebuilt in the stored order.  A stored table the loader could not have made gets other ids
+	Scene newScene;
+	MaterialTable newMaterials(&newScene.GetArena());
+	bool valid = true;
+	for (int i = 1; valid && i < header.materialCount; i++) {
+		const cachedMaterial &material = cachedMaterials[i];
+		valid = material.type >= MATERIAL_REFLECTIVE && material.type <= MATERIAL_NONE
+		        && newMaterials.Add(Vec3<unsigned char>::vec3(material.color[0], material.color[1], material.color[2]), (Material)material.type) == i;
+	}
+
+	int shapeCounts[Geometry::INSTANCE + 1] = { 0 };
+	int firstPrototype = header.objectCount + header.lightCount;
+	for (int i = 0; valid && i < primitiveCount; i++) {
+		valid = i < firstPrototype ? (primitives[i].shape >= 0 && primitives[i].shape <= Geometry::INSTANCE) : primitives[i].shape == Geometry::MESH;
+		shapeCounts[valid && i < firstPrototype ? primitives[i].shape : 0]++;
+	}
+	for (int shape = 0; shape <= Geometry::INSTANCE; shape++) {
+		newScene.Reserve((Geometry::Shape)shape, shapeCounts[shape]);
+	}
+	newScene.ReserveEntries(firstPrototype);
+	newScene.ReservePrototypes(header.prototypeCount);
+
+	// Each flat array is copied out of the mapping once, into the arena of the scene.  The meshes and sphere sets
+	// point into these copies instead of getting arrays of their own
+	static_assert(sizeof(Vec3<float>) == 3 * sizeof(float), "cached vertices are stored as three floats");
+	static_assert(sizeof(int) == sizeof(int32_t), "cached indices are stored as 32 bit integers");
+	Arena &arena = newScene.GetArena();
+	Vec3<float> * sceneVertices = (Vec3<float> *)arena.Allocate(sizeof(Vec3<float>) * (size_t)header.vertexCount, alignof(Vec3<float>));
+	int * sceneIndices = (int *)arena.Allocate(sizeof(int) * (size_t)header.indexCount, alignof(int));
+	float * sceneRadii = (float *)arena.Allocate(sizeof(float) * (size_t)header.radiusCount, alignof(float));
+	memcpy(sceneVertices, vertices, sizeof(Vec3<float>) * (size_t)header.vertexCount);
+	memcpy(sceneIndices, indices, sizeof(int) * (size_t)header.indexCount);
+	memcpy(sceneRadii, radii, sizeof(float) * (size_t)header.radiusCount);
+
+	// The prototypes are created first so the instances can point at them
+	for (int i = firstPrototype; valid && i < primitiveCount; i++) {
+		valid = CreatePrimitive(primitives[i], false, true, header.materialCount, sceneVertices, header.vertexCount, sceneIndices, header.indexCount, sceneRadii, header.radiusCount, newScene);
+	}
+	for (int i = 0; valid && i < firstPrototype; i++) {
+		valid = CreatePrimitive(primitives[i], i >= header.objectCount, false, header.materialCount, sceneVertices, header.vertexCount, sceneIndices, header.indexCount, sceneRadii, header.radiusCount, newScene);
+	}
+	newScene.Finish();
+	std::vector<Geometry *> &newGeometry = newScene.GetObjects();
+
+	// Make sure a damaged hierarchy cannot send the traversal out of bounds
+	for (int i = 0; valid && i < header.referenceCount; i++) {
+		const BVHReference &reference = references[i];
+		valid = reference.geometry >= 0 && reference.geometry < header.objectCount && reference.primitive >= -1
+		        && reference.primitive < newGeometry[reference.geometry]->GetPrimitiveCount() + (reference.primitive < 0 ? 1 : 0);
+	}
+	valid = valid && BVH::Validate(nodes, header.nodeCount, header.referenceCount, header.depth);
+
+	// The hierarchies of the prototypes are checked the same way, each against its one mesh
+	int firstNode = 0;
+	int firstReference = 0;
+	for (int i = 0; valid && i < header.prototypeCount; i++) {
+		const cachedHierarchy &hierarchy = hierarchies[i];
+		valid = hierarchy.nodeCount >= 0 && hierarchy.referenceCount >= 0 && hierarchy.nodeCount <= header.prototypeNodeCount - firstNode
+		        && hierarchy.referenceCount <= header.prototypeReferenceCount - firstReference
+		        && BVH::Validate(prototypeNodes + firstNode, hierarchy.nodeCount, hierarchy.referenceCount, hierarchy.depth);
+		int meshPrimitives = valid ? newScene.GetPrototype(i).GetPrimitiveCount() : 0;
+		for (int j = 0; valid && j < hierarchy.referenceCount; j++) {
+			const BVHReference &reference = prototypeReferences[firstReference + j];
+			valid = reference.geometry == 0 && reference.primitive >= -1 && reference.primitive < meshPrimitives + (reference.primitive < 0 ? 1 : 0);
+		}
+		firstNode += valid ? hierarchy.nodeCount : 0;
+		firstReference += valid ? hierarchy.referenceCount : 0;
+	}
+	valid = valid && firstNode == header.prototypeNodeCount && firstReference == header.prototypeReferenceCount;
+
+	if (!valid) {
+		return false;
+	}
+
+	// Swapping keeps the geometry and its arena where they are, so the hierarchy and the table can be stored in
+	// that arena and point at the geometry already
+	materials = newMaterials;
+	// The instances are bounded by the hierarchies of their prototypes, so those are loaded first.  They are traced
+	// with the same width as the hierarchy over the objects
+	firstNode = 0;
+	firstReference = 0;
+	for (int i = 0; i < header.prototypeCount; i++) {
+		const cachedHierarchy &hierarchy = hierarchies[i];
+		std::vector<Geometry *> prototype(1, &newScene.GetPrototype(i));
+		BVH * prototypeHierarchy = newScene.GetPrototypeHierarchy(i);
+		prototypeHierarchy->SetWidth(bvh.GetWidth());
+		prototypeHierarchy->Load(prototype, prototypeNodes + firstNode, hierarchy.nodeCount, prototypeReferences + firstReference, hierarchy.referenceCount, hierarchy.depth);
+		firstNode += hierarchy.nodeCount;
+		firstReference += hierarchy.referenceCount;
+	}
+
+	bvh.SetArena(&newScene.GetArena());
+	bvh.Load(newGeometry, nodes, header.nodeCount, references, header.referenceCount, header.depth);
+	scene.Swap(newScene);
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Save
+ * Arguments:
+ *     MaterialTable &           - the materials of the scene
+ *     Scene &                   - the objects and lights of the scene
+ *     BVH &                     - the hierarchy built over the objects
+ * Purpose: Writes the cache file.  It is written under a temporary name and renamed so a reader never maps a
+ *          partial file
+ * Return Value: bool - false if the file could not be written
+ */
+bool SceneCache::Save(MaterialTable &materials, Scene &scene, BVH &bvh) {
+	std::vector<Geometry *> &geometry = scene.GetObjects();
+	std::vector<Geometry *> &lights = scene.GetLights();
+	std::vector<cachedMaterial> cachedMaterials(materials.GetCount());
+	for (int i = 0; i < materials.GetCount(); i++) {
+		const materialEntry &entry = materials.Get((materialId)i);
+		memset(&cachedMaterials[i], 0, sizeof(cachedMaterial));
+		cachedMaterials[i].color[0] = entry.color.x;
+		cachedMaterials[i].color[1] = entry.color.y;
+		cachedMaterials[i].color[2] = entry.color.z;
+		cachedMaterials[i].type = (int32_t)entry.type;
+	}
+
+	std::vector<cachedPrimitive> primitives;
+	std::vector<float> vertices;
+	std::vector<int32_t> indices;
+	std::vector<float> radii;
+	primitives.reserve(geometry.size() + lights.size() + scene.GetPrototypeCount());
+	for (size_t i = 0; i < geometry.size(); i++) {
+		AddPrimitive(geometry[i], primitives, vertices, indices, radii);
+	}
+	for (size_t i = 0; i < lights.size(); i++) {
+		AddPrimitive(lights[i], primitives, vertices, indices, radii);
+	}
+	for (int i = 0; i < scene.GetPrototypeCount(); i++) {
+		AddPrimitive(&scene.GetPrototype(i), primitives, vertices, indices, radii);
+	}
+
+	const std::vector<BVHNode, ArenaAllocator<BVHNode> > &nodes = bvh.GetNodes();
+	std::vector<BVHReference> references = bvh.GetReferences(geometry);
+
+	// The hierarchies of the prototypes are stored too so a warm start does not build them again
+	std::vector<cachedHierarchy> hierarchies(scene.GetPrototypeCount());
+	std::vector<BVHNode> prototypeNodes;
+	std::vector<BVHReference> prototypeReferences;
+	for (int i = 0; i < scene.GetPrototypeCount(); i++) {
+		std::vector<Geometry *> prototype(1, &scene.GetPrototype(i));
+		BVH * prototypeHierarchy = scene.GetPrototypeHierarchy(i);
+		const std::vector<BVHNode, ArenaAllocator<BVHNode> > &hierarchyNodes = prototypeHierarchy->GetNodes();
+		std::vector<BVHReference> hierarchyReferences = prototypeHierarchy->GetReferences(prototype);
+		hierarchies[i].nodeCount = (int32_t)hierarchyNodes.size();
+		hierarchies[i].referenceCount = (int32_t)hierarchyReferences.size();
+		hierarchies[i].depth = prototypeHierarchy->GetDepth();
+		prototypeNodes.insert(prototypeNodes.end(), hierarchyNodes.begin(), hierarchyNodes.end());
+		prototypeReferences.insert(prototypeReferences.end(), hierarchyReferences.begin(), hierarchyReferences.end());
+	}
+
+	sceneCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = SCENE_CACHE_MAGIC;
+	header.version = SCENE_CACHE_VERSION;
+	header.hash = _hash;
+	header.objectCount = (int32_t)geometry.size();
+	header.lightCount = (int32_t)lights.size();
+	header.vertexCount = (int32_t)(vertices.size() / 3);
+	header.indexCount = (int32_t)indices.size();
+	header.nodeCount = (int32_t)nodes.size();
+	header.referenceCount = (int32_t)references.size();
+	header.depth = bvh.GetDepth();
+	header.radiusCount = (int32_t)radii.size();
+	header.materialCount = (int32_t)cachedMaterials.size();
+	header.prototypeCount = (int32_t)scene.GetPrototypeCount();
+	header.prototypeNodeCount = (int32_t)prototypeNodes.size();
+	header.prototypeReferenceCount = (int32_t)prototypeReferences.size();
+
+	std::string tempName = _fileName + ".tmp";
+	std::ofstream out(tempName.c_str(), std::ios::binary | std::ios::trunc);
+	if (!out) {
+		return false;
+	}
+	out.write((const char *)&header, sizeof(header));
+	out.write((const char *)&cachedMaterials[0], sizeof(cachedMaterial) * cachedMaterials.size());
+	if (!primitives.empty()) {
+		out.write((const char *)&primitives[0], sizeof(cachedPrimitive) * primitives.size());
+	}
+	if (!vertices.empty()) {
+		out.write((const char *)&vertices[0], sizeof(float) * vertices.size());
+	}
+	if (!indices.empty()) {
+		out.write((const char *)&indices[0], sizeof(int32_t) * indices.size());
+	}
+	if (!radii.empty()) {
+		out.write((const char *)&radii[0], sizeof(float) * radii.size());
+	}
+	if (!nodes.empty()) {
+		out.write((const char *)&nodes[0], sizeof(BVHNode) * nodes.size());
+	}
+	if (!references.empty()) {
+		out.write((const char *)&references[0], sizeof(BVHReference) * references.size());
+	}
+	if (!hierarchies.empty()) {
+		out.write((const char *)&hierarchies[0], sizeof(cachedHierarchy) * hierarchies.size());
+	}
+	if (!prototypeNodes.empty()) {
+		out.write((const char *)&prototypeNodes[0], sizeof(BVHNode) * prototypeNodes.size());
+	}
+	if (!prototypeReferences.empty()) {
+		out.write((const char *)&prototypeReferences[0], sizeof(BVHReference) * prototypeReferences.size());
+	}
+	out.close();
+	if (!out) {
+		remove(tempName.c_str());
+		return false;
+	}
+
+#ifdef _WIN32
+	// rename does not replace an existing file on windows
+	remove(_fileName.c_str());
+#endif
+	if (rename(tempName.c_str(), _fileName.c_str()) != 0) {
+		remove(tempName.c_str());
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AddPrimitive
+ * Arguments:
+ *     Geometry *                     - the object or light to store
+ *     std::vector<cachedPrimitive> & - the primitive array
+ *     std::vector<float> &           - the flat vertex array
+ *     std::vector<int32_t> &         - the mesh index array
+ *     std::vector<float> &           - the sphere set radius array
+ * Purpose: Appends the record and vertices of one object or light
+ * Return Value: void
+ */
+void SceneCache::AddPrimitive(Geometry * geom, std::vector<cachedPrimitive> &primitives, std::vector<float> &vertices, std::vector<int32_t> &indices, std::vector<float> &radii) {
+	cachedPrimitive primitive;
+	memset(&primitive, 0, sizeof(primitive));
+	primitive.shape = (int32_t)geom->GetShape();
+	primitive.material = (int32_t)geom->GetMaterialId();
+	primitive.firstVertex = (int32_t)(vertices.size() / 3);
+	primitive.firstIndex = (int32_t)indices.size();
+
+	std::vector<Vec3<float> > points;
+	switch (geom->GetShape()) {
+		case Geometry::TRIANGLE :
+			for (int i = 0; i < 3; i++) {
+				points.push_back(((Triangle *)geom)->GetVertex(i));
+			}
+			break;
+		case Geometry::SQUARE :
+			for (int i = 0; i < 4; i++) {
+				points.push_back(((Square *)geom)->GetVertex(i));
+			}
+			break;
+		case Geometry::SPHERE :
+			points.push_back(((Sphere *)geom)->GetCenter());
+			primitive.radius = ((Sphere *)geom)->GetRadius();
+			break;
+		case Geometry::POINT :
+			points.push_back(geom->GetRandomPoint());
+			break;
+		case Geometry::MESH : {
+			Mesh * mesh = (Mesh *)geom;
+			points.assign(mesh->GetVertices(), mesh->GetVertices() + mesh->GetVertexCount());
+			indices.insert(indices.end(), mesh->GetIndices(), mesh->GetIndices() + 3 * mesh->GetTriangleCount());
+			break;
+		}
+		case Geometry::SPHERE_SET :
+			primitive.firstIndex = (int32_t)radii.size();
+			for (int i = 0; i < ((SphereSet *)geom)->GetSphereCount(); i++) {
+				points.push_back(((SphereSet *)geom)->GetCenter(i));
+				radii.push_back(((SphereSet *)geom)->GetRadius(i));
+			}
+			break;
+		case Geometry::INSTANCE :
+			primitive.firstIndex = (int32_t)((Instance *)geom)->GetPrototype();
+			for (int i = 0; i < 4; i++) {
+				points.push_back(((Instance *)geom)->GetTransform().GetColumn(i));
+			}
+			break;
+	}
+
+	for (size_t i = 0; i < points.size(); i++) {
+		vertices.push_back(points[i].x);
+		vertices.push_back(points[i].y);
+		vertices.push_back(points[i].z);
+	}
+	primitive.vertexCount = (int32_t)points.size();
+	if (geom->GetShape() == Geometry::SPHERE_SET) {
+		primitive.indexCount = primitive.vertexCount;
+	}
+	else if (geom->GetShape() != Geometry::INSTANCE) {
+		primitive.indexCount = (int32_t)indices.size() - primitive.firstIndex;
+	}
+	primitives.push_back(primitive);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: CreatePrimitive
+ * Arguments:
+ *     const cachedPrimitive & - the stored record
+ *     bool                    - true if the record is a light
+ *     bool                    - true if the record is a mesh that is instanced
+ *     int                     - the number of materials in the material table
+ *     Vec3<float> *           - the vertex array of the scene
+ *     int                     - the number of vertices in the array
+ *     const int *             - the mesh index array of the scene
+ *     int                     - the number of indices in the array
+ *     const float *           - the sphere set radius array of the scene
+ *     int                     - the number of radii in the array
+ *     Scene &                 - gets the object or light
+ * Purpose: Creates the object or light described by a record.  Meshes and sphere sets point into the arrays, which
+ *          are kept in the arena of the scene
+ * Return Value: bool - false if the record is damaged
+ */
+bool SceneCache::CreatePrimitive(const cachedPrimitive &primitive, bool isLight, bool isPrototype, int materialCount, Vec3<float> * vertices, int vertexCount, const int * indices, int indexCount, const float * radii, int radiusCount, Scene &scene) {
+	materialId material = (materialId)primitive.material;
+	int first = primitive.firstVertex;
+
+	int expectedVertices = 1;
+	if (primitive.shape == Geometry::TRIANGLE) {
+		expectedVertices = 3;
+	}
+	else if (primitive.shape == Geometry::SQUARE || primitive.shape == Geometry::INSTANCE) {
+		expectedVertices = 4;
+	}
+	else if (primitive.shape == Geometry::MESH || primitive.shape == Geometry::SPHERE_SET) {
+		expectedVertices = primitive.vertexCount;
+	}
+	if (primitive.material < 0 || primitive.material >= materialCount) {
+		return false;
+	}
+	if (first < 0 || expectedVertices < 0 || primitive.vertexCount != expectedVertices || expectedVertices > vertexCount - first) {
+		return false;
+	}
+
+	switch (primitive.shape) {
+		case Geometry::TRIANGLE :
+			scene.Add(Triangle(vertices[first], vertices[first + 1], vertices[first + 2], material), isLight);
+			return true;
+		case Geometry::SQUARE :
+			scene.Add(Square(vertices[first], vertices[first + 1], vertices[first + 2], vertices[first + 3], material), isLight);
+			return true;
+		case Geometry::SPHERE :
+			scene.Add(Sphere(vertices[first], primitive.radius, material), isLight);
+			return true;
+		case Geometry::POINT :
+			scene.Add(Point(vertices[first]), isLight);
+			return true;
+		case Geometry::MESH : {
+			if (primitive.firstIndex < 0 || primitive.indexCount < 0 || primitive.indexCount > indexCount - primitive.firstIndex) {
+				return false;
+			}
+
+			const int * meshIndices = indices + primitive.firstIndex;
+			for (int i = 0; i < primitive.indexCount; i++) {
+				if (meshIndices[i] < 0 || meshIndices[i] >= primitive.vertexCount) {
+					return false;
+				}
+			}
+
+			Mesh mesh(vertices + first, primitive.vertexCount, meshIndices, primitive.indexCount, material);
+			if (isPrototype) {
+				scene.AddPrototype(mesh);
+			}
+			else {
+				scene.Add(mesh, isLight);
+			}
+			return true;
+		}
+		case Geometry::SPHERE_SET : {
+			if (primitive.firstIndex < 0 || primitive.indexCount != primitive.vertexCount || primitive.indexCount > radiusCount - primitive.firstIndex) {
+				return false;
+			}
+
+			scene.Add(SphereSet(scene.GetArena(), vertices + first, radii + primitive.firstIndex, primitive.indexCount, material), isLight);
+			return true;
+		}
+		case Geometry::INSTANCE : {
+			Transform transform(vertices[first], vertices[first + 1], vertices[first + 2], vertices[first + 3]);
+			Transform inverse;
+			if (primitive.firstIndex < 0 || primitive.firstIndex >= scene.GetPrototypeCount() || !transform.Inverse(inverse)) {
+				return false;
+			}
+			scene.Add(Instance(scene.GetPrototypeHierarchy(primitive.firstIndex), primitive.firstIndex, transform, material), isLight);
+			return true;
+		}
+	}
+	return false;
+}
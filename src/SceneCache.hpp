@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "BVH.hpp"
+#include "Geometry.hpp"
+#include "MappedFile.hpp"
+#include "MaterialTable.hpp"
+#include "Scene.hpp"
+
+#define SCENE_CACHE_MAGIC 0x43535452 // "RTSC"
+#define SCENE_CACHE_VERSION 7
+
+// Start of a compiled scene file.  The material, primitive, vertex, mesh index, radius, node and leaf reference arrays
+// follow it in that order.  The primitives are the objects, then the lights, then the meshes that are instanced.  The
+// hierarchies of those meshes come last: one record each, then all of their nodes, then all of their references
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t hash;
+	int32_t objectCount;
+	int32_t lightCount;
+	int32_t vertexCount;
+	int32_t indexCount;
+	int32_t nodeCount;
+	int32_t referenceCount;
+	int32_t depth;
+	int32_t radiusCount;
+	int32_t materialCount;
+	int32_t prototypeCount;
+	int32_t prototypeNodeCount;
+	int32_t prototypeReferenceCount;
+} sceneCacheHeader;
+
+// One entry of the material table, stored in table order so the ids of the primitives stay valid
+typedef struct {
+	unsigned char color[4];
+	int32_t type;
+} cachedMaterial;
+
+// One object or light.  Spheres and points use a single vertex (the center/location), triangles three, squares
+// four and meshes their whole vertex array plus a range of the index array (indices are relative to the mesh).
+// Sphere sets use a vertex per center and the first index and index count as their range of the radius array.
+// Instances use four vertices for the columns of their transform and the first index for their prototype.  The
+// material is an index into the material array
+typedef struct {
+	int32_t shape;
+	int32_t material;
+	int32_t firstVertex;
+	int32_t vertexCount;
+	int32_t firstIndex;
+	int32_t indexCount;
+	float radius;
+} cachedPrimitive;
+
+// The hierarchy of one instanced mesh.  Its nodes and references follow those of the prototypes before it, the
+// references all point at geometry 0 (the mesh)
+typedef struct {
+	int32_t nodeCount;
+	int32_t referenceCount;
+	int32_t depth;
+} cachedHierarchy;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: SceneCache
+ * Purpose: Binary copy of the compiled geometry and hierarchy of a scene.  Written after the xml is loaded and
+ *          memory mapped on later runs as long as the hash of the xml geometry still matches
+ */
+class SceneCache {
+
+	public :
+		SceneCache(std::string fileName, uint64_t hash);
+
+		bool Load(MaterialTable &materials, Scene &scene, BVH &bvh);
+		bool Save(MaterialTable &materials, Scene &scene, BVH &bvh);
+
+	private :
+		static void AddPrimitive(Geometry * geom, std::vector<cachedPrimitive> &primitives, std::vector<float> &vertices, std::vector<int32_t> &indices, std::vector<float> &radii);
+		static bool CreatePrimitive(const cachedPrimitive &primitive, bool isLight, bool isPrototype, int materialCount, Vec3<float> * vertices, int vertexCount, const int * indices, int indexCount, const float * radii, int radiusCount, Scene &scene);
+
+		std::string _fileName;
+		uint64_t _hash;
+};
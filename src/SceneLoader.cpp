@@ -0,0 +1,926 @@
+/* Standard libs */
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+/* Project headers */
+#include "SceneLoader.hpp"
+#include "Material.hpp"
+#include "Instance.hpp"
+#include "Mesh.hpp"
+#include "MeshImporter.hpp"
+#include "SceneCache.hpp"
+#include "Point.hpp"
+#include "Sphere.hpp"
+#include "SphereSet.hpp"
+#include "Square.hpp"
+#include "Triangle.hpp"
+
+using namespace std;
+
+typedef std::chrono::steady_clock Clock;
+typedef Clock::time_point TimePoint;
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+/*
+ * Date: 10/17/26
+ * Function Name: ElapsedMilliseconds
+ * Arguments:
+ *     TimePoint - when the stage started
+ * Purpose: Returns the milliseconds passed since the start of a load stage
+ * Return Value: double
+ */
+static double ElapsedMilliseconds(TimePoint start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: HashString
+ * Arguments:
+ *     const char * - the string (may be null)
+ *     uint64_t &   - the running FNV-1a hash
+ * Purpose: Adds a string and its terminator to the hash so neighbouring strings cannot run together
+ * Return Value: void
+ */
+static void HashString(const char * str, uint64_t &hash) {
+    if (str) {
+        for (; *str; str++) {
+            hash = (hash ^ (unsigned char)*str) * FNV_PRIME;
+        }
+    }
+    hash = (hash ^ 0xFF) * FNV_PRIME;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ShapeOfElement
+ * Arguments:
+ *     const char * - the name of an element of the objects or lights section
+ * Purpose: Returns the shape LoadGeometry creates for the element, matched the same way it matches them
+ * Return Value: int - the Geometry::Shape, -1 for elements that are not geometry
+ */
+static int ShapeOfElement(const char * name) {
+    if (!strncmp(name, "triangle", 8)) {
+        return Geometry::TRIANGLE;
+    }
+    else if (!strncmp(name, "sphere_set", 10)) {
+        return Geometry::SPHERE_SET;
+    }
+    else if (!strncmp(name, "sphere", 6)) {
+        return Geometry::SPHERE;
+    }
+    else if (!strncmp(name, "point", 5)) {
+        return Geometry::POINT;
+    }
+    else if (!strncmp(name, "square", 6)) {
+        return Geometry::SQUARE;
+    }
+    else if (!strncmp(name, "mesh", 4)) {
+        return Geometry::MESH;
+    }
+    else if (!strncmp(name, "instance", 8)) {
+        return Geometry::INSTANCE;
+    }
+    return -1;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ParseMaterial
+ * Arguments:
+ *     const char * - the text of a material element
+ * Purpose: Converts the material name (any case) to the material.  Unknown names are MATERIAL_NONE
+ * Return Value: Material
+ */
+static Material ParseMaterial(const char * text) {
+    std::string str(text ? text : "");
+    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+    
+    if (!strncmp(str.c_str(), "REFLECTIVE", 10)) {
+        return MATERIAL_REFLECTIVE;
+    }
+    else if (!strncmp(str.c_str(), "SPECULAR", 8)) {
+        return MATERIAL_SPECULAR;
+    }
+    else if (!strncmp(str.c_str(), "GLASS", 5)) {
+        return MATERIAL_GLASS;
+    }
+    return MATERIAL_NONE;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SceneLoader (constructor)
+ * Arguments:
+ *     std::string - the scene (xml) file
+ * Purpose: Constructor.  Parses the scene file, this is the only time the file is read
+ * Return Value: void
+ */
+SceneLoader::SceneLoader(std::string fileName) : _fileName(fileName), _geometryHash(0), _hashed(false) {
+    memset(&_timings, 0, sizeof(_timings));
+    
+    TimePoint start = Clock::now();
+    _document.LoadFile(_fileName.c_str());
+    _timings.parse = ElapsedMilliseconds(start);
+    
+    // Check for errors within the file
+    if (_document.Error()) {
+        cout << "There was an error parsing " << _fileName << endl;
+        _document.PrintError();
+        exit(1);
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadColors
+ * Arguments:
+ *     Color & - the color mapping to fill
+ * Purpose: Reads the custom colors of the scene
+ * Return Value: void
+ */
+void SceneLoader::LoadColors(Color &colors) {
+    TimePoint start = Clock::now();
+    colors.Load(_document);
+    _timings.colors = ElapsedMilliseconds(start);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadConfiguration
+ * Arguments:
+ *     Config & - the configuration to fill
+ * Purpose: Reads the configuration of the scene
+ * Return Value: void
+ */
+void SceneLoader::LoadConfiguration(Config &config) {
+    TimePoint start = Clock::now();
+    config.Load(_document);
+    _timings.configuration = ElapsedMilliseconds(start);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadPerspective
+ * Arguments:
+ *     Config &      - the configuration of the scene (must be loaded already)
+ *     Perspective & - the perspective to fill
+ * Purpose: Reads the camera and image plane(s) of the scene
+ * Return Value: void
+ */
+void SceneLoader::LoadPerspective(Config &config, Perspective &perspective) {
+    TimePoint start = Clock::now();
+    perspective.Load(config, _document);
+    _timings.perspective = ElapsedMilliseconds(start);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadAnimation
+ * Arguments:
+ *     Animation & - the animation to fill
+ * Purpose: Reads the keyframes of the animation section.  Objects that move are named by a name attribute on their
+ *          element in the objects section, which is matched to their place in the object list of the scene
+ * Return Value: void
+ */
+void SceneLoader::LoadAnimation(Animation &animation) {
+
+    // Every geometry element of the objects sections is one object, in the order of the document
+    std::map<std::string, int> objectNames;
+    int objectCount = 0;
+    for (tinyxml2::XMLElement * section = _document.FirstChildElement(); section; section = section->NextSiblingElement()) {
+        if (strncmp(section->Value(), "objects", 7)) {
+            continue;
+        }
+        for (tinyxml2::XMLElement * child = section->FirstChildElement(); child; child = child->NextSiblingElement()) {
+            if (ShapeOfElement(child->Value()) < 0) {
+                continue;
+            }
+            if (child->Attribute("name")) {
+                objectNames[child->Attribute("name")] = objectCount;
+            }
+            objectCount++;
+        }
+    }
+
+    for (tinyxml2::XMLElement * section = _document.FirstChildElement(); section; section = section->NextSiblingElement()) {
+        if (strncmp(section->Value(), "animation", 9)) {
+            continue;
+        }
+        for (tinyxml2::XMLElement * child = section->FirstChildElement(); child; child = child->NextSiblingElement()) {
+            if (!strncmp(child->Value(), "frames", 6)) {
+                animation.SetFrameCount(child->GetText() ? atoi(child->GetText()) : 0);
+                continue;
+            }
+            if (strncmp(child->Value(), "keyframe", 8)) {
+                continue;
+            }
+
+            int frame = -1;
+            child->QueryIntAttribute("frame", &frame);
+            if (frame < 0) {
+                cout << "Every keyframe in " << _fileName << " needs a frame that is not negative" << endl;
+                exit(1);
+            }
+
+            for (tinyxml2::XMLElement * tag = child->FirstChildElement(); tag; tag = tag->NextSiblingElement()) {
+                double x = 0, y = 0, z = 0;
+                tag->QueryDoubleAttribute("x", &x);
+                tag->QueryDoubleAttribute("y", &y);
+                tag->QueryDoubleAttribute("z", &z);
+                Vec3<float> value = Vec3<float>::vec3((float)x, (float)y, (float)z);
+
+                if (!strncmp(tag->Value(), "camera", 6)) {
+                    animation.AddCameraKey(frame, value);
+                }
+                else if (!strncmp(tag->Value(), "corner", 6)) {
+                    animation.AddCornerKey(frame, value);
+                }
+                else if (!strncmp(tag->Value(), "move", 4)) {
+                    const char * name = tag->Attribute("object");
+                    std::map<std::string, int>::iterator object = objectNames.find(name ? name : "");
+                    if (object == objectNames.end()) {
+                        cout << "Keyframe " << frame << " of " << _fileName << " moves an object without a name in the objects section" << endl;
+                        exit(1);
+                    }
+                    animation.AddObjectKey(object->second, frame, value);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadGeometry
+ * Arguments:
+ *     Color &                   - the color mapping of the scene (must be loaded already)
+ *     MaterialTable &           - gets the color and material of every object and light
+ *     Scene &                   - filled with the objects and lights
+ * Purpose: Creates the geometry of the "objects" and "lights" sections
+ * Return Value: void
+ */
+void SceneLoader::LoadGeometry(Color &colors, MaterialTable &materials, Scene &scene) {
+    TimePoint start = Clock::now();
+    
+    // Count the geometry first so every shape array of the scene is allocated once
+    int shapeCounts[Geometry::INSTANCE + 1] = { 0 };
+    int entryCount = 0;
+    int prototypeCount = 0;
+    for (tinyxml2::XMLElement * section = _document.FirstChildElement(); section; section = section->NextSiblingElement()) {
+        if (!strncmp(section->Value(), "objects", 7) || !strncmp(section->Value(), "lights", 6)) {
+            for (tinyxml2::XMLElement * child = section->FirstChildElement(); child; child = child->NextSiblingElement()) {
+                int shape = ShapeOfElement(child->Value());
+                if (shape >= 0) {
+                    shapeCounts[shape]++;
+                    entryCount++;
+                }
+            }
+        }
+        else if (!strncmp(section->Value(), "prototypes", 10)) {
+            for (tinyxml2::XMLElement * child = section->FirstChildElement(); child; child = child->NextSiblingElement()) {
+                if (!strncmp(child->Value(), "mesh", 4)) {
+                    prototypeCount++;
+                }
+            }
+        }
+    }
+    for (int shape = 0; shape <= Geometry::INSTANCE; shape++) {
+        scene.Reserve((Geometry::Shape)shape, shapeCounts[shape]);
+    }
+    scene.ReserveEntries(entryCount);
+    scene.ReservePrototypes(prototypeCount);
+    
+    // The meshes of the prototypes sections are named and only drawn where instances place them
+    std::map<std::string, int> prototypes;
+    for (tinyxml2::XMLElement * section = _document.FirstChildElement(); section; section = section->NextSiblingElement()) {
+        if (strncmp(section->Value(), "prototypes", 10)) {
+            continue;
+        }
+        for (tinyxml2::XMLElement * child = section->FirstChildElement(); child; child = child->NextSiblingElement()) {
+            if (strncmp(child->Value(), "mesh", 4)) {
+                continue;
+            }
+            const char * name = child->Attribute("name");
+            if (!name || prototypes.count(name)) {
+                cout << "Every prototype mesh in " << _fileName << " needs a name of its own" << endl;
+                exit(1);
+            }
+            prototypes[name] = scene.AddPrototype(LoadMesh(child, colors, materials, scene.GetArena()));
+        }
+    }
+    
+    // Grab the first child element in the file
+    tinyxml2::XMLElement * objectParents = _document.FirstChildElement();
+    
+    // Go through the lights and objects sections
+    while(objectParents) {
+        
+        int isObject = 1;
+        
+        //Loop to find the objects or light parent element while the string is not "objects" or the size is non-zero
+        while(objectParents && (isObject = strncmp(objectParents->Value(), "objects", 7)) && (strncmp(objectParents->Value(), "lights", 6)) ) {
+            //cout << "Element text " << objectParents->Value() << endl;
+            objectParents = objectParents->NextSiblingElement();
+        }
+        isObject = !isObject;
+        
+        if (!objectParents) {
+            break;
+        }
+        
+        
+        tinyxml2::XMLElement * objectChild = objectParents->FirstChildElement();
+        
+        
+        if(objectChild) { // object/light parsing
+            
+            // Iterate through the objects portion and add them to the scene
+            while (objectChild) {
+                
+                // Triangle object
+                if (!strncmp(objectChild->Value(), "triangle", 8)) {
+                    Vec3<float> vertexA;
+                    Vec3<float> vertexB;
+                    Vec3<float> vertexC;
+                    Vec3<unsigned char> color = colors.GetColor(COLOR_WHITE);
+                    Material mat = MATERIAL_NONE;
+                    std::string str;
+                    
+                    // Go through and read all the attributes and tags
+                    tinyxml2::XMLElement * tag = objectChild->FirstChildElement();
+                    int vertexCount = 0;
+                    while (tag) {
+                        if (!strncmp(tag->Value(), "vertex", 6)) {
+                            
+                            // Read the 3 vectors' attributes and set their values
+                            double a = 0, b = 0, c = 0;
+                            tag->QueryDoubleAttribute("x", &a);
+                            tag->QueryDoubleAttribute("y", &b);
+                            tag->QueryDoubleAttribute("z", &c);
+                            
+                            // Set the vertex values
+                            if (vertexCount == 0) {
+                                vertexA.SetValues((float)a, (float)b, (float)c);
+                            }
+                            else if (vertexCount == 1) {
+                                vertexB.SetValues((float)a, (float)b, (float)c);
+                            }
+                            else {
+                                vertexC.SetValues((float)a, (float)b, (float)c);
+                            }
+                            vertexCount++;
+                        }
+                        else if (!strncmp(tag->Value(), "color", 5)) {
+                            
+                            // Read the color and set the corresponding triangle color
+                            str.assign(tag->GetText());
+                            std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+                            color = colors.GetColor(str);
+                            
+                        }
+                        else if (!strncmp(tag->Value(), "material", 8)) {
+                            mat = ParseMaterial(tag->GetText());
+                        }
+                        tag = tag->NextSiblingElement();
+                    }
+                    
+                    assert(vertexCount == 3);
+                    
+                    // Create a new triangle object and add it to the scene
+                    scene.Add(Triangle(vertexA, vertexB, vertexC, materials.Add(color, mat)), !isObject);
+                    
+                    
+                } //Sphere set (checked before sphere which is a prefix of it)
+                else if (!strncmp(objectChild->Value(), "sphere_set", 10)) {
+                    std::vector<Vec3<float> > centers;
+                    std::vector<float> radii;
+                    Vec3<unsigned char> color = colors.GetColor(COLOR_WHITE);
+                    Material mat = MATERIAL_NONE;
+                    std::string str;
+                    
+                    // Go through and read all the attributes and tags
+                    tinyxml2::XMLElement * tag = objectChild->FirstChildElement();
+                    while (tag) {
+                        if (!strncmp(tag->Value(), "sphere", 6)) {
+                            double a = 0, b = 0, c = 0, r = 0;
+                            tag->QueryDoubleAttribute("x", &a);
+                            tag->QueryDoubleAttribute("y", &b);
+                            tag->QueryDoubleAttribute("z", &c);
+                            tag->QueryDoubleAttribute("radius", &r);
+                            
+                            centers.push_back(Vec3<float>::vec3((float)a, (float)b, (float)c));
+                            radii.push_back((float)r);
+                        }
+                        else if (!strncmp(tag->Value(), "color", 5)) {
+                            
+                            // Read the color and set the corresponding sphere set color
+                            str.assign(tag->GetText());
+                            std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+                            color = colors.GetColor(str);
+                        }
+                        else if (!strncmp(tag->Value(), "material", 8)) {
+                            mat = ParseMaterial(tag->GetText());
+                        }
+                        tag = tag->NextSiblingElement();
+                    }
+                    
+                    // Add the set to the scene
+                    Arena &arena = scene.GetArena();
+                    int count = (int)std::min(centers.size(), radii.size());
+                    scene.Add(SphereSet(arena, centers.data(), arena.Copy(radii.data(), count), count, materials.Add(color, mat)), !isObject);
+                } //Sphere object
+                else if (!strncmp(objectChild->Value(), "sphere", 6)) {
+                    Vec3<float> center(0, 0, 0);
+                    float radius = 0;
+                    Material mat = MATERIAL_NONE;
+                    Vec3<unsigned char> color = colors.GetColor(COLOR_WHITE);
+                    std::string str;
+                    
+                    // Go through and read all the attributes and tags
+                    tinyxml2::XMLElement * tag = objectChild->FirstChildElement();
+                    while (tag) {
+                        if (!strncmp(tag->Value(), "center", 6)) {
+                            double a = 0, b = 0, c = 0;
+                            tag->QueryDoubleAttribute("x", &a);
+                            tag->QueryDoubleAttribute("y", &b);
+                            tag->QueryDoubleAttribute("z", &c);
+                            
+                            center.SetValues((float)a, (float)b, (float)c);
+                        }
+                        else if (!strncmp(tag->Value(), "radius", 6)) {
+                            
+                            // Read the radius
+                            radius = (float)atof(tag->GetText());
+                        }
+                        else if (!strncmp(tag->Value(), "color", 5)) {
+                            
+                            // Read the color and set the corresponding square color
+                            str.assign(tag->GetText());
+                            std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+                            color = colors.GetColor(str);
+                            
+                        }
+                        else if (!strncmp(tag->Value(), "material", 8)) {
+                            mat = ParseMaterial(tag->GetText());
+                        }
+                        tag = tag->NextSiblingElement();
+                    }
+                    
+                    // Add the object to the scene
+                    scene.Add(Sphere(center, radius, materials.Add(color, mat)), !isObject);
+                }
+                else if (!strncmp(objectChild->Value(), "point", 5)) {
+                    Vec3<float> point = Vec3<float>::vec3(0, 0, 0);
+                    
+                    // Go through and read all the attributes and tags
+                    tinyxml2::XMLElement * tag = objectChild->FirstChildElement();
+                    while (tag) {
+                        if (!strncmp(tag->Value(), "location", 6)) {
+                            double a = 0, b = 0, c = 0;
+                            tag->QueryDoubleAttribute("x", &a);
+                            tag->QueryDoubleAttribute("y", &b);
+                            tag->QueryDoubleAttribute("z", &c);
+                            
+                            point.SetValues((float)a, (float)b, (float)c);
+                        }
+                        tag = tag->NextSiblingElement();
+                    }
+                    
+                    // Add the object to the scene
+                    scene.Add(Point(point), !isObject);
+                }
+                
+                
+                // Square object
+                if (!strncmp(objectChild->Value(), "square", 6)) {
+                    Vec3<float> vertexA;
+                    Vec3<float> vertexB;
+                    Vec3<float> vertexC;
+                    Vec3<float> vertexD;
+                    Vec3<unsigned char> color = colors.GetColor(COLOR_WHITE);
+                    Material mat = MATERIAL_NONE;
+                    std::string str;
+                    
+                    // Go through and read all the attributes and tags
+                    tinyxml2::XMLElement * tag = objectChild->FirstChildElement();
+                    int vertexCount = 0;
+                    while (tag) {
+                        if (!strncmp(tag->Value(), "vertex", 6)) {
+                            
+                            // Read the 3 vectors' attributes and set their values
+                            double a = 0, b = 0, c = 0;
+                            tag->QueryDoubleAttribute("x", &a);
+                            tag->QueryDoubleAttribute("y", &b);
+                            tag->QueryDoubleAttribute("z", &c);
+                            
+                            // Set the vertex values
+                            if (vertexCount == 0) {
+                                vertexA.SetValues((float)a, (float)b, (float)c);
+                            }
+                            else if (vertexCount == 1) {
+                                vertexB.SetValues((float)a, (float)b, (float)c);
+                            }
+                            else if (vertexCount == 2){
+                                vertexC.SetValues((float)a, (float)b, (float)c);
+                            }
+                            else {
+                                vertexD.SetValues((float)a, (float)b, (float)c);
+                            }
+                            vertexCount++;
+                        }
+                        else if (!strncmp(tag->Value(), "color", 5)) {
+                            
+                            // Read the color and set the corresponding triangle color
+                            str.assign(tag->GetText());
+                            std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+                            color = colors.GetColor(str);
+                            
+                        }
+                        else if (!strncmp(tag->Value(), "material", 8)) {
+                            mat = ParseMaterial(tag->GetText());
+                        }
+                        tag = tag->NextSiblingElement();
+                    }
+                    assert(vertexCount == 4);
+                    
+                    // Create a new square object and add it to the scene
+                    scene.Add(Square(vertexA, vertexB, vertexC, vertexD, materials.Add(color, mat)), !isObject);
+                }
+                else if (!strncmp(objectChild->Value(), "mesh", 4)) {
+                    scene.Add(LoadMesh(objectChild, colors, materials, scene.GetArena()), !isObject);
+                }
+                else if (!strncmp(objectChild->Value(), "instance", 8)) {
+                    scene.Add(LoadInstance(objectChild, colors, materials, scene, prototypes), !isObject);
+                }
+                
+                // Get the next object
+                objectChild = objectChild->NextSiblingElement();
+            }
+        }
+        
+        // Next sibling element
+        objectParents = objectParents->NextSiblingElement();
+        
+    }
+    
+    scene.Finish();
+    _timings.geometry = ElapsedMilliseconds(start);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadMesh
+ * Arguments:
+ *     tinyxml2::XMLElement * - the mesh element
+ *     Color &                - the color mapping of the scene
+ *     MaterialTable &        - gets the color and material of the mesh
+ *     Arena &                - the arena of the scene the vertex and index arrays are stored in
+ * Purpose: Creates a mesh from its model file and vertex and face tags
+ * Return Value: Mesh
+ */
+Mesh SceneLoader::LoadMesh(tinyxml2::XMLElement * element, Color &colors, MaterialTable &materials, Arena &arena) {
+    std::vector<Vec3<float> > vertices;
+    std::vector<int> indices;
+    Vec3<unsigned char> color = colors.GetColor(COLOR_WHITE);
+    Material mat = MATERIAL_NONE;
+    std::string str;
+    
+    // Models (OBJ or binary PLY) are read first, vertex and face tags add to them
+    const char * modelFile = element->Attribute("file");
+    if (modelFile) {
+        std::string error;
+        if (!MeshImporter::Load(ResolvePath(modelFile), vertices, indices, error)) {
+            cout << "Failed to load the model " << modelFile << " in " << _fileName << ": " << error << endl;
+            exit(1);
+        }
+    }
+    
+    // Go through and read all the attributes and tags
+    tinyxml2::XMLElement * tag = element->FirstChildElement();
+    while (tag) {
+        if (!strncmp(tag->Value(), "vertex", 6)) {
+            double a = 0, b = 0, c = 0;
+            tag->QueryDoubleAttribute("x", &a);
+            tag->QueryDoubleAttribute("y", &b);
+            tag->QueryDoubleAttribute("z", &c);
+            
+            vertices.push_back(Vec3<float>::vec3((float)a, (float)b, (float)c));
+        }
+        else if (!strncmp(tag->Value(), "face", 4)) {
+            
+            // Faces index the vertices above.  A fourth index makes a quad split like a square
+            int a = -1, b = -1, c = -1, d = -1;
+            tag->QueryIntAttribute("a", &a);
+            tag->QueryIntAttribute("b", &b);
+            tag->QueryIntAttribute("c", &c);
+            tag->QueryIntAttribute("d", &d);
+            
+            int vertexCount = (int)vertices.size();
+            if (a < 0 || b < 0 || c < 0 || a >= vertexCount || b >= vertexCount || c >= vertexCount || d >= vertexCount) {
+                cout << "Mesh face in " << _fileName << " uses a vertex that was not defined before it" << endl;
+                exit(1);
+            }
+            
+            indices.push_back(a);
+            indices.push_back(b);
+            indices.push_back(c);
+            if (d >= 0) {
+                indices.push_back(c);
+                indices.push_back(b);
+                indices.push_back(d);
+            }
+        }
+        else if (!strncmp(tag->Value(), "color", 5)) {
+            
+            // Read the color and set the corresponding mesh color
+            str.assign(tag->GetText());
+            std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+            color = colors.GetColor(str);
+        }
+        else if (!strncmp(tag->Value(), "material", 8)) {
+            mat = ParseMaterial(tag->GetText());
+        }
+        tag = tag->NextSiblingElement();
+    }
+    
+    // The arrays are only known once the whole element is read, so they are copied into the arena in one go
+    return Mesh(arena.Copy(vertices.data(), vertices.size()), (int)vertices.size(), arena.Copy(indices.data(), indices.size()), (int)indices.size(), materials.Add(color, mat));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadInstance
+ * Arguments:
+ *     tinyxml2::XMLElement *       - the instance element
+ *     Color &                      - the color mapping of the scene
+ *     MaterialTable &              - gets the color and material of the instance if it changes them
+ *     Scene &                      - the scene holding the prototypes
+ *     std::map<std::string, int> & - the index of every prototype by name
+ * Purpose: Creates an instance of the prototype named by the mesh attribute.  The scale, rotate and translate tags
+ *          are applied in the order they are written, rotations in degrees about the x, y and z axis in that
+ *          order.  Color and material tags replace the ones of the prototype
+ * Return Value: Instance
+ */
+Instance SceneLoader::LoadInstance(tinyxml2::XMLElement * element, Color &colors, MaterialTable &materials, Scene &scene, std::map<std::string, int> &prototypes) {
+    const char * name = element->Attribute("mesh");
+    std::map<std::string, int>::iterator prototype = prototypes.find(name ? name : "");
+    if (prototype == prototypes.end()) {
+        cout << "Instance in " << _fileName << " names the mesh " << (name ? name : "(none)") << " which is not a prototype" << endl;
+        exit(1);
+    }
+    
+    const materialEntry &entry = materials.Get(scene.GetPrototype(prototype->second).GetMaterialId());
+    Vec3<unsigned char> color = entry.color;
+    Material mat = entry.type;
+    bool ownMaterial = false;
+    Transform transform;
+    std::string str;
+    
+    // Go through and read all the attributes and tags
+    tinyxml2::XMLElement * tag = element->FirstChildElement();
+    while (tag) {
+        if (!strncmp(tag->Value(), "scale", 5)) {
+            double a = 1, b = 1, c = 1;
+            tag->QueryDoubleAttribute("x", &a);
+            tag->QueryDoubleAttribute("y", &b);
+            tag->QueryDoubleAttribute("z", &c);
+            transform = transform.Then(Transform::Scale(Vec3<float>::vec3((float)a, (float)b, (float)c)));
+        }
+        else if (!strncmp(tag->Value(), "rotate", 6)) {
+            double angles[3] = { 0, 0, 0 };
+            tag->QueryDoubleAttribute("x", &angles[0]);
+            tag->QueryDoubleAttribute("y", &angles[1]);
+            tag->QueryDoubleAttribute("z", &angles[2]);
+            for (int axis = 0; axis < 3; axis++) {
+                transform = transform.Then(Transform::Rotation(axis, (float)angles[axis]));
+            }
+        }
+        else if (!strncmp(tag->Value(), "translate", 9)) {
+            double a = 0, b = 0, c = 0;
+            tag->QueryDoubleAttribute("x", &a);
+            tag->QueryDoubleAttribute("y", &b);
+            tag->QueryDoubleAttribute("z", &c);
+            transform = transform.Then(Transform::Translation(Vec3<float>::vec3((float)a, (float)b, (float)c)));
+        }
+        else if (!strncmp(tag->Value(), "color", 5)) {
+            str.assign(tag->GetText());
+            std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+            color = colors.GetColor(str);
+            ownMaterial = true;
+        }
+        else if (!strncmp(tag->Value(), "material", 8)) {
+            mat = ParseMaterial(tag->GetText());
+            ownMaterial = true;
+        }
+        tag = tag->NextSiblingElement();
+    }
+    
+    Transform inverse;
+    if (!transform.Inverse(inverse)) {
+        cout << "Instance of " << name << " in " << _fileName << " is scaled to nothing" << endl;
+        exit(1);
+    }
+    
+    materialId material = ownMaterial ? materials.Add(color, mat) : scene.GetPrototype(prototype->second).GetMaterialId();
+    return Instance(scene.GetPrototypeHierarchy(prototype->second), prototype->second, transform, material);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetTimings
+ * Arguments:
+ *     void
+ * Purpose: Returns the time spent on each stage of loading the scene
+ * Return Value: loadTimings
+ */
+loadTimings SceneLoader::GetTimings() {
+    return _timings;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: LoadCache
+ * Arguments:
+ *     Config &                  - the configuration, for where the cache is kept
+ *     MaterialTable &           - filled with the materials of the scene
+ *     Scene &                   - filled with the objects and lights
+ *     BVH &                     - restored to the hierarchy over the objects
+ * Purpose: Loads the compiled geometry from the cache instead of the xml
+ * Return Value: bool - false if there is no up to date cache, the geometry must be loaded from the xml then
+ */
+bool SceneLoader::LoadCache(Config &config, MaterialTable &materials, Scene &scene, BVH &bvh) {
+    TimePoint start = Clock::now();
+    SceneCache cache(GetCachePath(config), GetGeometryHash());
+    bool loaded = cache.Load(materials, scene, bvh);
+    _timings.cache = ElapsedMilliseconds(start);
+    return loaded;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SaveCache
+ * Arguments:
+ *     Config &                  - the configuration, for where the cache is kept
+ *     MaterialTable &           - the materials of the scene
+ *     Scene &                   - the objects and lights
+ *     BVH &                     - the hierarchy built over the objects
+ * Purpose: Writes the compiled geometry so the next run can skip the xml geometry and the hierarchy build.  The
+ *          cache directory is created if it does not exist yet
+ * Return Value: void
+ */
+void SceneLoader::SaveCache(Config &config, MaterialTable &materials, Scene &scene, BVH &bvh) {
+    TimePoint start = Clock::now();
+    std::string path = GetCachePath(config);
+    if (!config.GetCacheDirectory().empty()) {
+#ifdef _WIN32
+        _mkdir(ResolvePath(config.GetCacheDirectory()).c_str());
+#else
+        mkdir(ResolvePath(config.GetCacheDirectory()).c_str(), 0755);
+#endif
+    }
+    
+    SceneCache cache(path, GetGeometryHash());
+    if (!cache.Save(materials, scene, bvh)) {
+        cout << "Failed to write the scene cache " << path << endl;
+    }
+    _timings.cache += ElapsedMilliseconds(start);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetCachePath
+ * Arguments:
+ *     Config & - the configuration
+ * Purpose: Returns the cache file of the scene.  Without a cache directory it is next to the scene file.  In a
+ *          cache directory it is named after the geometry hash, so every scene file with the same geometry (the
+ *          same model seen from another camera, say) shares one cache
+ * Return Value: std::string
+ */
+std::string SceneLoader::GetCachePath(Config &config) {
+    if (config.GetCacheDirectory().empty()) {
+        return _fileName + ".cache";
+    }
+    
+    std::string directory = ResolvePath(config.GetCacheDirectory());
+    if (directory[directory.size() - 1] != '/' && directory[directory.size() - 1] != '\\') {
+        directory += "/";
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.cache", (unsigned long long)GetGeometryHash());
+    return directory + name;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetGeometryHash
+ * Arguments:
+ *     void
+ * Purpose: Returns the hash of the geometry, computing it on the first call.  The cache path, the load and the save
+ *          of the cache all use the same value
+ * Return Value: uint64_t
+ */
+uint64_t SceneLoader::GetGeometryHash() {
+    if (!_hashed) {
+        _geometryHash = HashGeometry();
+        _hashed = true;
+    }
+    return _geometryHash;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: HashGeometry
+ * Arguments:
+ *     void
+ * Purpose: Hashes the sections the geometry is built from (colors, prototypes, objects and lights) and the BVH quality the
+ *          cached hierarchy was built with.  Changes to the camera or the rest of the configuration keep the hash
+ * Return Value: uint64_t
+ */
+uint64_t SceneLoader::HashGeometry() {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    
+    tinyxml2::XMLElement * section = _document.FirstChildElement();
+    while (section) {
+        if (!strncmp(section->Value(), "colors", 6) || !strncmp(section->Value(), "objects", 7) || !strncmp(section->Value(), "lights", 6)
+            || !strncmp(section->Value(), "prototypes", 10)) {
+            HashElement(section, hash);
+        }
+        else if (!strncmp(section->Value(), "configuration", 13)) {
+            for (tinyxml2::XMLElement * setting = section->FirstChildElement("bvh_quality"); setting; setting = setting->NextSiblingElement("bvh_quality")) {
+                HashElement(setting, hash);
+            }
+        }
+        section = section->NextSiblingElement();
+    }
+    return hash;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: HashElement
+ * Arguments:
+ *     tinyxml2::XMLElement * - the element
+ *     uint64_t &             - the running hash
+ * Purpose: Adds the name, attributes, text and children of an element to the hash
+ * Return Value: void
+ */
+void SceneLoader::HashElement(tinyxml2::XMLElement * element, uint64_t &hash) {
+    HashString(element->Value(), hash);
+    
+    for (const tinyxml2::XMLAttribute * attribute = element->FirstAttribute(); attribute; attribute = attribute->Next()) {
+        HashString(attribute->Name(), hash);
+        HashString(attribute->Value(), hash);
+    }
+    HashString(element->GetText(), hash);
+    
+    // Models referenced by meshes are part of the geometry too.  Their path, size and modification time stand in
+    // for the contents so the model does not have to be read.  The path is the resolved one, scenes in other
+    // directories can name a different model the same way
+    const char * modelFile = element->Attribute("file");
+    if (modelFile && !strncmp(element->Value(), "mesh", 4)) {
+        struct stat info;
+        HashString(ResolvePath(modelFile).c_str(), hash);
+        if (stat(ResolvePath(modelFile).c_str(), &info) == 0) {
+            uint64_t values[2] = { (uint64_t)info.st_size, (uint64_t)info.st_mtime };
+            for (int i = 0; i < 16; i++) {
+                hash = (hash ^ ((unsigned char *)values)[i]) * FNV_PRIME;
+            }
+        }
+    }
+    
+    for (tinyxml2::XMLElement * child = element->FirstChildElement(); child; child = child->NextSiblingElement()) {
+        HashElement(child, hash);
+    }
+    
+    // Close the element so the nesting is part of the hash
+    HashString(NULL, hash);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ResolvePath
+ * Arguments:
+ *     std::string - a file named in the scene
+ * Purpose: Relative paths in a scene are relative to the directory of the scene file
+ * Return Value: std::string
+ */
+std::string SceneLoader::ResolvePath(std::string path) {
+    bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\' || (path.size() > 1 && path[1] == ':'));
+    size_t slash = _fileName.find_last_of("/\\");
+    if (absolute || slash == std::string::npos) {
+        return path;
+    }
+    return _fileName.substr(0, slash + 1) + path;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "Animation.hpp"
+#include "BVH.hpp"
+#include "Color.hpp"
+#include "Config.hpp"
+#include "Geometry.hpp"
+#include "Instance.hpp"
+#include "MaterialTable.hpp"
+#include "Mesh.hpp"
+#include "Perspective.hpp"
+#include "Scene.hpp"
+#include "tinyxml2.h"
+
+// Milliseconds spent on each stage of loading a scene
+typedef struct {
+	double parse;
+	double colors;
+	double configuration;
+	double perspective;
+	double geometry;
+	double cache;
+} loadTimings;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: SceneLoader
+ * Purpose: Parses a scene file once and builds the colors, configuration, perspective and geometry from the
+ *          same document
+ */
+class SceneLoader {
+
+	public :
+		SceneLoader(std::string fileName);
+
+		void LoadColors(Color &colors);
+		void LoadConfiguration(Config &config);
+		void LoadPerspective(Config &config, Perspective &perspective);
+		void LoadAnimation(Animation &animation);
+		void LoadGeometry(Color &colors, MaterialTable &materials, Scene &scene);
+		bool LoadCache(Config &config, MaterialTable &materials, Scene &scene, BVH &bvh);
+		void SaveCache(Config &config, MaterialTable &materials, Scene &scene, BVH &bvh);
+		std::string GetCachePath(Config &config);
+		uint64_t GetGeometryHash();
+		loadTimings GetTimings();
+
+	private :
+		uint64_t HashGeometry();
+		Mesh LoadMesh(tinyxml2::XMLElement * element, Color &colors, MaterialTable &materials, Arena &arena);
+		Instance LoadInstance(tinyxml2::XMLElement * element, Color &colors, MaterialTable &materials, Scene &scene, std::map<std::string, int> &prototypes);
+		void HashElement(tinyxml2::XMLElement * element, uint64_t &hash);
+		std::string ResolvePath(std::string path);
+
+		std::string _fileName;
+		tinyxml2::XMLDocument _document;
+		loadTimings _timings;
+		uint64_t _geometryHash; // Hashing walks the whole document, so it is done once and only if the cache is used
+		bool _hashed;
+};
@@ -0,0 +1,73 @@
+#include "Simd.hpp"
+
+#if defined(SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetBestLevel
+ * Arguments:
+ *     void
+ * Purpose: Asks the processor (and operating system, for the AVX registers) which instruction sets it supports
+ * Return Value: simd_level
+ */
+simd_level Simd::GetBestLevel() {
+#if defined(SIMD_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+
+	__cpuid(info, 1);
+	bool sse = (info[3] & (1 << 26)) != 0; // SSE2
+	bool osAVX = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+
+	if (osAVX && maxLeaf >= 7) {
+		__cpuidex(info, 7, 0);
+		if (info[1] & (1 << 5)) {
+			return SIMD_AVX2;
+		}
+	}
+	return sse ? SIMD_SSE : SIMD_SCALAR;
+#elif defined(SIMD_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return SIMD_AVX2;
+	}
+	return __builtin_cpu_supports("sse2") ? SIMD_SSE : SIMD_SCALAR;
+#else
+	return SIMD_SCALAR;
+#endif
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Supported
+ * Arguments:
+ *     simd_level - the level wanted
+ * Purpose: Lowers a level to the best one the processor supports
+ * Return Value: simd_level
+ */
+simd_level Simd::Supported(simd_level level) {
+	simd_level best = GetBestLevel();
+	return level > best ? best : level;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetLevelName
+ * Arguments:
+ *     simd_level - the level
+ * Purpose: Gets the name of a level for printing
+ * Return Value: const char *
+ */
+const char * Simd::GetLevelName(simd_level level) {
+	switch (level) {
+		case SIMD_SSE :
+			return "SSE";
+		case SIMD_AVX2 :
+			return "AVX2";
+		default :
+			return "scalar";
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SIMD_X86 // SSE and AVX2 kernels are compiled
+#ifdef _MSC_VER
+#define SIMD_TARGET_AVX2 // MSVC compiles the intrinsics without a target attribute
+#else
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// The instruction sets the intersection kernels can use
+enum simd_level {
+	SIMD_SCALAR,
+	SIMD_SSE,
+	SIMD_AVX2
+};
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: Simd
+ * Purpose: Finds the widest instruction set the processor supports so the kernels can be picked at run time
+ */
+class Simd {
+
+	public :
+		static simd_level GetBestLevel();
+		static simd_level Supported(simd_level level);
+		static const char * GetLevelName(simd_level level);
+};
@@ -6,16 +6,14 @@
  * Arguments:
  *     Vec3<float> - the center of the sphere
  *     float       - the radius of the sphere
- *	   Vec3        - the color component
- *     Material    - the material of the triangle
+ *     materialId  - the entry of the material table
  * Purpose: Constructor 
  * Return Value: void
  */
-Sphere::Sphere(Vec3<float> a, float r, Vec3<unsigned char> color, Material mat) : super(SPHERE) {
+Sphere::Sphere(Vec3<float> a, float r, materialId material) : super(SPHERE) {
 	_center = Vec3<float>::vec3(a.x, a.y, a.z); 
 	_radius = r;
-	SetMaterial(mat);
-	SetColor(color);
+	SetMaterialId(material);
 }
 
 /* 
@@ -26,16 +24,14 @@ Sphere::Sphere(Vec3<float> a, float r, Vec3<unsigned char> color, Material mat)
  *     float    - y component of sphere's center coord
  *     float    - z component of sphere's center coord
  *     float    - the radius of the sphere
- *	   Vec3     - the color component
- *     Material - the material of the triangle
+ *     materialId - the entry of the material table
  * Purpose: Constructor 
  * Return Value: void
  */
-Sphere::Sphere(float ax, float ay, float az, float r, Vec3<unsigned char> color, Material mat) : super(SPHERE) {
+Sphere::Sphere(float ax, float ay, float az, float r, materialId material) : super(SPHERE) {
 	_center = Vec3<float>::vec3(ax, ay, az); 
 	_radius = r;
-	SetMaterial(mat);
-	SetColor(color);
+	SetMaterialId(material);
 }
 
 /* 
@@ -44,25 +40,32 @@ Sphere::Sphere(float ax, float ay, float az, float r, Vec3<unsigned char> color,
  * Arguments:
  *     Vec3<float> - the ray potentially intersecting
  *     Vec3<float> - the starting location of the ray
+ *     RayHit &    - the hit record holding the closest hit so far
  * Purpose: Intersection code for a sphere 
- * Return Value: RayHit
+ * Return Value: bool - true if the hit record was updated
  */
-std::shared_ptr<RayHit> Sphere::Intersect(Vec3<float> ray, Vec3<float> startingPos) {
+bool Sphere::Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
 	// d = ray, e = starting pos, c = center
-	float discriminate = pow(ray * (startingPos - _center), 2) - ((ray * ray) * (((startingPos - _center) * (startingPos - _center)) - (_radius * _radius)));
+	Vec3<float> toStart = startingPos - _center;
+	float a = ray * ray;
+	float b = ray * toStart;
 
-	if (discriminate < 0) {
-		return nullptr;
+	// b * b - a * (toStart * toStart - r * r) cancels badly for small spheres far from the ray start, so the
+	// distance from the center to the ray is measured directly instead
+	Vec3<float> closestPoint = toStart - ray * (b / a);
+	float discriminate = a * ((_radius * _radius) - (closestPoint * closestPoint));
+
+	if (!(discriminate >= 0)) {
+		return false;
 	}
 	
 	discriminate = sqrtf(discriminate);
-	Vec3<float> zeroVector(0, 0, 0);
 
-	float time0 = (((zeroVector - ray) * (startingPos - _center)) + discriminate) / (ray * ray);
-	float time1 = (((zeroVector - ray) * (startingPos - _center)) - discriminate) / (ray * ray);
+	float time0 = (-b + discriminate) / a;
+	float time1 = (-b - discriminate) / a;
 
 	if (time0 < 0 && time1 < 1) {
-		return nullptr;
+		return false;
 	}
 	float trueTime = time0;
 
@@ -70,9 +73,102 @@ std::shared_ptr<RayHit> Sphere::Intersect(Vec3<float> ray, Vec3<float> startingP
 		trueTime = time1;
 	}
 
+	if (!(trueTime < rayHit.GetTime())) {
+		return false;
+	}
+
 	Vec3<float> hitLocation = (ray * trueTime) + startingPos;
 	Vec3<float> normal = Vec3<float>::Normalize(hitLocation - _center);
 
-	std::shared_ptr<RayHit> rayHit(new RayHit(trueTime, GetMaterial(), GetColor(), normal, hitLocation, ray));
-	return rayHit;
-}
\ No newline at end of file
+	rayHit.SetHit(trueTime, GetMaterialId(), normal, Vec3<float>::vec3(0, 0, 0), hitLocation, ray);
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Occluded
+ * Arguments:
+ *     Vec3<float> - the ray
+ *     Vec3<float> - the starting location of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Tests if either intersection with the sphere lies between the two times
+ * Return Value: bool
+ */
+bool Sphere::Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	Vec3<float> toStart = startingPos - _center;
+	float a = ray * ray;
+	float b = ray * toStart;
+	Vec3<float> closestPoint = toStart - ray * (b / a);
+	float discriminate = a * ((_radius * _radius) - (closestPoint * closestPoint));
+
+	if (discriminate < 0) {
+		return false;
+	}
+
+	discriminate = sqrtf(discriminate);
+	float time0 = (-b - discriminate) / a;
+	float time1 = (-b + discriminate) / a;
+
+	return (time0 > minTime && time0 < maxTime) || (time1 > minTime && time1 < maxTime);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetBoundingBox
+ * Arguments:
+ *     void
+ * Purpose: Gets the bounds of the sphere
+ * Return Value: BoundingBox
+ */
+BoundingBox Sphere::GetBoundingBox() {
+	return BoundingBox(_center + (-_radius), _center + _radius);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetCenter
+ * Arguments:
+ *		void
+ * Return Value: Vec3<float>
+ */
+Vec3<float> Sphere::GetCenter() {
+	return _center;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetRadius
+ * Arguments:
+ *		void
+ * Return Value: float
+ */
+float Sphere::GetRadius() {
+	return _radius;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetSphere
+ * Arguments:
+ *		int           - unused, the sphere is one primitive
+ *		Vec3<float> & - set to the center
+ *		float &       - set to the radius
+ * Return Value: bool - true
+ */
+bool Sphere::GetSphere(int index, Vec3<float> &center, float &radius) {
+	center = _center;
+	radius = _radius;
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Translate
+ * Arguments:
+ *		Vec3<float> - the offset
+ * Return Value: void
+ */
+void Sphere::Translate(Vec3<float> offset) {
+	_center = _center + offset;
+}
@@ -10,9 +10,15 @@
 class Sphere : public Geometry {
 	
 	public: 
-		Sphere(Vec3<float> a, float r, Vec3<unsigned char> color, Material mat = MATERIAL_NONE);
-		Sphere(float ax, float ay, float az, float r, Vec3<unsigned char> color, Material mat = MATERIAL_NONE);
-		std::shared_ptr<RayHit> Intersect(Vec3<float> ray, Vec3<float> startingPos);
+		Sphere(Vec3<float> a, float r, materialId material = MATERIAL_DEFAULT);
+		Sphere(float ax, float ay, float az, float r, materialId material = MATERIAL_DEFAULT);
+		bool Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		bool Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		BoundingBox GetBoundingBox();
+		Vec3<float> GetCenter();
+		float GetRadius();
+		bool GetSphere(int index, Vec3<float> &center, float &radius);
+		void Translate(Vec3<float> offset);
 
 	private :
 		Vec3<float> _center;
@@ -0,0 +1,442 @@
+#include "SphereKernel.hpp"
+
+#include <cfloat>
+#include <cmath>
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Every kernel evaluates the same expressions in the same order as Sphere::Intersect so the hits are identical
+// no matter which one runs
+
+/*
+ * Date: 10/17/26
+ * Function Name: ClosestHitScalar
+ * Arguments:
+ *     const spherePacket & - the spheres
+ *     Vec3<float>          - the ray
+ *     Vec3<float>          - the starting position of the ray
+ *     float                - hits at or after this time are ignored
+ *     float &              - set to the time of the closest hit
+ * Purpose: ClosestHit one lane at a time
+ * Return Value: int - the lane hit, -1 if nothing was hit
+ */
+static int ClosestHitScalar(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time) {
+	float a = ray * ray;
+	int closest = -1;
+
+	for (int lane = 0; lane < SPHERE_PACKET_WIDTH; lane++) {
+		Vec3<float> toStart = startingPos - Vec3<float>::vec3(packet.centerX[lane], packet.centerY[lane], packet.centerZ[lane]);
+		float b = ray * toStart;
+		Vec3<float> closestPoint = toStart - ray * (b / a);
+		float discriminate = a * (packet.radiusSquared[lane] - (closestPoint * closestPoint));
+
+		if (!(discriminate >= 0)) {
+			continue;
+		}
+
+		discriminate = sqrtf(discriminate);
+		float time0 = (-b + discriminate) / a;
+		float time1 = (-b - discriminate) / a;
+
+		if (time0 < 0 && time1 < 1) {
+			continue;
+		}
+		float trueTime = (time0 < 0 || (time1 > 0 && time1 < time0)) ? time1 : time0;
+
+		if (trueTime < maxTime) {
+			maxTime = trueTime;
+			closest = lane;
+		}
+	}
+
+	time = maxTime;
+	return closest;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AnyHitScalar
+ * Arguments:
+ *     const spherePacket & - the spheres
+ *     Vec3<float>          - the ray
+ *     Vec3<float>          - the starting position of the ray
+ *     float                - hits at or before this time are ignored
+ *     float                - hits at or after this time are ignored
+ * Purpose: AnyHit one lane at a time
+ * Return Value: bool
+ */
+static bool AnyHitScalar(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	float a = ray * ray;
+
+	for (int lane = 0; lane < SPHERE_PACKET_WIDTH; lane++) {
+		Vec3<float> toStart = startingPos - Vec3<float>::vec3(packet.centerX[lane], packet.centerY[lane], packet.centerZ[lane]);
+		float b = ray * toStart;
+		Vec3<float> closestPoint = toStart - ray * (b / a);
+		float discriminate = a * (packet.radiusSquared[lane] - (closestPoint * closestPoint));
+
+		if (!(discriminate >= 0)) {
+			continue;
+		}
+
+		discriminate = sqrtf(discriminate);
+		float time0 = (-b - discriminate) / a;
+		float time1 = (-b + discriminate) / a;
+
+		if ((time0 > minTime && time0 < maxTime) || (time1 > minTime && time1 < maxTime)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+#ifdef SIMD_X86
+
+/*
+ * Date: 10/17/26
+ * Function Name: RootsSSE
+ * Arguments:
+ *     const spherePacket & - the spheres
+ *     int                  - the first of the four lanes to test
+ *     const __m128 *       - the ray x, y and z components and ray * ray, each in every lane
+ *     const __m128 *       - the starting position x, y and z components, each in every lane
+ *     __m128 &             - set to the nearer intersection times
+ *     __m128 &             - set to the farther intersection times
+ * Purpose: Solves the quadratic for four lanes.  The times are only set if a lane has a root
+ * Return Value: __m128 - all bits set in the lanes whose discriminant is not negative
+ */
+static inline __m128 RootsSSE(const spherePacket &packet, int first, const __m128 * rayComponents, const __m128 * startComponents, __m128 &nearTime, __m128 &farTime) {
+	__m128 toStartX = _mm_sub_ps(startComponents[0], _mm_loadu_ps(packet.centerX + first));
+	__m128 toStartY = _mm_sub_ps(startComponents[1], _mm_loadu_ps(packet.centerY + first));
+	__m128 toStartZ = _mm_sub_ps(startComponents[2], _mm_loadu_ps(packet.centerZ + first));
+	__m128 a = rayComponents[3];
+
+	__m128 b = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rayComponents[0], toStartX), _mm_mul_ps(rayComponents[1], toStartY)), _mm_mul_ps(rayComponents[2], toStartZ));
+	__m128 bOverA = _mm_div_ps(b, a);
+	__m128 closestX = _mm_sub_ps(toStartX, _mm_mul_ps(rayComponents[0], bOverA));
+	__m128 closestY = _mm_sub_ps(toStartY, _mm_mul_ps(rayComponents[1], bOverA));
+	__m128 closestZ = _mm_sub_ps(toStartZ, _mm_mul_ps(rayComponents[2], bOverA));
+	__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(closestX, closestX), _mm_mul_ps(closestY, closestY)), _mm_mul_ps(closestZ, closestZ));
+	__m128 discriminate = _mm_mul_ps(a, _mm_sub_ps(_mm_loadu_ps(packet.radiusSquared + first), distance));
+	__m128 valid = _mm_cmpge_ps(discriminate, _mm_setzero_ps());
+
+	// Most rays miss every sphere of a packet, skip the square root and divisions for them
+	if (_mm_movemask_ps(valid) == 0) {
+		return valid;
+	}
+
+	discriminate = _mm_sqrt_ps(discriminate);
+	__m128 negativeB = _mm_xor_ps(b, _mm_set1_ps(-0.f));
+	nearTime = _mm_div_ps(_mm_sub_ps(negativeB, discriminate), a);
+	farTime = _mm_div_ps(_mm_add_ps(negativeB, discriminate), a);
+	return valid;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ClosestHitSSE
+ * Arguments:
+ *     const spherePacket & - the spheres
+ *     Vec3<float>          - the ray
+ *     Vec3<float>          - the starting position of the ray
+ *     float                - hits at or after this time are ignored
+ *     float &              - set to the time of the closest hit
+ * Purpose: ClosestHit four lanes at a time
+ * Return Value: int - the lane hit, -1 if nothing was hit
+ */
+static int ClosestHitSSE(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time) {
+	__m128 rayComponents[4] = { _mm_set1_ps(ray.x), _mm_set1_ps(ray.y), _mm_set1_ps(ray.z), _mm_set1_ps(ray * ray) };
+	__m128 startComponents[3] = { _mm_set1_ps(startingPos.x), _mm_set1_ps(startingPos.y), _mm_set1_ps(startingPos.z) };
+	__m128 zero = _mm_setzero_ps();
+	__m128 trueTime[2];
+	int mask = 0;
+
+	for (int half = 0; half < 2; half++) {
+		__m128 time1, time0;
+		__m128 valid = RootsSSE(packet, 4 * half, rayComponents, startComponents, time1, time0);
+		trueTime[half] = zero;
+		if (_mm_movemask_ps(valid) == 0) {
+			continue;
+		}
+
+		// Same choice as Sphere::Intersect, the nearer time unless it is behind the ray
+		__m128 behind = _mm_and_ps(_mm_cmplt_ps(time0, zero), _mm_cmplt_ps(time1, _mm_set1_ps(1.f)));
+		__m128 useNear = _mm_or_ps(_mm_cmplt_ps(time0, zero), _mm_and_ps(_mm_cmpgt_ps(time1, zero), _mm_cmplt_ps(time1, time0)));
+		trueTime[half] = _mm_or_ps(_mm_and_ps(useNear, time1), _mm_andnot_ps(useNear, time0));
+
+		valid = _mm_and_ps(_mm_andnot_ps(behind, valid), _mm_cmplt_ps(trueTime[half], _mm_set1_ps(maxTime)));
+		mask |= _mm_movemask_ps(valid) << (4 * half);
+	}
+
+	if (mask == 0) {
+		return -1;
+	}
+
+	float times[SPHERE_PACKET_WIDTH];
+	_mm_storeu_ps(times, trueTime[0]);
+	_mm_storeu_ps(times + 4, trueTime[1]);
+
+	int closest = -1;
+	for (int lane = 0; lane < SPHERE_PACKET_WIDTH; lane++) {
+		if ((mask & (1 << lane)) && times[lane] < maxTime) {
+			maxTime = times[lane];
+			closest = lane;
+		}
+	}
+	time = maxTime;
+	return closest;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AnyHitSSE
+ * Arguments:
+ *     const spherePacket & - the spheres
+ *     Vec3<float>          - the ray
+ *     Vec3<float>          - the starting position of the ray
+ *     float                - hits at or before this time are ignored
+ *     float                - hits at or after this time are ignored
+ * Purpose: AnyHit four lanes at a time
+ * Return Value: bool
+ */
+static bool AnyHitSSE(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	__m128 rayComponents[4] = { _mm_set1_ps(ray.x), _mm_set1_ps(ray.y), _mm_set1_ps(ray.z), _mm_set1_ps(ray * ray) };
+	__m128 startComponents[3] = { _mm_set1_ps(startingPos.x), _mm_set1_ps(startingPos.y), _mm_set1_ps(startingPos.z) };
+	__m128 low = _mm_set1_ps(minTime);
+	__m128 high = _mm_set1_ps(maxTime);
+
+	for (int half = 0; half < 2; half++) {
+		__m128 time0, time1;
+		__m128 valid = RootsSSE(packet, 4 * half, rayComponents, startComponents, time0, time1);
+		if (_mm_movemask_ps(valid) == 0) {
+			continue;
+		}
+		__m128 inside0 = _mm_and_ps(_mm_cmpgt_ps(time0, low), _mm_cmplt_ps(time0, high));
+		__m128 inside1 = _mm_and_ps(_mm_cmpgt_ps(time1, low), _mm_cmplt_ps(time1, high));
+		if (_mm_movemask_ps(_mm_and_ps(valid, _mm_or_ps(inside0, inside1))) != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: RootsAVX2
+ * Arguments:
+ *     const spherePacket & - the spheres
+ *     Vec3<float>          - the ray
+ *     Vec3<float>          - the starting position of the ray
+ *     __m256 &             - set to the nearer intersection times
+ *     __m256 &             - set to the farther intersection times
+ * Purpose: Solves the quadratic for all eight lanes.  The times are only set if a lane has a root
+ * Return Value: __m256 - all bits set in the lanes whose discriminant is not negative
+ */
+SIMD_TARGET_AVX2 static inline __m256 RootsAVX2(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, __m256 &nearTime, __m256 &farTime) {
+	__m256 toStartX = _mm256_sub_ps(_mm256_set1_ps(startingPos.x), _mm256_loadu_ps(packet.centerX));
+	__m256 toStartY = _mm256_sub_ps(_mm256_set1_ps(startingPos.y), _mm256_loadu_ps(packet.centerY));
+	__m256 toStartZ = _mm256_sub_ps(_mm256_set1_ps(startingPos.z), _mm256_loadu_ps(packet.centerZ));
+	__m256 a = _mm256_set1_ps(ray * ray);
+
+	__m256 b = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(ray.x), toStartX), _mm256_mul_ps(_mm256_set1_ps(ray.y), toStartY)), _mm256_mul_ps(_mm256_set1_ps(ray.z), toStartZ));
+	__m256 bOverA = _mm256_div_ps(b, a);
+	__m256 closestX = _mm256_sub_ps(toStartX, _mm256_mul_ps(_mm256_set1_ps(ray.x), bOverA));
+	__m256 closestY = _mm256_sub_ps(toStartY, _mm256_mul_ps(_mm256_set1_ps(ray.y), bOverA));
+	__m256 closestZ = _mm256_sub_ps(toStartZ, _mm256_mul_ps(_mm256_set1_ps(ray.z), bOverA));
+	__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(closestX, closestX), _mm256_mul_ps(closestY, closestY)), _mm256_mul_ps(closestZ, closestZ));
+	__m256 discriminate = _mm256_mul_ps(a, _mm256_sub_ps(_mm256_loadu_ps(packet.radiusSquared), distance));
+	__m256 valid = _mm256_cmp_ps(discriminate, _mm256_setzero_ps(), _CMP_GE_OQ);
+
+	if (_mm256_movemask_ps(valid) == 0) {
+		return valid;
+	}
+
+	discriminate = _mm256_sqrt_ps(discriminate);
+	__m256 negativeB = _mm256_xor_ps(b, _mm256_set1_ps(-0.f));
+	nearTime = _mm256_div_ps(_mm256_sub_ps(negativeB, discriminate), a);
+	farTime = _mm256_div_ps(_mm256_add_ps(negativeB, discriminate), a);
+	return valid;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ClosestHitAVX2
+ * Arguments:
+ *     const spherePacket & - the spheres
+ *     Vec3<float>          - the ray
+ *     Vec3<float>          - the starting position of the ray
+ *     float                - hits at or after this time are ignored
+ *     float &              - set to the time of the closest hit
+ * Purpose: ClosestHit on all eight lanes at once
+ * Return Value: int - the lane hit, -1 if nothing was hit
+ */
+SIMD_TARGET_AVX2 static int ClosestHitAVX2(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time) {
+	__m256 zero = _mm256_setzero_ps();
+	__m256 time1, time0;
+	__m256 valid = RootsAVX2(packet, ray, startingPos, time1, time0);
+	if (_mm256_movemask_ps(valid) == 0) {
+		return -1;
+	}
+
+	// Same choice as Sphere::Intersect, the nearer time unless it is behind the ray
+	__m256 behind = _mm256_and_ps(_mm256_cmp_ps(time0, zero, _CMP_LT_OQ), _mm256_cmp_ps(time1, _mm256_set1_ps(1.f), _CMP_LT_OQ));
+	__m256 useNear = _mm256_or_ps(_mm256_cmp_ps(time0, zero, _CMP_LT_OQ), _mm256_and_ps(_mm256_cmp_ps(time1, zero, _CMP_GT_OQ), _mm256_cmp_ps(time1, time0, _CMP_LT_OQ)));
+	__m256 trueTime = _mm256_blendv_ps(time0, time1, useNear);
+
+	valid = _mm256_and_ps(_mm256_andnot_ps(behind, valid), _mm256_cmp_ps(trueTime, _mm256_set1_ps(maxTime), _CMP_LT_OQ));
+	int mask = _mm256_movemask_ps(valid);
+
+	if (mask == 0) {
+		return -1;
+	}
+
+	float times[SPHERE_PACKET_WIDTH];
+	_mm256_storeu_ps(times, trueTime);
+
+	int closest = -1;
+	for (int lane = 0; lane < SPHERE_PACKET_WIDTH; lane++) {
+		if ((mask & (1 << lane)) && times[lane] < maxTime) {
+			maxTime = times[lane];
+			closest = lane;
+		}
+	}
+	time = maxTime;
+	return closest;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AnyHitAVX2
+ * Arguments:
+ *     const spherePacket & - the spheres
+ *     Vec3<float>          - the ray
+ *     Vec3<float>          - the starting position of the ray
+ *     float                - hits at or before this time are ignored
+ *     float                - hits at or after this time are ignored
+ * Purpose: AnyHit on all eight lanes at once
+ * Return Value: bool
+ */
+SIMD_TARGET_AVX2 static bool AnyHitAVX2(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	__m256 time0, time1;
+	__m256 valid = RootsAVX2(packet, ray, startingPos, time0, time1);
+	if (_mm256_movemask_ps(valid) == 0) {
+		return false;
+	}
+	__m256 low = _mm256_set1_ps(minTime);
+	__m256 high = _mm256_set1_ps(maxTime);
+
+	__m256 inside0 = _mm256_and_ps(_mm256_cmp_ps(time0, low, _CMP_GT_OQ), _mm256_cmp_ps(time0, high, _CMP_LT_OQ));
+	__m256 inside1 = _mm256_and_ps(_mm256_cmp_ps(time1, low, _CMP_GT_OQ), _mm256_cmp_ps(time1, high, _CMP_LT_OQ));
+	return _mm256_movemask_ps(_mm256_and_ps(valid, _mm256_or_ps(inside0, inside1))) != 0;
+}
+
+#endif
+
+/*
+ * Date: 10/17/26
+ * Function Name: SphereKernel (constructor)
+ * Arguments:
+ *     void
+ * Purpose: Constructor using the widest kernel the processor supports
+ * Return Value: void
+ */
+SphereKernel::SphereKernel() {
+	Select(Simd::GetBestLevel());
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SphereKernel (constructor)
+ * Arguments:
+ *     simd_level - the kernel to use.  Lowered to the best supported level if the processor lacks it
+ * Purpose: Constructor
+ * Return Value: void
+ */
+SphereKernel::SphereKernel(simd_level level) {
+	Select(Simd::Supported(level));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Select
+ * Arguments:
+ *     simd_level - a supported level
+ * Purpose: Points the hit functions at the kernel for the level
+ * Return Value: void
+ */
+void SphereKernel::Select(simd_level level) {
+	_level = level;
+	_closestHit = ClosestHitScalar;
+	_anyHit = AnyHitScalar;
+
+#ifdef SIMD_X86
+	if (level == SIMD_SSE) {
+		_closestHit = ClosestHitSSE;
+		_anyHit = AnyHitSSE;
+	} else if (level == SIMD_AVX2) {
+		_closestHit = ClosestHitAVX2;
+		_anyHit = AnyHitAVX2;
+	}
+#endif
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetLevel
+ * Arguments:
+ *     void
+ * Purpose: Returns the level of the kernel in use
+ * Return Value: simd_level
+ */
+simd_level SphereKernel::GetLevel() {
+	return _level;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ClearPacket
+ * Arguments:
+ *     spherePacket & - the packet
+ * Purpose: Empties every lane of a packet
+ * Return Value: void
+ */
+void SphereKernel::ClearPacket(spherePacket &packet) {
+	for (int lane = 0; lane < SPHERE_PACKET_WIDTH; lane++) {
+		packet.centerX[lane] = 0;
+		packet.centerY[lane] = 0;
+		packet.centerZ[lane] = 0;
+		packet.radiusSquared[lane] = -FLT_MAX;
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetSphere
+ * Arguments:
+ *     spherePacket & - the packet
+ *     int            - the lane to fill
+ *     Vec3<float>    - the center of the sphere
+ *     float          - the radius of the sphere
+ * Purpose: Stores a sphere in one lane
+ * Return Value: void
+ */
+void SphereKernel::SetSphere(spherePacket &packet, int lane, Vec3<float> center, float radius) {
+	packet.centerX[lane] = center.x;
+	packet.centerY[lane] = center.y;
+	packet.centerZ[lane] = center.z;
+	packet.radiusSquared[lane] = radius * radius;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetCenter
+ * Arguments:
+ *     const spherePacket & - the packet
+ *     int                  - the lane
+ * Purpose: Gets the center of the sphere in a lane
+ * Return Value: Vec3<float>
+ */
+Vec3<float> SphereKernel::GetCenter(const spherePacket &packet, int lane) {
+	return Vec3<float>::vec3(packet.centerX[lane], packet.centerY[lane], packet.centerZ[lane]);
+}
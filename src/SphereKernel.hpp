@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Simd.hpp"
+#include "Vector.hpp"
+
+#define SPHERE_PACKET_WIDTH 8 // Spheres per packet.  One AVX2 register or two SSE registers per component
+
+// Eight spheres in structure of arrays form with the squared radius precomputed.  Unused lanes have a negative
+// squared radius which no ray can hit
+typedef struct {
+	float centerX[SPHERE_PACKET_WIDTH];
+	float centerY[SPHERE_PACKET_WIDTH];
+	float centerZ[SPHERE_PACKET_WIDTH];
+	float radiusSquared[SPHERE_PACKET_WIDTH];
+} spherePacket;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: SphereKernel
+ * Purpose: Intersects one ray with a packet of spheres at once.  The SSE and AVX2 versions are picked at run
+ *          time when the processor supports them, the scalar version works everywhere
+ */
+class SphereKernel {
+
+	public :
+		SphereKernel();
+		SphereKernel(simd_level level);
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: ClosestHit
+		 * Arguments:
+		 *     const spherePacket & - the spheres
+		 *     Vec3<float>          - the ray
+		 *     Vec3<float>          - the starting position of the ray
+		 *     float                - hits at or after this time are ignored
+		 *     float &              - set to the time of the closest hit
+		 * Purpose: Finds the closest sphere of the packet the same way Sphere::Intersect does
+		 * Return Value: int - the lane of the closest hit (the lowest lane on ties), -1 if nothing was hit
+		 */
+		int ClosestHit(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time) {
+			return _closestHit(packet, ray, startingPos, maxTime, time);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: AnyHit
+		 * Arguments:
+		 *     const spherePacket & - the spheres
+		 *     Vec3<float>          - the ray
+		 *     Vec3<float>          - the starting position of the ray
+		 *     float                - hits at or before this time are ignored
+		 *     float                - hits at or after this time are ignored
+		 * Purpose: Tests if the ray enters or leaves any sphere of the packet between the two times
+		 * Return Value: bool
+		 */
+		bool AnyHit(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+			return _anyHit(packet, ray, startingPos, minTime, maxTime);
+		}
+
+		simd_level GetLevel();
+
+		static void ClearPacket(spherePacket &packet);
+		static void SetSphere(spherePacket &packet, int lane, Vec3<float> center, float radius);
+		static Vec3<float> GetCenter(const spherePacket &packet, int lane);
+
+	private :
+		typedef int (*closestHitFunction)(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time);
+		typedef bool (*anyHitFunction)(const spherePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+
+		void Select(simd_level level);
+
+		simd_level _level;
+		closestHitFunction _closestHit;
+		anyHitFunction _anyHit;
+};
@@ -0,0 +1,216 @@
+#include "SphereSet.hpp"
+
+#include "Sphere.hpp"
+
+/*
+ * Date: 10/17/26
+ * Function Name: SphereSet (constructor)
+ * Arguments:
+ *     Arena &             - the arena of the scene the packets are stored in
+ *     const Vec3<float> * - the centers of the spheres
+ *     const float *       - the radius of every sphere.  Must stay valid as long as the set
+ *     int                 - the number of spheres
+ *     materialId          - the entry of the material table of the spheres
+ * Purpose: Constructor.  Packs the spheres eight to a packet, the last packet is padded with empty lanes
+ * Return Value: void
+ */
+SphereSet::SphereSet(Arena &arena, const Vec3<float> * centers, const float * radii, int count, materialId material) : super(SPHERE_SET), _radii(radii),
+                                                                                                                         _packetCount((count + SPHERE_PACKET_WIDTH - 1) / SPHERE_PACKET_WIDTH), _count(count) {
+	_packets = (spherePacket *)arena.Allocate(sizeof(spherePacket) * _packetCount, alignof(spherePacket));
+	for (int i = 0; i < _packetCount; i++) {
+		SphereKernel::ClearPacket(_packets[i]);
+	}
+	for (int i = 0; i < _count; i++) {
+		SphereKernel::SetSphere(_packets[i / SPHERE_PACKET_WIDTH], i % SPHERE_PACKET_WIDTH, centers[i], _radii[i]);
+	}
+
+	SetMaterialId(material);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Intersect
+ * Arguments:
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     RayHit &    - the hit record holding the closest hit so far
+ * Purpose: Finds the closest sphere of the set a packet at a time
+ * Return Value: bool - true if the hit record was updated
+ */
+bool SphereSet::Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+	int closestPacket = -1, closestLane = -1;
+	float time = rayHit.GetTime();
+
+	for (int i = 0; i < _packetCount; i++) {
+		int lane = _kernel.ClosestHit(_packets[i], ray, startingPos, time, time);
+		if (lane >= 0) {
+			closestPacket = i;
+			closestLane = lane;
+		}
+	}
+
+	if (closestPacket < 0) {
+		return false;
+	}
+
+	// Same hit record Sphere::Intersect writes
+	Vec3<float> hitLocation = (ray * time) + startingPos;
+	Vec3<float> normal = Vec3<float>::Normalize(hitLocation - SphereKernel::GetCenter(_packets[closestPacket], closestLane));
+	rayHit.SetHit(time, GetMaterialId(), normal, Vec3<float>::vec3(0, 0, 0), hitLocation, ray);
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Occluded
+ * Arguments:
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Tests if any sphere of the set blocks the ray
+ * Return Value: bool
+ */
+bool SphereSet::Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	for (int i = 0; i < _packetCount; i++) {
+		if (_kernel.AnyHit(_packets[i], ray, startingPos, minTime, maxTime)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetBoundingBox
+ * Arguments:
+ *     void
+ * Purpose: Gets the bounds of every sphere
+ * Return Value: BoundingBox
+ */
+BoundingBox SphereSet::GetBoundingBox() {
+	BoundingBox box;
+	for (int i = 0; i < GetSphereCount(); i++) {
+		box.Expand(GetPrimitiveBounds(i));
+	}
+	return box;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPrimitiveCount
+ * Arguments:
+ *     void
+ * Purpose: Every sphere is bounded separately
+ * Return Value: int
+ */
+int SphereSet::GetPrimitiveCount() {
+	return GetSphereCount();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetPrimitiveBounds
+ * Arguments:
+ *     int - the sphere
+ * Purpose: Gets the bounds of one sphere
+ * Return Value: BoundingBox
+ */
+BoundingBox SphereSet::GetPrimitiveBounds(int index) {
+	Vec3<float> center = GetCenter(index);
+	return BoundingBox(center + (-_radii[index]), center + _radii[index]);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: IntersectPrimitive
+ * Arguments:
+ *     int         - the sphere
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     RayHit &    - the hit record holding the closest hit so far
+ * Purpose: Intersects one sphere
+ * Return Value: bool - true if the hit record was updated
+ */
+bool SphereSet::IntersectPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
+	return Sphere(GetCenter(index), _radii[index], GetMaterialId()).Intersect(ray, startingPos, rayHit);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: OccludedPrimitive
+ * Arguments:
+ *     int         - the sphere
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Tests one sphere for shadow rays
+ * Return Value: bool
+ */
+bool SphereSet::OccludedPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	return Sphere(GetCenter(index), _radii[index], GetMaterialId()).Occluded(ray, startingPos, minTime, maxTime);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetSphere
+ * Arguments:
+ *     int           - the sphere
+ *     Vec3<float> & - set to the center
+ *     float &       - set to the radius
+ * Purpose: Gets one sphere for the packets of the acceleration structure
+ * Return Value: bool - true
+ */
+bool SphereSet::GetSphere(int index, Vec3<float> &center, float &radius) {
+	center = GetCenter(index);
+	radius = _radii[index];
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetSphereCount
+ * Arguments:
+ *     void
+ * Return Value: int
+ */
+int SphereSet::GetSphereCount() {
+	return _count;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetCenter
+ * Arguments:
+ *     int - the sphere
+ * Return Value: Vec3<float>
+ */
+Vec3<float> SphereSet::GetCenter(int index) {
+	return SphereKernel::GetCenter(_packets[index / SPHERE_PACKET_WIDTH], index % SPHERE_PACKET_WIDTH);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetRadius
+ * Arguments:
+ *     int - the sphere
+ * Return Value: float
+ */
+float SphereSet::GetRadius(int index) {
+	return _radii[index];
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Translate
+ * Arguments:
+ *     Vec3<float> - the offset
+ * Purpose: Moves every sphere of the set
+ * Return Value: void
+ */
+void SphereSet::Translate(Vec3<float> offset) {
+	for (int i = 0; i < _count; i++) {
+		SphereKernel::SetSphere(_packets[i / SPHERE_PACKET_WIDTH], i % SPHERE_PACKET_WIDTH, GetCenter(i) + offset, _radii[i]);
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "Arena.hpp"
+#include "Geometry.hpp"
+#include "Material.hpp"
+#include "RayHit.hpp"
+#include "SphereKernel.hpp"
+#include "Vector.hpp"
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: SphereSet
+ * Purpose: Many spheres sharing a color and material, stored in packets of centers and squared radii so the
+ *          sphere kernel tests a whole packet per instruction.  The spheres are bounded separately in the
+ *          acceleration structure.  The packets and radii live in the arena of the scene
+ */
+class SphereSet : public Geometry {
+
+	public :
+		SphereSet(Arena &arena, const Vec3<float> * centers, const float * radii, int count, materialId material = MATERIAL_DEFAULT);
+		bool Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		bool Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		BoundingBox GetBoundingBox();
+
+		int GetPrimitiveCount();
+		BoundingBox GetPrimitiveBounds(int index);
+		bool IntersectPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		bool OccludedPrimitive(int index, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		bool GetSphere(int index, Vec3<float> &center, float &radius);
+		void Translate(Vec3<float> offset);
+
+		int GetSphereCount();
+		Vec3<float> GetCenter(int index);
+		float GetRadius(int index);
+
+	private :
+		spherePacket * _packets;
+		const float * _radii;
+		int _packetCount;
+		int _count;
+		SphereKernel _kernel;
+
+		typedef Geometry super;
+};
@@ -8,15 +8,13 @@
  * 	   Vec3<float> - one point on the square
  * 	   Vec3<float> - one point on the square
  * 	   Vec3<float> - one point on the square
- *	   Vec3        - the color component
- *     Material    - the material of the triangle
+ *     materialId  - the entry of the material table
  * Purpose: Constructor 
  * Return Value: void
  */
-Square::Square(Vec3<float> a, Vec3<float> b, Vec3<float> c, Vec3<float> d, Vec3<unsigned char> color, Material mat) : super(SQUARE), _firstTriangle(a, b, c, color, mat), _secondTriangle(c, b, d, color, mat) {
+Square::Square(Vec3<float> a, Vec3<float> b, Vec3<float> c, Vec3<float> d, materialId material) : super(SQUARE), _firstTriangle(a, b, c, material), _secondTriangle(c, b, d, material) {
 	
-	SetMaterial(mat);
-	SetColor(color);
+	SetMaterialId(material);
 }
 
 
@@ -26,31 +24,84 @@ Square::Square(Vec3<float> a, Vec3<float> b, Vec3<float> c, Vec3<float> d, Vec3<
  * Arguments:
  *     Vec3<float> - the ray
  *	   Vec3<float> - the starting position of the ray
+ *     RayHit &    - the hit record holding the closest hit so far
  * Purpose: Gives the intersection between a triangle and the incoming ray 
- * Return Value: RayHit
+ * Return Value: bool - true if the hit record was updated
  */
-std::shared_ptr<RayHit> Square::Intersect(Vec3<float> ray, Vec3<float> startingPos) {
+bool Square::Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
 	
-	std::shared_ptr<RayHit> rayHit1 = _firstTriangle.Intersect(ray, startingPos);
-	std::shared_ptr<RayHit> rayHit2 = _secondTriangle.Intersect(ray, startingPos);
-	
-	if(rayHit2 == nullptr) {
-		return rayHit1;
-	}
+	// The second triangle only replaces the first hit if it is closer
+	bool hitFirst = _firstTriangle.Intersect(ray, startingPos, rayHit);
+	bool hitSecond = _secondTriangle.Intersect(ray, startingPos, rayHit);
+	return hitFirst || hitSecond;
+}
 
-	if(rayHit1 == nullptr) {
-		return rayHit2;
-	}
+/*
+ * Date: 10/17/26
+ * Function Name: Occluded
+ * Arguments:
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Tests if the ray hits either triangle between the two times
+ * Return Value: bool
+ */
+bool Square::Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	return _firstTriangle.Occluded(ray, startingPos, minTime, maxTime) || _secondTriangle.Occluded(ray, startingPos, minTime, maxTime);
+}
 
-	float time1 = rayHit1->GetTime();
-	float time2 = rayHit2->GetTime();
+/*
+ * Date: 10/17/26
+ * Function Name: GetBoundingBox
+ * Arguments:
+ *     void
+ * Purpose: Gets the bounds of both triangles making up the square
+ * Return Value: BoundingBox
+ */
+BoundingBox Square::GetBoundingBox() {
+	BoundingBox box = _firstTriangle.GetBoundingBox();
+	box.Expand(_secondTriangle.GetBoundingBox());
+	return box;
+}
 
-	if(time1 < 0.0005f) {
-		return rayHit2;
-	} else if(time2 < 0.0005f) {
-		return rayHit1;
-	} else {
-        return time1 < time2 ? rayHit1 : rayHit2;
+/*
+ * Date: 10/17/26
+ * Function Name: GetVertex
+ * Arguments:
+ *		int - the vertex (0 to 3) in the order given to the constructor
+ * Return Value: Vec3<float>
+ */
+Vec3<float> Square::GetVertex(int index) {
+	// The second triangle is (c, b, d) so it only adds the last vertex
+	if (index == 3) {
+		return _secondTriangle.GetVertex(2);
 	}
+	return _firstTriangle.GetVertex(index);
 }
 
+/*
+ * Date: 10/17/26
+ * Function Name: GetTriangles
+ * Arguments:
+ *		int           - unused, the square is one primitive
+ *		Vec3<float> * - filled with the vertices of both triangles
+ * Return Value: int - 2
+ */
+int Square::GetTriangles(int index, Vec3<float> * vertices) {
+	_firstTriangle.GetTriangles(-1, vertices);
+	_secondTriangle.GetTriangles(-1, vertices + 3);
+	return 2;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Translate
+ * Arguments:
+ *		Vec3<float> - the offset
+ * Return Value: void
+ */
+void Square::Translate(Vec3<float> offset) {
+	_firstTriangle.Translate(offset);
+	_secondTriangle.Translate(offset);
+}
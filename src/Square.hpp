@@ -17,8 +17,13 @@
 class Square : public Geometry {
 
 	public :
-		Square(Vec3<float> a, Vec3<float> b, Vec3<float> c, Vec3<float> d, Vec3<unsigned char> color, Material mat = MATERIAL_NONE);
-		std::shared_ptr<RayHit> Intersect(Vec3<float> ray, Vec3<float> startingPosition);
+		Square(Vec3<float> a, Vec3<float> b, Vec3<float> c, Vec3<float> d, materialId material = MATERIAL_DEFAULT);
+		bool Intersect(Vec3<float> ray, Vec3<float> startingPosition, RayHit &rayHit);
+		bool Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		BoundingBox GetBoundingBox();
+		Vec3<float> GetVertex(int index);
+		int GetTriangles(int index, Vec3<float> * vertices);
+		void Translate(Vec3<float> offset);
 
 	private:
 		Triangle _firstTriangle;
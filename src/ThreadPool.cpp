@@ -0,0 +1,263 @@
+#include "ThreadPool.hpp"
+
+#include <sched.h>
+#include <thread>
+
+// The pool and queue owned by the current thread (null/-1 for threads outside of a pool)
+static thread_local ThreadPool * currentPool = nullptr;
+static thread_local int currentIndex = -1;
+
+/*
+ * Date: 10/17/26
+ * Function Name: ThreadPool (constructor)
+ * Arguments:
+ *     int - the number of worker threads.  Zero or less uses every hardware thread
+ * Purpose: Constructor.  Starts the worker threads which sleep until work is submitted
+ * Return Value: void
+ */
+ThreadPool::ThreadPool(int threadCount) : _queued(0), _nextQueue(0), _shutdown(false) {
+	if (threadCount <= 0) {
+		threadCount = GetHardwareThreads();
+	}
+
+	pthread_mutex_init(&_sleepLock, NULL);
+	pthread_cond_init(&_wake, NULL);
+
+	_queues.resize(threadCount);
+	_workerArgs.resize(threadCount);
+	_threads.resize(threadCount);
+	for (int i = 0; i < threadCount; i++) {
+		_queues[i] = new TaskQueue();
+		pthread_mutex_init(&_queues[i]->lock, NULL);
+		_workerArgs[i].pool = this;
+		_workerArgs[i].index = i;
+	}
+
+	// Start the workers only once every queue exists since they steal from each other
+	for (int i = 0; i < threadCount; i++) {
+		pthread_create(&_threads[i], NULL, WorkerMain, &_workerArgs[i]);
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ~ThreadPool
+ * Arguments:
+ *     void
+ * Purpose: Destructor.  Lets the workers drain their queues then joins them
+ * Return Value: void
+ */
+ThreadPool::~ThreadPool() {
+	pthread_mutex_lock(&_sleepLock);
+	_shutdown = true;
+	pthread_cond_broadcast(&_wake);
+	pthread_mutex_unlock(&_sleepLock);
+
+	for (size_t i = 0; i < _threads.size(); i++) {
+		pthread_join(_threads[i], NULL);
+	}
+
+	for (size_t i = 0; i < _queues.size(); i++) {
+		pthread_mutex_destroy(&_queues[i]->lock);
+		delete(_queues[i]);
+	}
+	pthread_cond_destroy(&_wake);
+	pthread_mutex_destroy(&_sleepLock);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Submit
+ * Arguments:
+ *     TaskGroup &           - the group the task is counted in
+ *     std::function<void()> - the work to run
+ * Purpose: Queues a task.  Workers push onto their own queue so nested work stays local, other threads
+ *          spread their tasks across the queues
+ * Return Value: void
+ */
+void ThreadPool::Submit(TaskGroup &group, std::function<void()> task) {
+	group._pending++;
+
+	int queueIndex;
+	if (currentPool == this) {
+		queueIndex = currentIndex;
+	} else {
+		queueIndex = (int)(_nextQueue++ % _queues.size());
+	}
+
+	Task newTask;
+	newTask.function = task;
+	newTask.group = &group;
+
+	TaskQueue * queue = _queues[queueIndex];
+	pthread_mutex_lock(&queue->lock);
+	queue->tasks.push_back(newTask);
+	pthread_mutex_unlock(&queue->lock);
+
+	_queued++;
+
+	pthread_mutex_lock(&_sleepLock);
+	pthread_cond_signal(&_wake);
+	pthread_mutex_unlock(&_sleepLock);
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Wait
+ * Arguments:
+ *     TaskGroup & - the group to wait on
+ * Purpose: Blocks until every task in the group finished.  The waiting thread runs queued tasks meanwhile so
+ *          tasks can wait on the work they submit
+ * Return Value: void
+ */
+void ThreadPool::Wait(TaskGroup &group) {
+	int self = (currentPool == this) ? currentIndex : -1;
+
+	while (!group.IsDone()) {
+		Task task;
+		if ((self >= 0 && PopTask(self, task)) || StealTask(self, task)) {
+			RunTask(task);
+		} else {
+			sched_yield();
+		}
+	}
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetThreadCount
+ * Arguments:
+ *     void
+ * Purpose: Returns the number of worker threads in the pool
+ * Return Value: int
+ */
+int ThreadPool::GetThreadCount() {
+	return (int)_threads.size();
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetHardwareThreads
+ * Arguments:
+ *     void
+ * Purpose: Returns the number of threads the hardware can run at once
+ * Return Value: int
+ */
+int ThreadPool::GetHardwareThreads() {
+	int count = (int)std::thread::hardware_concurrency();
+	return count > 0 ? count : 1;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: WorkerMain
+ * Arguments:
+ *     void * - the WorkerArgs of the thread
+ * Purpose: Runs tasks from the worker's queue, steals when it is empty and sleeps when every queue is empty
+ * Return Value: void *
+ */
+void * ThreadPool::WorkerMain(void * arg) {
+	WorkerArgs * args = (WorkerArgs *) arg;
+	ThreadPool * pool = args->pool;
+	currentPool = pool;
+	currentIndex = args->index;
+
+	for (;;) {
+		Task task;
+		if (pool->PopTask(args->index, task) || pool->StealTask(args->index, task)) {
+			pool->RunTask(task);
+			continue;
+		}
+
+		pthread_mutex_lock(&pool->_sleepLock);
+		while (pool->_queued.load() <= 0 && !pool->_shutdown) {
+			pthread_cond_wait(&pool->_wake, &pool->_sleepLock);
+		}
+		bool stop = pool->_shutdown && pool->_queued.load() <= 0;
+		pthread_mutex_unlock(&pool->_sleepLock);
+
+		if (stop) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: PopTask
+ * Arguments:
+ *     int    - the queue to take from
+ *     Task & - set to the task
+ * Purpose: Takes the most recently queued task from the back of a queue
+ * Return Value: bool - false if the queue was empty
+ */
+bool ThreadPool::PopTask(int queueIndex, Task &task) {
+	TaskQueue * queue = _queues[queueIndex];
+	bool found = false;
+
+	pthread_mutex_lock(&queue->lock);
+	if (!queue->tasks.empty()) {
+		task = queue->tasks.back();
+		queue->tasks.pop_back();
+		found = true;
+	}
+	pthread_mutex_unlock(&queue->lock);
+
+	if (found) {
+		_queued--;
+	}
+	return found;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: StealTask
+ * Arguments:
+ *     int    - the queue of the thief (-1 if the thief is not a worker)
+ *     Task & - set to the stolen task
+ * Purpose: Takes the oldest task from the front of another queue.  Old tasks tend to be the largest ones
+ * Return Value: bool - false if every other queue was empty
+ */
+bool ThreadPool::StealTask(int thiefIndex, Task &task) {
+	int count = (int)_queues.size();
+	int start = thiefIndex < 0 ? 0 : thiefIndex + 1;
+
+	for (int i = 0; i < count; i++) {
+		int victim = (start + i) % count;
+		if (victim == thiefIndex) {
+			continue;
+		}
+
+		TaskQueue * queue = _queues[victim];
+		bool found = false;
+
+		pthread_mutex_lock(&queue->lock);
+		if (!queue->tasks.empty()) {
+			task = queue->tasks.front();
+			queue->tasks.pop_front();
+			found = true;
+		}
+		pthread_mutex_unlock(&queue->lock);
+
+		if (found) {
+			_queued--;
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: RunTask
+ * Arguments:
+ *     Task & - the task to run
+ * Purpose: Runs the task and marks it finished in its group
+ * Return Value: void
+ */
+void ThreadPool::RunTask(Task &task) {
+	task.function();
+	task.group->_pending--;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <pthread.h>
+#include <vector>
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: TaskGroup
+ * Purpose: Counts the outstanding tasks submitted together so a caller can wait on just those tasks
+ */
+class TaskGroup {
+
+	public :
+		TaskGroup() : _pending(0) {}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: IsDone
+		 * Arguments:
+		 *     void
+		 * Purpose: Returns true once every task in the group has finished
+		 * Return Value: bool
+		 */
+		bool IsDone() {
+			return _pending.load() == 0;
+		}
+
+	private :
+		std::atomic<int> _pending;
+
+		friend class ThreadPool;
+};
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: ThreadPool
+ * Purpose: A persistent pool of pthreads.  Every worker owns a task queue, works from the back of its own queue
+ *          and steals from the front of the others when it runs dry
+ */
+class ThreadPool {
+
+	public :
+		ThreadPool(int threadCount = 0);
+		~ThreadPool();
+
+		void Submit(TaskGroup &group, std::function<void()> task);
+		void Wait(TaskGroup &group);
+		int GetThreadCount();
+
+		static int GetHardwareThreads();
+
+	private :
+		typedef struct {
+			std::function<void()> function;
+			TaskGroup * group;
+		} Task;
+
+		typedef struct {
+			pthread_mutex_t lock;
+			std::deque<Task> tasks;
+		} TaskQueue;
+
+		typedef struct {
+			ThreadPool * pool;
+			int index;
+		} WorkerArgs;
+
+		static void * WorkerMain(void * arg);
+		bool PopTask(int queueIndex, Task &task);
+		bool StealTask(int thiefIndex, Task &task);
+		void RunTask(Task &task);
+
+		std::vector<pthread_t> _threads;
+		std::vector<TaskQueue *> _queues;
+		std::vector<WorkerArgs> _workerArgs;
+		std::atomic<int> _queued;
+		std::atomic<unsigned int> _nextQueue;
+		pthread_mutex_t _sleepLock;
+		pthread_cond_t _wake;
+		bool _shutdown;
+};
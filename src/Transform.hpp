@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cmath>
+
+#include "BoundingBox.hpp"
+#include "Vector.hpp"
+
+#define TRANSFORM_PI 3.14159265358979f
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: Transform
+ * Purpose: An affine transform (rotation, scale and translation) stored as the three rows of a 3x4 matrix.  Used to
+ *          place instances of a mesh in the scene
+ */
+class Transform {
+
+	public :
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Transform (constructor)
+		 * Arguments:
+		 *     void
+		 * Purpose: Constructor for the identity
+		 * Return Value: void
+		 */
+		Transform() {
+			for (int row = 0; row < 3; row++) {
+				for (int column = 0; column < 4; column++) {
+					_m[row][column] = row == column ? 1.f : 0.f;
+				}
+			}
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Transform (constructor)
+		 * Arguments:
+		 *     Vec3<float> - where the x axis goes
+		 *     Vec3<float> - where the y axis goes
+		 *     Vec3<float> - where the z axis goes
+		 *     Vec3<float> - where the origin goes
+		 * Purpose: Constructor from the columns of the matrix
+		 * Return Value: void
+		 */
+		Transform(Vec3<float> xAxis, Vec3<float> yAxis, Vec3<float> zAxis, Vec3<float> origin) {
+			Vec3<float> columns[4] = { xAxis, yAxis, zAxis, origin };
+			for (int column = 0; column < 4; column++) {
+				_m[0][column] = columns[column].x;
+				_m[1][column] = columns[column].y;
+				_m[2][column] = columns[column].z;
+			}
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Translation
+		 * Arguments:
+		 *     Vec3<float> - the offset
+		 * Purpose: Creates a transform that moves points by an offset
+		 * Return Value: Transform
+		 */
+		static Transform Translation(Vec3<float> offset) {
+			Transform transform;
+			transform._m[0][3] = offset.x;
+			transform._m[1][3] = offset.y;
+			transform._m[2][3] = offset.z;
+			return transform;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Scale
+		 * Arguments:
+		 *     Vec3<float> - the factor along each axis
+		 * Purpose: Creates a transform that scales about the origin
+		 * Return Value: Transform
+		 */
+		static Transform Scale(Vec3<float> factors) {
+			Transform transform;
+			transform._m[0][0] = factors.x;
+			transform._m[1][1] = factors.y;
+			transform._m[2][2] = factors.z;
+			return transform;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Rotation
+		 * Arguments:
+		 *     int   - the axis (0 = x, 1 = y, 2 = z)
+		 *     float - the angle in degrees, counter clockwise looking down the axis
+		 * Purpose: Creates a transform that rotates about an axis through the origin
+		 * Return Value: Transform
+		 */
+		static Transform Rotation(int axis, float degrees) {
+			Transform transform;
+			float radians = degrees * TRANSFORM_PI / 180.f;
+			float c = cosf(radians), s = sinf(radians);
+			int a = (axis + 1) % 3, b = (axis + 2) % 3;
+			transform._m[a][a] = c;
+			transform._m[a][b] = -s;
+			transform._m[b][a] = s;
+			transform._m[b][b] = c;
+			return transform;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Then
+		 * Arguments:
+		 *     const Transform & - the transform applied afterwards
+		 * Purpose: Combines two transforms into one that applies this one first
+		 * Return Value: Transform
+		 */
+		Transform Then(const Transform &next) const {
+			Transform result;
+			for (int row = 0; row < 3; row++) {
+				for (int column = 0; column < 4; column++) {
+					float value = column == 3 ? next._m[row][3] : 0.f;
+					for (int k = 0; k < 3; k++) {
+						value += next._m[row][k] * _m[k][column];
+					}
+					result._m[row][column] = value;
+				}
+			}
+			return result;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Inverse
+		 * Arguments:
+		 *     Transform & - set to the inverse
+		 * Purpose: Inverts the transform
+		 * Return Value: bool - false if the transform flattens space (a scale of zero) and has no inverse
+		 */
+		bool Inverse(Transform &inverse) const {
+			float determinant = _m[0][0] * (_m[1][1] * _m[2][2] - _m[1][2] * _m[2][1])
+			                  - _m[0][1] * (_m[1][0] * _m[2][2] - _m[1][2] * _m[2][0])
+			                  + _m[0][2] * (_m[1][0] * _m[2][1] - _m[1][1] * _m[2][0]);
+			if (fabsf(determinant) < 1e-12f) {
+				return false;
+			}
+
+			// The inverse of the 3x3 part is its adjugate over the determinant
+			for (int row = 0; row < 3; row++) {
+				for (int column = 0; column < 3; column++) {
+					int r0 = (column + 1) % 3, r1 = (column + 2) % 3, c0 = (row + 1) % 3, c1 = (row + 2) % 3;
+					inverse._m[row][column] = (_m[r0][c0] * _m[r1][c1] - _m[r0][c1] * _m[r1][c0]) / determinant;
+				}
+			}
+			for (int row = 0; row < 3; row++) {
+				inverse._m[row][3] = -(inverse._m[row][0] * _m[0][3] + inverse._m[row][1] * _m[1][3] + inverse._m[row][2] * _m[2][3]);
+			}
+			return true;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Point
+		 * Arguments:
+		 *     const Vec3<float> & - the point
+		 * Purpose: Transforms a point
+		 * Return Value: Vec3<float>
+		 */
+		Vec3<float> Point(const Vec3<float> &point) const {
+			return Vec3<float>::vec3(_m[0][0] * point.x + _m[0][1] * point.y + _m[0][2] * point.z + _m[0][3],
+			                         _m[1][0] * point.x + _m[1][1] * point.y + _m[1][2] * point.z + _m[1][3],
+			                         _m[2][0] * point.x + _m[2][1] * point.y + _m[2][2] * point.z + _m[2][3]);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Vector
+		 * Arguments:
+		 *     const Vec3<float> & - the direction
+		 * Purpose: Transforms a direction, which the translation does not apply to.  The length changes with the
+		 *          scale, so a ray transformed this way reaches the same point at the same time
+		 * Return Value: Vec3<float>
+		 */
+		Vec3<float> Vector(const Vec3<float> &vector) const {
+			return Vec3<float>::vec3(_m[0][0] * vector.x + _m[0][1] * vector.y + _m[0][2] * vector.z,
+			                         _m[1][0] * vector.x + _m[1][1] * vector.y + _m[1][2] * vector.z,
+			                         _m[2][0] * vector.x + _m[2][1] * vector.y + _m[2][2] * vector.z);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: TransposedVector
+		 * Arguments:
+		 *     const Vec3<float> & - the direction
+		 * Purpose: Multiplies a direction by the transpose of the rotation and scale.  Normals are carried out of a
+		 *          transformed space by the transpose of the inverse, so this is called on the inverse
+		 * Return Value: Vec3<float>
+		 */
+		Vec3<float> TransposedVector(const Vec3<float> &vector) const {
+			return Vec3<float>::vec3(_m[0][0] * vector.x + _m[1][0] * vector.y + _m[2][0] * vector.z,
+			                         _m[0][1] * vector.x + _m[1][1] * vector.y + _m[2][1] * vector.z,
+			                         _m[0][2] * vector.x + _m[1][2] * vector.y + _m[2][2] * vector.z);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: Box
+		 * Arguments:
+		 *     const BoundingBox & - the box
+		 * Purpose: Returns the axis aligned box around the transformed corners of a box
+		 * Return Value: BoundingBox
+		 */
+		BoundingBox Box(const BoundingBox &box) const {
+			BoundingBox result;
+			if (box.IsEmpty()) {
+				return result;
+			}
+			for (int corner = 0; corner < 8; corner++) {
+				result.Expand(Point(Vec3<float>::vec3((corner & 1) ? box.upper.x : box.lower.x, (corner & 2) ? box.upper.y : box.lower.y,
+				                                      (corner & 4) ? box.upper.z : box.lower.z)));
+			}
+			return result;
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: GetColumn
+		 * Arguments:
+		 *     int - the column, 0 to 2 for where the axes go and 3 for where the origin goes
+		 * Purpose: Returns a column of the matrix
+		 * Return Value: Vec3<float>
+		 */
+		Vec3<float> GetColumn(int column) const {
+			return Vec3<float>::vec3(_m[0][column], _m[1][column], _m[2][column]);
+		}
+
+	private :
+		float _m[3][4];
+};
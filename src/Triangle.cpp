@@ -7,20 +7,18 @@
  *     Vec3<float> - the first vertex
  *     Vec3<float> - the second vertex
  *     Vec3<float> - the third vertex
- *	   Vec3     - the color component
- *     Material    - the material of the triangle
+ *     materialId  - the entry of the material table
  * Purpose: Constructor 
  * Return Value: void
  */
-Triangle::Triangle(Vec3<float> a, Vec3<float> b, Vec3<float> c, Vec3<unsigned char> color, Material mat) : super(TRIANGLE) {
+Triangle::Triangle(Vec3<float> a, Vec3<float> b, Vec3<float> c, materialId material) : super(TRIANGLE) {
 	
 	_vertexA = Vec3<float>::vec3(a.x, a.y, a.z);
 	_vertexB = Vec3<float>::vec3(b.x, b.y, b.z);
 	_vertexC = Vec3<float>::vec3(c.x, c.y, c.z);
 	_normal = Vec3<float>::Normalize(Vec3<float>::Cross(Vec3<float>::Sub(_vertexB, _vertexA), Vec3<float>::Sub(_vertexC, _vertexA)));
 	_secondNormal = Vec3<float>::vec3(0, 0, 0) - _normal;
-	SetMaterial(mat);
-	SetColor(color);
+	SetMaterialId(material);
 }
 
 /* 
@@ -36,19 +34,17 @@ Triangle::Triangle(Vec3<float> a, Vec3<float> b, Vec3<float> c, Vec3<unsigned ch
  *     float    - the third vertex x component
  *     float    - the third vertex y component
  *     float    - the third vertex z component
- *	   Vec3     - the color component
- *     Material - the material of the triangle
+ *     materialId - the entry of the material table
  * Purpose: Constructor 
  * Return Value: void
  */
-Triangle::Triangle(float ax, float ay, float az, float bx, float by, float bz, float cx, float cy, float cz, Vec3<unsigned char> color, Material mat) : super(TRIANGLE) {
+Triangle::Triangle(float ax, float ay, float az, float bx, float by, float bz, float cx, float cy, float cz, materialId material) : super(TRIANGLE) {
 	_vertexA = Vec3<float>::vec3(ax, ay, az);
 	_vertexB = Vec3<float>::vec3(bx, by, bz);
 	_vertexC = Vec3<float>::vec3(cx, cy, cz);
 	_normal = Vec3<float>::Normalize(Vec3<float>::Cross(_vertexB - _vertexA, _vertexC - _vertexA));
 	_secondNormal = Vec3<float>::vec3(0, 0, 0) - _normal;
-	SetMaterial(mat);
-	SetColor(color);
+	SetMaterialId(material);
 }
 
 /* 
@@ -57,10 +53,11 @@ Triangle::Triangle(float ax, float ay, float az, float bx, float by, float bz, f
  * Arguments:
  *     Vec3<float> - the ray
  *	   Vec3<float> - the starting position of the ray
+ *     RayHit &    - the hit record holding the closest hit so far
  * Purpose: Gives the intersection between a triangle and the incoming ray 
- * Return Value: RayHit
+ * Return Value: bool - true if the hit record was updated
  */
-std::shared_ptr<RayHit> Triangle::Intersect(Vec3<float> ray, Vec3<float> startingPos) {
+bool Triangle::Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit) {
 	float A = _vertexA.x - _vertexB.x;
 	float B = _vertexA.y - _vertexB.y;
 	float C = _vertexA.z - _vertexB.z;
@@ -79,22 +76,124 @@ std::shared_ptr<RayHit> Triangle::Intersect(Vec3<float> ray, Vec3<float> startin
 	float M = A * (E * I - H * F) + B * (G * F - D * I) + C * (D * H - E * G);
 	float t = (-1 * (F * (A * K - J * B) + E * (J * C - A * L) + D * (B * L - K * C) ) ) / M;
 
-	if( t < 0 ) {
-		return nullptr;
+	if( !(t >= 0 && t < rayHit.GetTime()) ) {
+		return false;
 	}
 	float gamma = (I * (A * K - J * B) + H * (J * C - A * L) + G * (B * L - K * C)) / M;
 	
 	if( gamma < 0 || gamma > 1 ) {
-		return nullptr;
+		return false;
 	}
 	float beta = (J * (E * I - H * F) + K * (G * F - D * I) + L * (D * H - E * G)) / M;
 	
 	if( beta < 0 || beta > 1 - gamma ) {
-		return nullptr;
+		return false;
 	}
 	
 	Vec3<float> hitLocation = Vec3<float>::Add(Vec3<float>::vec3(t * ray.x, t * ray.y, t* ray.z), startingPos);
-	std::shared_ptr<RayHit> rayHit(new RayHit(t, GetMaterial(), GetColor(), _normal, _secondNormal,  hitLocation, ray));
+	rayHit.SetHit(t, GetMaterialId(), _normal, _secondNormal, hitLocation, ray);
 	 
-	return rayHit;
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Occluded
+ * Arguments:
+ *     Vec3<float> - the ray
+ *	   Vec3<float> - the starting position of the ray
+ *     float       - hits at or before this time are ignored
+ *     float       - hits at or after this time are ignored
+ * Purpose: Tests if the ray hits the triangle between the two times without building a RayHit
+ * Return Value: bool
+ */
+bool Triangle::Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	float A = _vertexA.x - _vertexB.x;
+	float B = _vertexA.y - _vertexB.y;
+	float C = _vertexA.z - _vertexB.z;
+	float D = _vertexA.x - _vertexC.x;
+	float E = _vertexA.y - _vertexC.y;
+	float F = _vertexA.z - _vertexC.z;
+
+	float G = ray.x;
+	float H = ray.y;
+	float I = ray.z;
+
+	float J = _vertexA.x - startingPos.x;
+	float K = _vertexA.y - startingPos.y;
+	float L = _vertexA.z - startingPos.z;
+
+	float M = A * (E * I - H * F) + B * (G * F - D * I) + C * (D * H - E * G);
+	float t = (-1 * (F * (A * K - J * B) + E * (J * C - A * L) + D * (B * L - K * C) ) ) / M;
+
+	if( !(t > minTime && t < maxTime) ) {
+		return false;
+	}
+	float gamma = (I * (A * K - J * B) + H * (J * C - A * L) + G * (B * L - K * C)) / M;
+
+	if( gamma < 0 || gamma > 1 ) {
+		return false;
+	}
+	float beta = (J * (E * I - H * F) + K * (G * F - D * I) + L * (D * H - E * G)) / M;
+
+	return beta >= 0 && beta <= 1 - gamma;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetBoundingBox
+ * Arguments:
+ *     void
+ * Purpose: Gets the bounds of the three vertices
+ * Return Value: BoundingBox
+ */
+BoundingBox Triangle::GetBoundingBox() {
+	BoundingBox box;
+	box.Expand(_vertexA);
+	box.Expand(_vertexB);
+	box.Expand(_vertexC);
+	return box;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetVertex
+ * Arguments:
+ *		int - the vertex (0 to 2) in the order given to the constructor
+ * Return Value: Vec3<float>
+ */
+Vec3<float> Triangle::GetVertex(int index) {
+	if (index == 0) {
+		return _vertexA;
+	}
+	return index == 1 ? _vertexB : _vertexC;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetTriangles
+ * Arguments:
+ *		int           - unused, the triangle is one primitive
+ *		Vec3<float> * - filled with the three vertices
+ * Return Value: int - 1
+ */
+int Triangle::GetTriangles(int index, Vec3<float> * vertices) {
+	vertices[0] = _vertexA;
+	vertices[1] = _vertexB;
+	vertices[2] = _vertexC;
+	return 1;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Translate
+ * Arguments:
+ *		Vec3<float> - the offset
+ * Purpose: Moves the vertices.  The normals do not change
+ * Return Value: void
+ */
+void Triangle::Translate(Vec3<float> offset) {
+	_vertexA = _vertexA + offset;
+	_vertexB = _vertexB + offset;
+	_vertexC = _vertexC + offset;
 }
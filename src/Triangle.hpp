@@ -17,9 +17,14 @@
 class Triangle : public Geometry {
 
 	public :
-		Triangle(Vec3<float> a, Vec3<float> b, Vec3<float> c, Vec3<unsigned char> color, Material mat = MATERIAL_NONE);
-		Triangle(float ax, float ay, float az, float bx, float by, float bz, float cx, float cy, float cz, Vec3<unsigned char> color, Material mat = MATERIAL_NONE);
-		std::shared_ptr<RayHit> Intersect(Vec3<float> ray, Vec3<float> startingPos);
+		Triangle(Vec3<float> a, Vec3<float> b, Vec3<float> c, materialId material = MATERIAL_DEFAULT);
+		Triangle(float ax, float ay, float az, float bx, float by, float bz, float cx, float cy, float cz, materialId material = MATERIAL_DEFAULT);
+		bool Intersect(Vec3<float> ray, Vec3<float> startingPos, RayHit &rayHit);
+		bool Occluded(Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+		BoundingBox GetBoundingBox();
+		Vec3<float> GetVertex(int index);
+		int GetTriangles(int index, Vec3<float> * vertices);
+		void Translate(Vec3<float> offset);
 
 	private : 
 		Vec3<float> _vertexA;
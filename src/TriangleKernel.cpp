@@ -0,0 +1,427 @@
+#include "TriangleKernel.hpp"
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Every kernel evaluates the same expressions in the same order as Triangle::Intersect so the hits are identical
+// no matter which one runs
+
+/*
+ * Date: 10/17/26
+ * Function Name: HitTimeScalar
+ * Arguments:
+ *     const trianglePacket & - the triangles
+ *     int                    - the lane to test
+ *     Vec3<float>            - the ray
+ *     Vec3<float>            - the starting position of the ray
+ *     float                  - hits before this time are ignored
+ *     float                  - hits at or after this time are ignored
+ *     float &                - set to the time of the hit
+ * Purpose: Cramer's rule for one lane, leaving as soon as the ray misses
+ * Return Value: bool - true if the ray hits the triangle between the two times
+ */
+static inline bool HitTimeScalar(const trianglePacket &packet, int lane, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime, float &time) {
+	float A = packet.edgeABX[lane];
+	float B = packet.edgeABY[lane];
+	float C = packet.edgeABZ[lane];
+	float D = packet.edgeACX[lane];
+	float E = packet.edgeACY[lane];
+	float F = packet.edgeACZ[lane];
+
+	float G = ray.x;
+	float H = ray.y;
+	float I = ray.z;
+
+	float J = packet.vertexX[lane] - startingPos.x;
+	float K = packet.vertexY[lane] - startingPos.y;
+	float L = packet.vertexZ[lane] - startingPos.z;
+
+	float M = A * (E * I - H * F) + B * (G * F - D * I) + C * (D * H - E * G);
+	float t = (-1 * (F * (A * K - J * B) + E * (J * C - A * L) + D * (B * L - K * C) ) ) / M;
+
+	if( !(t >= minTime && t < maxTime) ) {
+		return false;
+	}
+	float gamma = (I * (A * K - J * B) + H * (J * C - A * L) + G * (B * L - K * C)) / M;
+
+	if( gamma < 0 || gamma > 1 ) {
+		return false;
+	}
+	float beta = (J * (E * I - H * F) + K * (G * F - D * I) + L * (D * H - E * G)) / M;
+
+	if( beta < 0 || beta > 1 - gamma ) {
+		return false;
+	}
+
+	time = t;
+	return true;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ClosestHitScalar
+ * Arguments:
+ *     const trianglePacket & - the triangles
+ *     Vec3<float>            - the ray
+ *     Vec3<float>            - the starting position of the ray
+ *     float                  - hits at or after this time are ignored
+ *     float &                - set to the time of the closest hit
+ * Purpose: ClosestHit one lane at a time
+ * Return Value: int - the lane hit, -1 if nothing was hit
+ */
+static int ClosestHitScalar(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time) {
+	int closest = -1;
+	for (int lane = 0; lane < TRIANGLE_PACKET_WIDTH; lane++) {
+		if (HitTimeScalar(packet, lane, ray, startingPos, 0, maxTime, maxTime)) {
+			closest = lane;
+		}
+	}
+	time = maxTime;
+	return closest;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AnyHitScalar
+ * Arguments:
+ *     const trianglePacket & - the triangles
+ *     Vec3<float>            - the ray
+ *     Vec3<float>            - the starting position of the ray
+ *     float                  - hits at or before this time are ignored
+ *     float                  - hits at or after this time are ignored
+ * Purpose: AnyHit one lane at a time
+ * Return Value: bool
+ */
+static bool AnyHitScalar(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	float t;
+	for (int lane = 0; lane < TRIANGLE_PACKET_WIDTH; lane++) {
+		if (HitTimeScalar(packet, lane, ray, startingPos, minTime, maxTime, t) && t > minTime) {
+			return true;
+		}
+	}
+	return false;
+}
+
+#ifdef SIMD_X86
+
+/*
+ * Date: 10/17/26
+ * Function Name: HitTimeSSE
+ * Arguments:
+ *     const trianglePacket & - the triangles
+ *     int                    - the first of the four lanes to test
+ *     const __m128 *         - the ray x, y and z components, each in every lane
+ *     const __m128 *         - the starting position x, y and z components, each in every lane
+ *     __m128 &               - set to the times of the hits
+ * Purpose: Cramer's rule for four lanes
+ * Return Value: __m128 - all bits set in the lanes whose barycentric coordinates are inside the triangle
+ */
+static inline __m128 HitTimeSSE(const trianglePacket &packet, int first, const __m128 * rayComponents, const __m128 * startComponents, __m128 &t) {
+	__m128 A = _mm_loadu_ps(packet.edgeABX + first);
+	__m128 B = _mm_loadu_ps(packet.edgeABY + first);
+	__m128 C = _mm_loadu_ps(packet.edgeABZ + first);
+	__m128 D = _mm_loadu_ps(packet.edgeACX + first);
+	__m128 E = _mm_loadu_ps(packet.edgeACY + first);
+	__m128 F = _mm_loadu_ps(packet.edgeACZ + first);
+
+	__m128 G = rayComponents[0];
+	__m128 H = rayComponents[1];
+	__m128 I = rayComponents[2];
+
+	__m128 J = _mm_sub_ps(_mm_loadu_ps(packet.vertexX + first), startComponents[0]);
+	__m128 K = _mm_sub_ps(_mm_loadu_ps(packet.vertexY + first), startComponents[1]);
+	__m128 L = _mm_sub_ps(_mm_loadu_ps(packet.vertexZ + first), startComponents[2]);
+
+	__m128 EIHF = _mm_sub_ps(_mm_mul_ps(E, I), _mm_mul_ps(H, F));
+	__m128 GFDI = _mm_sub_ps(_mm_mul_ps(G, F), _mm_mul_ps(D, I));
+	__m128 DHEG = _mm_sub_ps(_mm_mul_ps(D, H), _mm_mul_ps(E, G));
+	__m128 AKJB = _mm_sub_ps(_mm_mul_ps(A, K), _mm_mul_ps(J, B));
+	__m128 JCAL = _mm_sub_ps(_mm_mul_ps(J, C), _mm_mul_ps(A, L));
+	__m128 BLKC = _mm_sub_ps(_mm_mul_ps(B, L), _mm_mul_ps(K, C));
+
+	__m128 M = _mm_add_ps(_mm_add_ps(_mm_mul_ps(A, EIHF), _mm_mul_ps(B, GFDI)), _mm_mul_ps(C, DHEG));
+	__m128 numerator = _mm_add_ps(_mm_add_ps(_mm_mul_ps(F, AKJB), _mm_mul_ps(E, JCAL)), _mm_mul_ps(D, BLKC));
+	t = _mm_div_ps(_mm_xor_ps(numerator, _mm_set1_ps(-0.f)), M);
+	__m128 gamma = _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(I, AKJB), _mm_mul_ps(H, JCAL)), _mm_mul_ps(G, BLKC)), M);
+	__m128 beta = _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(J, EIHF), _mm_mul_ps(K, GFDI)), _mm_mul_ps(L, DHEG)), M);
+
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 outside = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(gamma, zero), _mm_cmpgt_ps(gamma, one)),
+	                           _mm_or_ps(_mm_cmplt_ps(beta, zero), _mm_cmpgt_ps(beta, _mm_sub_ps(one, gamma))));
+	return _mm_andnot_ps(outside, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ClosestHitSSE
+ * Arguments:
+ *     const trianglePacket & - the triangles
+ *     Vec3<float>            - the ray
+ *     Vec3<float>            - the starting position of the ray
+ *     float                  - hits at or after this time are ignored
+ *     float &                - set to the time of the closest hit
+ * Purpose: ClosestHit four lanes at a time
+ * Return Value: int - the lane hit, -1 if nothing was hit
+ */
+static int ClosestHitSSE(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time) {
+	__m128 rayComponents[3] = { _mm_set1_ps(ray.x), _mm_set1_ps(ray.y), _mm_set1_ps(ray.z) };
+	__m128 startComponents[3] = { _mm_set1_ps(startingPos.x), _mm_set1_ps(startingPos.y), _mm_set1_ps(startingPos.z) };
+	__m128 t[2];
+	int mask = 0;
+
+	for (int half = 0; half < 2; half++) {
+		__m128 inside = HitTimeSSE(packet, 4 * half, rayComponents, startComponents, t[half]);
+		__m128 valid = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(t[half], _mm_setzero_ps()), _mm_cmplt_ps(t[half], _mm_set1_ps(maxTime))));
+		mask |= _mm_movemask_ps(valid) << (4 * half);
+	}
+
+	if (mask == 0) {
+		return -1;
+	}
+
+	float times[TRIANGLE_PACKET_WIDTH];
+	_mm_storeu_ps(times, t[0]);
+	_mm_storeu_ps(times + 4, t[1]);
+
+	int closest = -1;
+	for (int lane = 0; lane < TRIANGLE_PACKET_WIDTH; lane++) {
+		if ((mask & (1 << lane)) && times[lane] < maxTime) {
+			maxTime = times[lane];
+			closest = lane;
+		}
+	}
+	time = maxTime;
+	return closest;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AnyHitSSE
+ * Arguments:
+ *     const trianglePacket & - the triangles
+ *     Vec3<float>            - the ray
+ *     Vec3<float>            - the starting position of the ray
+ *     float                  - hits at or before this time are ignored
+ *     float                  - hits at or after this time are ignored
+ * Purpose: AnyHit four lanes at a time
+ * Return Value: bool
+ */
+static bool AnyHitSSE(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	__m128 rayComponents[3] = { _mm_set1_ps(ray.x), _mm_set1_ps(ray.y), _mm_set1_ps(ray.z) };
+	__m128 startComponents[3] = { _mm_set1_ps(startingPos.x), _mm_set1_ps(startingPos.y), _mm_set1_ps(startingPos.z) };
+
+	for (int half = 0; half < 2; half++) {
+		__m128 t;
+		__m128 inside = HitTimeSSE(packet, 4 * half, rayComponents, startComponents, t);
+		__m128 valid = _mm_and_ps(inside, _mm_and_ps(_mm_cmpgt_ps(t, _mm_set1_ps(minTime)), _mm_cmplt_ps(t, _mm_set1_ps(maxTime))));
+		if (_mm_movemask_ps(valid) != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: HitTimeAVX2
+ * Arguments:
+ *     const trianglePacket & - the triangles
+ *     Vec3<float>            - the ray
+ *     Vec3<float>            - the starting position of the ray
+ *     __m256 &               - set to the times of the hits
+ * Purpose: Cramer's rule for all eight lanes
+ * Return Value: __m256 - all bits set in the lanes whose barycentric coordinates are inside the triangle
+ */
+SIMD_TARGET_AVX2 static inline __m256 HitTimeAVX2(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, __m256 &t) {
+	__m256 A = _mm256_loadu_ps(packet.edgeABX);
+	__m256 B = _mm256_loadu_ps(packet.edgeABY);
+	__m256 C = _mm256_loadu_ps(packet.edgeABZ);
+	__m256 D = _mm256_loadu_ps(packet.edgeACX);
+	__m256 E = _mm256_loadu_ps(packet.edgeACY);
+	__m256 F = _mm256_loadu_ps(packet.edgeACZ);
+
+	__m256 G = _mm256_set1_ps(ray.x);
+	__m256 H = _mm256_set1_ps(ray.y);
+	__m256 I = _mm256_set1_ps(ray.z);
+
+	__m256 J = _mm256_sub_ps(_mm256_loadu_ps(packet.vertexX), _mm256_set1_ps(startingPos.x));
+	__m256 K = _mm256_sub_ps(_mm256_loadu_ps(packet.vertexY), _mm256_set1_ps(startingPos.y));
+	__m256 L = _mm256_sub_ps(_mm256_loadu_ps(packet.vertexZ), _mm256_set1_ps(startingPos.z));
+
+	__m256 EIHF = _mm256_sub_ps(_mm256_mul_ps(E, I), _mm256_mul_ps(H, F));
+	__m256 GFDI = _mm256_sub_ps(_mm256_mul_ps(G, F), _mm256_mul_ps(D, I));
+	__m256 DHEG = _mm256_sub_ps(_mm256_mul_ps(D, H), _mm256_mul_ps(E, G));
+	__m256 AKJB = _mm256_sub_ps(_mm256_mul_ps(A, K), _mm256_mul_ps(J, B));
+	__m256 JCAL = _mm256_sub_ps(_mm256_mul_ps(J, C), _mm256_mul_ps(A, L));
+	__m256 BLKC = _mm256_sub_ps(_mm256_mul_ps(B, L), _mm256_mul_ps(K, C));
+
+	__m256 M = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(A, EIHF), _mm256_mul_ps(B, GFDI)), _mm256_mul_ps(C, DHEG));
+	__m256 numerator = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(F, AKJB), _mm256_mul_ps(E, JCAL)), _mm256_mul_ps(D, BLKC));
+	t = _mm256_div_ps(_mm256_xor_ps(numerator, _mm256_set1_ps(-0.f)), M);
+	__m256 gamma = _mm256_div_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(I, AKJB), _mm256_mul_ps(H, JCAL)), _mm256_mul_ps(G, BLKC)), M);
+	__m256 beta = _mm256_div_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(J, EIHF), _mm256_mul_ps(K, GFDI)), _mm256_mul_ps(L, DHEG)), M);
+
+	__m256 zero = _mm256_setzero_ps();
+	__m256 one = _mm256_set1_ps(1.f);
+	__m256 outside = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(gamma, zero, _CMP_LT_OQ), _mm256_cmp_ps(gamma, one, _CMP_GT_OQ)),
+	                              _mm256_or_ps(_mm256_cmp_ps(beta, zero, _CMP_LT_OQ), _mm256_cmp_ps(beta, _mm256_sub_ps(one, gamma), _CMP_GT_OQ)));
+	return _mm256_andnot_ps(outside, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: ClosestHitAVX2
+ * Arguments:
+ *     const trianglePacket & - the triangles
+ *     Vec3<float>            - the ray
+ *     Vec3<float>            - the starting position of the ray
+ *     float                  - hits at or after this time are ignored
+ *     float &                - set to the time of the closest hit
+ * Purpose: ClosestHit on all eight lanes at once
+ * Return Value: int - the lane hit, -1 if nothing was hit
+ */
+SIMD_TARGET_AVX2 static int ClosestHitAVX2(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time) {
+	__m256 t;
+	__m256 inside = HitTimeAVX2(packet, ray, startingPos, t);
+	__m256 valid = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_cmp_ps(t, _mm256_set1_ps(maxTime), _CMP_LT_OQ)));
+	int mask = _mm256_movemask_ps(valid);
+
+	if (mask == 0) {
+		return -1;
+	}
+
+	float times[TRIANGLE_PACKET_WIDTH];
+	_mm256_storeu_ps(times, t);
+
+	int closest = -1;
+	for (int lane = 0; lane < TRIANGLE_PACKET_WIDTH; lane++) {
+		if ((mask & (1 << lane)) && times[lane] < maxTime) {
+			maxTime = times[lane];
+			closest = lane;
+		}
+	}
+	time = maxTime;
+	return closest;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: AnyHitAVX2
+ * Arguments:
+ *     const trianglePacket & - the triangles
+ *     Vec3<float>            - the ray
+ *     Vec3<float>            - the starting position of the ray
+ *     float                  - hits at or before this time are ignored
+ *     float                  - hits at or after this time are ignored
+ * Purpose: AnyHit on all eight lanes at once
+ * Return Value: bool
+ */
+SIMD_TARGET_AVX2 static bool AnyHitAVX2(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+	__m256 t;
+	__m256 inside = HitTimeAVX2(packet, ray, startingPos, t);
+	__m256 valid = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(t, _mm256_set1_ps(minTime), _CMP_GT_OQ), _mm256_cmp_ps(t, _mm256_set1_ps(maxTime), _CMP_LT_OQ)));
+	return _mm256_movemask_ps(valid) != 0;
+}
+
+#endif
+
+/*
+ * Date: 10/17/26
+ * Function Name: TriangleKernel (constructor)
+ * Arguments:
+ *     void
+ * Purpose: Constructor using the widest kernel the processor supports
+ * Return Value: void
+ */
+TriangleKernel::TriangleKernel() {
+	Select(Simd::GetBestLevel());
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: TriangleKernel (constructor)
+ * Arguments:
+ *     simd_level - the kernel to use.  Lowered to the best supported level if the processor lacks it
+ * Purpose: Constructor
+ * Return Value: void
+ */
+TriangleKernel::TriangleKernel(simd_level level) {
+	Select(Simd::Supported(level));
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: Select
+ * Arguments:
+ *     simd_level - a supported level
+ * Purpose: Points the hit functions at the kernel for the level
+ * Return Value: void
+ */
+void TriangleKernel::Select(simd_level level) {
+	_level = level;
+	_closestHit = ClosestHitScalar;
+	_anyHit = AnyHitScalar;
+
+#ifdef SIMD_X86
+	if (level == SIMD_SSE) {
+		_closestHit = ClosestHitSSE;
+		_anyHit = AnyHitSSE;
+	} else if (level == SIMD_AVX2) {
+		_closestHit = ClosestHitAVX2;
+		_anyHit = AnyHitAVX2;
+	}
+#endif
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetLevel
+ * Arguments:
+ *     void
+ * Purpose: Returns the level of the kernel in use
+ * Return Value: simd_level
+ */
+simd_level TriangleKernel::GetLevel() {
+	return _level;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: SetTriangle
+ * Arguments:
+ *     trianglePacket & - the packet
+ *     int              - the lane to fill
+ *     Vec3<float>      - the first vertex
+ *     Vec3<float>      - the second vertex
+ *     Vec3<float>      - the third vertex
+ * Purpose: Stores a triangle and its edges in one lane
+ * Return Value: void
+ */
+void TriangleKernel::SetTriangle(trianglePacket &packet, int lane, Vec3<float> a, Vec3<float> b, Vec3<float> c) {
+	packet.vertexX[lane] = a.x;
+	packet.vertexY[lane] = a.y;
+	packet.vertexZ[lane] = a.z;
+	packet.edgeABX[lane] = a.x - b.x;
+	packet.edgeABY[lane] = a.y - b.y;
+	packet.edgeABZ[lane] = a.z - b.z;
+	packet.edgeACX[lane] = a.x - c.x;
+	packet.edgeACY[lane] = a.y - c.y;
+	packet.edgeACZ[lane] = a.z - c.z;
+}
+
+/*
+ * Date: 10/17/26
+ * Function Name: GetNormal
+ * Arguments:
+ *     const trianglePacket & - the packet
+ *     int                    - the lane
+ * Purpose: Gets the normal of the triangle in a lane.  (b - a) x (c - a) is the same as (a - b) x (a - c)
+ * Return Value: Vec3<float>
+ */
+Vec3<float> TriangleKernel::GetNormal(const trianglePacket &packet, int lane) {
+	Vec3<float> edgeAB = Vec3<float>::vec3(packet.edgeABX[lane], packet.edgeABY[lane], packet.edgeABZ[lane]);
+	Vec3<float> edgeAC = Vec3<float>::vec3(packet.edgeACX[lane], packet.edgeACY[lane], packet.edgeACZ[lane]);
+	return Vec3<float>::Normalize(Vec3<float>::Cross(edgeAB, edgeAC));
+}
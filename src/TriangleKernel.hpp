@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Simd.hpp"
+#include "Vector.hpp"
+
+#define TRIANGLE_PACKET_WIDTH 8 // Triangles per packet.  One AVX2 register or two SSE registers per component
+
+// Eight triangles in structure of arrays form.  Each triangle (a, b, c) is stored as a and the precomputed edges
+// a - b and a - c, the terms Triangle::Intersect solves with.  Unused lanes are zero which no ray can hit
+typedef struct {
+	float vertexX[TRIANGLE_PACKET_WIDTH];
+	float vertexY[TRIANGLE_PACKET_WIDTH];
+	float vertexZ[TRIANGLE_PACKET_WIDTH];
+	float edgeABX[TRIANGLE_PACKET_WIDTH];
+	float edgeABY[TRIANGLE_PACKET_WIDTH];
+	float edgeABZ[TRIANGLE_PACKET_WIDTH];
+	float edgeACX[TRIANGLE_PACKET_WIDTH];
+	float edgeACY[TRIANGLE_PACKET_WIDTH];
+	float edgeACZ[TRIANGLE_PACKET_WIDTH];
+} trianglePacket;
+
+/*
+ * Author: Ben Vesel
+ * Date: 10/17/26
+ * Classname: TriangleKernel
+ * Purpose: Intersects one ray with a packet of triangles at once.  The SSE and AVX2 versions are picked at run
+ *          time when the processor supports them, the scalar version works everywhere
+ */
+class TriangleKernel {
+
+	public :
+		TriangleKernel();
+		TriangleKernel(simd_level level);
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: ClosestHit
+		 * Arguments:
+		 *     const trianglePacket & - the triangles
+		 *     Vec3<float>            - the ray
+		 *     Vec3<float>            - the starting position of the ray
+		 *     float                  - hits at or after this time are ignored
+		 *     float &                - set to the time of the closest hit
+		 * Purpose: Finds the closest triangle of the packet hit at or after time zero
+		 * Return Value: int - the lane of the closest hit (the lowest lane on ties), -1 if nothing was hit
+		 */
+		int ClosestHit(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time) {
+			return _closestHit(packet, ray, startingPos, maxTime, time);
+		}
+
+		/*
+		 * Date: 10/17/26
+		 * Function Name: AnyHit
+		 * Arguments:
+		 *     const trianglePacket & - the triangles
+		 *     Vec3<float>            - the ray
+		 *     Vec3<float>            - the starting position of the ray
+		 *     float                  - hits at or before this time are ignored
+		 *     float                  - hits at or after this time are ignored
+		 * Purpose: Tests if any triangle of the packet is hit between the two times
+		 * Return Value: bool
+		 */
+		bool AnyHit(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime) {
+			return _anyHit(packet, ray, startingPos, minTime, maxTime);
+		}
+
+		simd_level GetLevel();
+
+		static void SetTriangle(trianglePacket &packet, int lane, Vec3<float> a, Vec3<float> b, Vec3<float> c);
+		static Vec3<float> GetNormal(const trianglePacket &packet, int lane);
+
+	private :
+		typedef int (*closestHitFunction)(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float maxTime, float &time);
+		typedef bool (*anyHitFunction)(const trianglePacket &packet, Vec3<float> ray, Vec3<float> startingPos, float minTime, float maxTime);
+
+		void Select(simd_level level);
+
+		simd_level _level;
+		closestHitFunction _closestHit;
+		anyHitFunction _anyHit;
+};